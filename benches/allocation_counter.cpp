@@ -0,0 +1,56 @@
+#include "allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+std::atomic<size_t> allocation_counter::num_heap_allocations{ 0 };
+
+// Replaced global allocation and deallocation functions, counting each allocation. Array and non-throwing forms forward to these by default.
+
+void*
+operator new(std::size_t byte_len)
+{
+  allocation_counter::num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(byte_len == 0 ? 1 : byte_len)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void*
+operator new(std::size_t byte_len, std::align_val_t alignment)
+{
+  allocation_counter::num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t padded_byte_len = ((byte_len + (align - 1)) / align) * align;
+
+  if (void* ptr = std::aligned_alloc(align, padded_byte_len == 0 ? align : padded_byte_len)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::align_val_t) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Number of heap allocations, made by this process so far, using global `operator new`, which is replaced in allocation_counter.cpp. Benchmarks
+// read it before and after the timed loop, reporting allocations per iteration.
+namespace allocation_counter {
+
+extern std::atomic<size_t> num_heap_allocations;
+
+inline size_t
+count()
+{
+  return num_heap_allocations.load(std::memory_order_relaxed);
+}
+
+}
@@ -4,9 +4,9 @@ BENCHMARK_DIR := benches
 BENCHMARK_SOURCES := $(wildcard $(BENCHMARK_DIR)/*.cpp)
 BENCHMARK_HEADERS := $(wildcard $(BENCHMARK_DIR)/*.hpp)
 BENCHMARK_OBJECTS := $(addprefix $(BENCHMARK_BUILD_DIR)/, $(notdir $(patsubst %.cpp,%.o,$(BENCHMARK_SOURCES))))
-BENCHMARK_LINK_FLAGS := -lbenchmark -lbenchmark_main -lpthread
+BENCHMARK_LINK_FLAGS := -lbenchmark -lbenchmark_main -lpthread $(NUMA_LINK_FLAGS)
 BENCHMARK_BINARY := $(BENCHMARK_BUILD_DIR)/bench.out
-PERF_LINK_FLAGS := -lbenchmark -lbenchmark_main -lpfm -lpthread
+PERF_LINK_FLAGS := -lbenchmark -lbenchmark_main -lpfm -lpthread $(NUMA_LINK_FLAGS)
 PERF_BINARY := $(BENCHMARK_BUILD_DIR)/perf.out
 BENCHMARK_OUT_FILE := bench_result_on_$(shell uname -s)_$(shell uname -r)_$(shell uname -m)_with_$(CXX)_$(shell $(CXX) -dumpversion).json
 
@@ -0,0 +1,93 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/bit_packing.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <vector>
+
+// Size of byte serialized database, which is parsed into or serialized from elements of `mat_element_bitlen` bits, for benchmarking. It's
+// large enough not to fit in last level cache.
+static constexpr size_t DB_BYTE_LEN = 64ul << 20;
+
+// Unpacking byte serialized database into elements of parsed database matrix, using group kernel of requested implementation.
+template<frodoPIR_bit_packing::impl_t impl, size_t mat_element_bitlen>
+static void
+bench_parse_db_bytes(benchmark::State& state)
+{
+  if (!frodoPIR_bit_packing::is_supported(impl)) {
+    state.SkipWithError("Implementation is not supported by this CPU");
+    return;
+  }
+
+  constexpr size_t num_groups = DB_BYTE_LEN / mat_element_bitlen;
+
+  std::vector<uint8_t> bytes(num_groups * mat_element_bitlen);
+  std::vector<uint16_t> elems(num_groups * frodoPIR_bit_packing::GROUP_LEN);
+
+  csprng::csprng_t csprng{};
+  csprng.generate(bytes);
+
+  const auto kernel = frodoPIR_bit_packing::get_unpack_groups_kernel<mat_element_bitlen>(impl);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bytes.data());
+
+    kernel(bytes.data(), num_groups, elems.data());
+
+    benchmark::DoNotOptimize(elems.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+
+// Packing elements of parsed database matrix back into byte serialized database, using group kernel of requested implementation.
+template<frodoPIR_bit_packing::impl_t impl, size_t mat_element_bitlen>
+static void
+bench_serialize_db_matrix(benchmark::State& state)
+{
+  if (!frodoPIR_bit_packing::is_supported(impl)) {
+    state.SkipWithError("Implementation is not supported by this CPU");
+    return;
+  }
+
+  constexpr size_t num_groups = DB_BYTE_LEN / mat_element_bitlen;
+
+  std::vector<uint8_t> bytes(num_groups * mat_element_bitlen);
+  std::vector<uint16_t> elems(num_groups * frodoPIR_bit_packing::GROUP_LEN);
+
+  csprng::csprng_t csprng{};
+  csprng.generate(bytes);
+  frodoPIR_bit_packing::get_unpack_groups_kernel<mat_element_bitlen>(frodoPIR_bit_packing::impl_t::scalar)(bytes.data(), num_groups, elems.data());
+
+  const auto kernel = frodoPIR_bit_packing::get_pack_groups_kernel<mat_element_bitlen, uint16_t>(impl);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(elems.data());
+
+    kernel(elems.data(), num_groups, bytes.data());
+
+    benchmark::DoNotOptimize(bytes.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+
+#define REGISTER_BIT_PACKING_BENCH(bench, op, impl, mat_element_bitlen)                                                                           \
+  BENCHMARK(bench<frodoPIR_bit_packing::impl_t::impl, mat_element_bitlen>)                                                                        \
+    ->Name(std::format("frodoPIR/{}/{}/{}-bit", op, #impl, mat_element_bitlen))                                                                   \
+    ->ComputeStatistics("min", compute_min)                                                                                                       \
+    ->ComputeStatistics("max", compute_max)                                                                                                       \
+    ->Unit(benchmark::kMillisecond)
+
+#define REGISTER_BIT_PACKING_BENCHES(impl, mat_element_bitlen)                                                                                    \
+  REGISTER_BIT_PACKING_BENCH(bench_parse_db_bytes, "parse_db_bytes", impl, mat_element_bitlen);                                                   \
+  REGISTER_BIT_PACKING_BENCH(bench_serialize_db_matrix, "serialize_db_matrix", impl, mat_element_bitlen)
+
+REGISTER_BIT_PACKING_BENCHES(scalar, 9);
+REGISTER_BIT_PACKING_BENCHES(bmi2, 9);
+REGISTER_BIT_PACKING_BENCHES(avx2, 9);
+REGISTER_BIT_PACKING_BENCHES(scalar, 10);
+REGISTER_BIT_PACKING_BENCHES(bmi2, 10);
+REGISTER_BIT_PACKING_BENCHES(avx2, 10);
@@ -0,0 +1,67 @@
+#include "bench_common.hpp"
+#include "pir_online_phase_fixture.hpp"
+#include <format>
+#include <numeric>
+
+BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ClientPrepareQueryBatch)(benchmark::State& state)
+{
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+
+  std::vector<size_t> db_row_indices(batch_size);
+  std::iota(db_row_indices.begin(), db_row_indices.end(), generate_random_db_index());
+  std::ranges::for_each(db_row_indices, [](auto& db_row_idx) { db_row_idx %= db_entry_count; });
+
+  std::vector<uint8_t> queries_bytes(batch_size * query_byte_len, 0);
+  std::vector<uint8_t> responses_bytes(batch_size * response_byte_len, 0);
+
+  auto queries_bytes_span = std::span(queries_bytes);
+  auto responses_bytes_span = std::span(responses_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  bool is_query_preprocessed = true;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(is_query_preprocessed);
+    benchmark::DoNotOptimize(client_handle);
+    benchmark::DoNotOptimize(db_row_indices);
+    benchmark::DoNotOptimize(&csprng);
+
+    const auto query_prep_status = client_handle.prepare_query(db_row_indices, csprng);
+    is_query_preprocessed &= std::ranges::all_of(query_prep_status, [](const bool status) { return status; });
+
+    benchmark::ClobberMemory();
+
+    // Drain prepared queries, so that same DB row indices can be reused in next iteration, don't time it.
+    state.PauseTiming();
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      assert(client_handle.query(db_row_indices[b_idx], queries_bytes_span.subspan(b_idx * query_byte_len).first<query_byte_len>()));
+    }
+
+    assert(server_handle.respond_batch(queries_bytes_span, responses_bytes_span));
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      assert(client_handle.process_response(
+        db_row_indices[b_idx], responses_bytes_span.subspan(b_idx * response_byte_len).first<response_byte_len>(), db_row_bytes_span));
+    }
+
+    state.ResumeTiming();
+  }
+
+  assert(is_query_preprocessed);
+
+  // Time spent on preprocessing each query, amortized over the whole batch.
+  state.counters["per_query_time"] =
+    benchmark::Counter(static_cast<double>(batch_size), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
+BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ClientPrepareQueryBatch)
+  ->Name(std::format("frodoPIR/client_prepare_query_batch/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ArgName("batch_size")
+  ->RangeMultiplier(4)
+  ->Range(1, 256)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
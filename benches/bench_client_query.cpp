@@ -48,3 +48,52 @@ BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ClientQuery)
   ->MeasureProcessCPUTime()
   ->UseRealTime()
   ->Unit(benchmark::kMicrosecond);
+
+// Finalizing query for a database row index, not known ahead of time, by claiming an unbound query from the pool, which is prepared off the
+// timed path, same as a background refill thread would do.
+BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ClientQueryFromUnboundPool)(benchmark::State& state)
+{
+  size_t db_row_idx = generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, response_byte_len>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  client_handle.prepare_unbound_queries(1, csprng);
+
+  bool is_query_ready = true;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(is_query_ready);
+    benchmark::DoNotOptimize(client_handle);
+    benchmark::DoNotOptimize(db_row_idx);
+    benchmark::DoNotOptimize(query_bytes_span);
+
+    is_query_ready &= client_handle.query(db_row_idx, query_bytes_span);
+
+    benchmark::ClobberMemory();
+
+    // Prepare for next iteration, don't time it.
+    state.PauseTiming();
+
+    server_handle.respond(query_bytes_span, response_bytes_span);
+    assert(client_handle.process_response(db_row_idx, response_bytes_span, db_row_bytes_span));
+
+    db_row_idx ^= (db_row_idx << 1) ^ 1ul;
+    db_row_idx %= db_entry_count;
+
+    client_handle.prepare_unbound_queries(1, csprng);
+
+    state.ResumeTiming();
+  }
+
+  assert(is_query_ready);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ClientQueryFromUnboundPool)
+  ->Name(std::format("frodoPIR/client_query_from_unbound_pool/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
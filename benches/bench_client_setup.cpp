@@ -9,6 +9,7 @@ static constexpr size_t db_entry_count = 1ul << 20;
 static constexpr size_t db_entry_byte_len = 1024;
 static constexpr size_t mat_element_bitlen = 9;
 
+template<bool is_lowmem>
 static void
 bench_client_setup(benchmark::State& state)
 {
@@ -39,7 +40,7 @@ bench_client_setup(benchmark::State& state)
     benchmark::DoNotOptimize(seed_μ);
     benchmark::DoNotOptimize(pub_matM_bytes_span);
 
-    auto client = client_t::setup(seed_μ, pub_matM_bytes_span);
+    auto client = is_lowmem ? client_t::setup_lowmem(seed_μ, pub_matM_bytes_span) : client_t::setup(seed_μ, pub_matM_bytes_span);
 
     benchmark::DoNotOptimize(client);
     benchmark::ClobberMemory();
@@ -48,10 +49,18 @@ bench_client_setup(benchmark::State& state)
   state.SetItemsProcessed(state.iterations());
 }
 
-BENCHMARK(bench_client_setup)
+BENCHMARK(bench_client_setup<false>)
   ->Name(std::format("frodoPIR/client_setup/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max)
   ->MeasureProcessCPUTime()
   ->UseRealTime()
   ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(bench_client_setup<true>)
+  ->Name(std::format("frodoPIR/client_setup_lowmem/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,74 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/matrix/simd.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include "frodoPIR/server.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <vector>
+
+// Computing public matrix M = A * D, as server setup does, for `db_entry_count` -many database entries, each parsed into
+// `num_columns_in_parsed_db` -many 16 -bit elements, using GEMM micro-kernel for requested instruction set extension, on all threads of the
+// default pool. Reported `ops_per_second` counts a multiplication and an addition over Zq, each as one operation, so that it can be compared
+// against GFLOP/s figures of floating point GEMM.
+template<frodoPIR_simd::isa_t isa, size_t db_entry_count, size_t num_columns_in_parsed_db>
+static void
+bench_gemm(benchmark::State& state)
+{
+  if (!frodoPIR_simd::is_supported(isa)) {
+    state.SkipWithError("Instruction set extension is not supported by this CPU");
+    return;
+  }
+
+  constexpr size_t m = frodoPIR_server::LWE_DIMENSION;
+  constexpr size_t k = db_entry_count;
+  constexpr size_t n = num_columns_in_parsed_db;
+
+  std::vector<frodoPIR_matrix::zq_t> A(m * k);
+  std::vector<uint16_t> D(k * n);
+  std::vector<frodoPIR_matrix::zq_t> M(m * n);
+
+  csprng::csprng_t csprng{};
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(A.data()), A.size() * sizeof(frodoPIR_matrix::zq_t)));
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(D.data()), D.size() * sizeof(uint16_t)));
+
+  const auto kernel = frodoPIR_simd::get_gemm_kernel(isa);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(D.data());
+
+    frodoPIR_matrix::matrix_x_matrix(A.data(), k, D.data(), n, m, k, n, M.data(), n, frodoPIR_thread_pool::thread_pool_t::global(), kernel);
+
+    benchmark::DoNotOptimize(M.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.counters["ops_per_second"] = benchmark::Counter(static_cast<double>(2 * m * k * n), benchmark::Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(A.size() * sizeof(frodoPIR_matrix::zq_t) + D.size() * sizeof(uint16_t)));
+}
+
+#define REGISTER_GEMM_BENCH(isa, db_entry_count, num_columns_in_parsed_db)                                                                             \
+  BENCHMARK(bench_gemm<isa, db_entry_count, num_columns_in_parsed_db>)                                                                                 \
+    ->Name(std::format("frodoPIR/gemm/{}/{}x{}x{}",                                                                                                    \
+                       frodoPIR_simd::isa_name(isa),                                                                                                   \
+                       frodoPIR_server::LWE_DIMENSION,                                                                                                 \
+                       format_number(db_entry_count),                                                                                                  \
+                       num_columns_in_parsed_db))                                                                                                      \
+    ->ComputeStatistics("min", compute_min)                                                                                                            \
+    ->ComputeStatistics("max", compute_max)                                                                                                            \
+    ->MeasureProcessCPUTime()                                                                                                                          \
+    ->UseRealTime()                                                                                                                                    \
+    ->Unit(benchmark::kMillisecond)
+
+// Databases with 32B entries, where D is a narrow matrix, and with 1KB entries, where D is a wide one.
+#define REGISTER_GEMM_BENCHES(isa)                                                                                                                     \
+  REGISTER_GEMM_BENCH(isa, 1ul << 14, 26);                                                                                                             \
+  REGISTER_GEMM_BENCH(isa, 1ul << 16, 26);                                                                                                             \
+  REGISTER_GEMM_BENCH(isa, 1ul << 12, 820);                                                                                                            \
+  REGISTER_GEMM_BENCH(isa, 1ul << 14, 820)
+
+REGISTER_GEMM_BENCHES(frodoPIR_simd::isa_t::scalar);
+REGISTER_GEMM_BENCHES(frodoPIR_simd::isa_t::avx2);
+REGISTER_GEMM_BENCHES(frodoPIR_simd::isa_t::avx512);
+REGISTER_GEMM_BENCHES(frodoPIR_simd::isa_t::neon);
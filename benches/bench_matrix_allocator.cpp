@@ -0,0 +1,127 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/utility/allocator.hpp"
+#include "pir_online_phase_fixture.hpp"
+#include <format>
+#include <memory_resource>
+
+// Memory, which storage of matrices of server and client is allocated from.
+enum class matrix_memory_t : uint8_t
+{
+  standard_pages,
+  huge_pages_2mib,
+  huge_pages_1gib,
+};
+
+// Sets up server and client, s.t. all of their matrices (i.e. transposed database, A and M) are allocated from requested memory resource.
+template<matrix_memory_t memory>
+class FrodoPIRMatrixMemoryFixture : public FrodoPIROnlinePhaseFixture
+{
+public:
+  void SetUp(benchmark::State& state) override
+  {
+    std::pmr::memory_resource* resource = frodoPIR_allocator::default_matrix_resource();
+    if constexpr (memory == matrix_memory_t::huge_pages_2mib) {
+      resource = &frodoPIR_allocator::huge_page_resource_t::huge_2mib();
+    } else if constexpr (memory == matrix_memory_t::huge_pages_1gib) {
+      resource = &frodoPIR_allocator::huge_page_resource_t::huge_1gib();
+    }
+
+    auto* const prev_resource = frodoPIR_allocator::set_matrix_resource(resource);
+    FrodoPIROnlinePhaseFixture::SetUp(state);
+    frodoPIR_allocator::set_matrix_resource(prev_resource);
+  }
+
+  static constexpr const char* name()
+  {
+    switch (memory) {
+      case matrix_memory_t::huge_pages_2mib:
+        return "huge_pages_2MB";
+      case matrix_memory_t::huge_pages_1gib:
+        return "huge_pages_1GB";
+      default:
+        return "standard_pages";
+    }
+  }
+};
+
+using StandardPagesFixture = FrodoPIRMatrixMemoryFixture<matrix_memory_t::standard_pages>;
+using HugePages2MBFixture = FrodoPIRMatrixMemoryFixture<matrix_memory_t::huge_pages_2mib>;
+using HugePages1GBFixture = FrodoPIRMatrixMemoryFixture<matrix_memory_t::huge_pages_1gib>;
+
+template<typename fixture_t>
+static void
+bench_server_respond(fixture_t& fixture, benchmark::State& state)
+{
+  const size_t db_row_idx = fixture.generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(fixture.query_bytes);
+  auto response_bytes_span = std::span<uint8_t, response_byte_len>(fixture.response_bytes);
+
+  assert(fixture.client_handle.prepare_query(db_row_idx, fixture.csprng));
+  assert(fixture.client_handle.query(db_row_idx, query_bytes_span));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fixture.server_handle);
+    benchmark::DoNotOptimize(query_bytes_span);
+    benchmark::DoNotOptimize(response_bytes_span);
+
+    fixture.server_handle.respond(query_bytes_span, response_bytes_span);
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename fixture_t>
+static void
+bench_client_prepare_query(fixture_t& fixture, benchmark::State& state)
+{
+  size_t db_row_idx = fixture.generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(fixture.query_bytes);
+
+  bool is_query_preprocessed = true;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(is_query_preprocessed);
+    benchmark::DoNotOptimize(fixture.client_handle);
+    benchmark::DoNotOptimize(db_row_idx);
+
+    is_query_preprocessed &= fixture.client_handle.prepare_query(db_row_idx, fixture.csprng);
+
+    benchmark::ClobberMemory();
+
+    // Release prepared query, don't time it.
+    state.PauseTiming();
+
+    is_query_preprocessed &= fixture.client_handle.query(db_row_idx, query_bytes_span);
+
+    db_row_idx ^= (db_row_idx << 1) ^ 1ul;
+    db_row_idx %= db_entry_count;
+
+    state.ResumeTiming();
+  }
+
+  assert(is_query_preprocessed);
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define REGISTER_MATRIX_MEMORY_BENCH(fixture, routine)                                                                                                 \
+  BENCHMARK_DEFINE_F(fixture, routine)(benchmark::State & state)                                                                                     \
+  {                                                                                                                                                    \
+    bench_##routine(*this, state);                                                                                                                     \
+  }                                                                                                                                                    \
+  BENCHMARK_REGISTER_F(fixture, routine)                                                                                                               \
+    ->Name(std::format("frodoPIR/{}/{}/{}/{}", #routine, fixture::name(), format_number(db_entry_count), format_bytes(db_entry_byte_len)))             \
+    ->ComputeStatistics("min", compute_min)                                                                                                            \
+    ->ComputeStatistics("max", compute_max)                                                                                                            \
+    ->MeasureProcessCPUTime()                                                                                                                          \
+    ->UseRealTime()                                                                                                                                    \
+    ->Unit(benchmark::kMillisecond)
+
+REGISTER_MATRIX_MEMORY_BENCH(StandardPagesFixture, server_respond);
+REGISTER_MATRIX_MEMORY_BENCH(HugePages2MBFixture, server_respond);
+REGISTER_MATRIX_MEMORY_BENCH(HugePages1GBFixture, server_respond);
+REGISTER_MATRIX_MEMORY_BENCH(StandardPagesFixture, client_prepare_query);
+REGISTER_MATRIX_MEMORY_BENCH(HugePages2MBFixture, client_prepare_query);
+REGISTER_MATRIX_MEMORY_BENCH(HugePages1GBFixture, client_prepare_query);
@@ -0,0 +1,66 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/server.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <format>
+#include <thread>
+#include <vector>
+
+// Expanding public matrix A, of dimension `LWE_DIMENSION x db_entry_count`, from seed, as both server and client setup do, using a pool of
+// `state.range(0)` -many threads. Sequentially expanded A takes same time, irrespective of number of threads, while row-indexed expansion
+// is expected to scale with it.
+template<size_t db_entry_count, frodoPIR_matrix::expansion_mode_t mode>
+static void
+bench_pub_mat_A_generate(benchmark::State& state)
+{
+  using pub_mat_A_t = frodoPIR_matrix::matrix_t<frodoPIR_server::LWE_DIMENSION, db_entry_count>;
+
+  std::array<uint8_t, frodoPIR_server::SEED_BYTE_LEN> seed_μ{};
+  csprng::csprng_t csprng{};
+  csprng.generate(seed_μ);
+
+  frodoPIR_thread_pool::thread_pool_t pool(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(seed_μ);
+
+    auto A = pub_mat_A_t::template generate<frodoPIR_server::λ>(seed_μ, mode, pool);
+
+    benchmark::DoNotOptimize(A);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frodoPIR_server::LWE_DIMENSION));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(pub_mat_A_t::get_byte_len()));
+}
+
+// Number of threads, from one to number of hardware threads, doubling each time.
+static void
+thread_counts(benchmark::internal::Benchmark* bench)
+{
+  const size_t max_num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  for (size_t num_threads = 1; num_threads < max_num_threads; num_threads *= 2) {
+    bench->Arg(static_cast<int64_t>(num_threads));
+  }
+  bench->Arg(static_cast<int64_t>(max_num_threads));
+}
+
+#define REGISTER_PUB_MAT_A_GENERATE_BENCH(db_entry_count, mode)                                                                                    \
+  BENCHMARK(bench_pub_mat_A_generate<db_entry_count, frodoPIR_matrix::expansion_mode_t::mode>)                                                    \
+    ->Name(std::format("frodoPIR/pub_mat_A_generate/{}/{}", #mode, format_number(db_entry_count)))                                                \
+    ->ArgName("num_threads")                                                                                                                      \
+    ->Apply(thread_counts)                                                                                                                        \
+    ->ComputeStatistics("min", compute_min)                                                                                                       \
+    ->ComputeStatistics("max", compute_max)                                                                                                       \
+    ->MeasureProcessCPUTime()                                                                                                                     \
+    ->UseRealTime()                                                                                                                               \
+    ->Unit(benchmark::kMillisecond)
+
+REGISTER_PUB_MAT_A_GENERATE_BENCH(1ul << 16, sequential);
+REGISTER_PUB_MAT_A_GENERATE_BENCH(1ul << 16, row_indexed_v1);
+REGISTER_PUB_MAT_A_GENERATE_BENCH(1ul << 17, sequential);
+REGISTER_PUB_MAT_A_GENERATE_BENCH(1ul << 17, row_indexed_v1);
@@ -0,0 +1,55 @@
+#include "bench_common.hpp"
+#include "frodoPIR/numa_server.hpp"
+#include "pir_online_phase_fixture.hpp"
+#include <format>
+
+// Responding from transposed parsed database matrix, placed across NUMA nodes of this machine. Besides overall throughput, reports rate at which
+// each node (socket) streams its own slice of the database, as all of them work at once.
+BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, NumaServerRespond)(benchmark::State& state)
+{
+  using numa_server_t = frodoPIR_numa_server::numa_server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  const size_t db_row_idx = generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, response_byte_len>(response_bytes);
+
+  assert(client_handle.prepare_query(db_row_idx, csprng));
+  assert(client_handle.query(db_row_idx, query_bytes_span));
+
+  const auto numa_server = numa_server_t::distribute(server_handle);
+  if (!numa_server.has_value()) {
+    state.SkipWithError("Failed to place database across NUMA nodes");
+    return;
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(numa_server);
+    benchmark::DoNotOptimize(query_bytes_span);
+    benchmark::DoNotOptimize(response_bytes_span);
+
+    numa_server->respond(query_bytes_span, response_bytes_span);
+
+    benchmark::ClobberMemory();
+  }
+
+  size_t total_slice_byte_len = 0;
+  for (size_t n_idx = 0; n_idx < numa_server->num_nodes(); n_idx++) {
+    const size_t slice_byte_len = numa_server->node_slice_byte_len(n_idx);
+    total_slice_byte_len += slice_byte_len;
+
+    state.counters[std::format("node{}_bytes_per_second", n_idx)] =
+      benchmark::Counter(static_cast<double>(slice_byte_len), benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1024);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * total_slice_byte_len));
+}
+
+BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, NumaServerRespond)
+  ->Name(std::format("frodoPIR/numa_server_respond/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
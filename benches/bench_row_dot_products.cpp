@@ -0,0 +1,61 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/simd.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <vector>
+
+// Shape of transposed parsed database matrix, for a database with 2^20 entries, each of 1KB, while each element of matrix has 9 significant bits.
+static constexpr size_t db_entry_count = 1ul << 20;
+static constexpr size_t num_columns_in_parsed_db = 911;
+
+// Single threaded dot products of a query vector with all rows of transposed database matrix, using vector kernel for requested instruction
+// set extension. Reported bytes per second, over the database matrix, is meant to be compared against DRAM bandwidth of the machine.
+template<frodoPIR_simd::isa_t isa>
+static void
+bench_row_dot_products(benchmark::State& state)
+{
+  if (!frodoPIR_simd::is_supported(isa)) {
+    state.SkipWithError("Instruction set extension is not supported by this CPU");
+    return;
+  }
+
+  std::vector<uint32_t> query(db_entry_count);
+  std::vector<uint16_t> db_matrix(num_columns_in_parsed_db * db_entry_count);
+  std::vector<uint32_t> response(num_columns_in_parsed_db);
+
+  csprng::csprng_t csprng{};
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(query.data()), query.size() * sizeof(uint32_t)));
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(db_matrix.data()), db_matrix.size() * sizeof(uint16_t)));
+
+  const auto kernel = frodoPIR_simd::get_row_dot_products_kernel<uint16_t>(isa);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(query.data());
+    benchmark::DoNotOptimize(db_matrix.data());
+
+    kernel(query.data(), db_matrix.data(), db_entry_count, num_columns_in_parsed_db, db_entry_count, response.data());
+
+    benchmark::DoNotOptimize(response.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(db_matrix.size() * sizeof(uint16_t)));
+}
+
+#define REGISTER_ROW_DOT_PRODUCTS_BENCH(isa)                                                                                                           \
+  BENCHMARK(bench_row_dot_products<isa>)                                                                                                               \
+    ->Name(std::format("frodoPIR/row_dot_products/{}/{}/{}",                                                                                         \
+                       frodoPIR_simd::isa_name(isa),                                                                                                   \
+                       format_number(db_entry_count),                                                                                                  \
+                       format_bytes(num_columns_in_parsed_db * db_entry_count * sizeof(uint16_t))))                                                    \
+    ->ComputeStatistics("min", compute_min)                                                                                                            \
+    ->ComputeStatistics("max", compute_max)                                                                                                            \
+    ->MeasureProcessCPUTime()                                                                                                                          \
+    ->UseRealTime()                                                                                                                                    \
+    ->Unit(benchmark::kMillisecond)
+
+REGISTER_ROW_DOT_PRODUCTS_BENCH(frodoPIR_simd::isa_t::scalar);
+REGISTER_ROW_DOT_PRODUCTS_BENCH(frodoPIR_simd::isa_t::avx2);
+REGISTER_ROW_DOT_PRODUCTS_BENCH(frodoPIR_simd::isa_t::avx512);
+REGISTER_ROW_DOT_PRODUCTS_BENCH(frodoPIR_simd::isa_t::neon);
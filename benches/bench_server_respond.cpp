@@ -1,3 +1,4 @@
+#include "allocation_counter.hpp"
 #include "bench_common.hpp"
 #include "pir_online_phase_fixture.hpp"
 #include <format>
@@ -12,6 +13,9 @@ BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ServerRespond)(benchmark::State&
   assert(client_handle.prepare_query(db_row_idx, csprng));
   assert(client_handle.query(db_row_idx, query_bytes_span));
 
+  // Query and response buffers are aligned to `zq_t`, so respond must not allocate at all.
+  const size_t num_heap_allocations_before = allocation_counter::count();
+
   for (auto _ : state) {
     benchmark::DoNotOptimize(server_handle);
     benchmark::DoNotOptimize(query_bytes_span);
@@ -22,7 +26,11 @@ BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ServerRespond)(benchmark::State&
     benchmark::ClobberMemory();
   }
 
+  const size_t num_heap_allocations_after = allocation_counter::count();
+
   state.SetItemsProcessed(state.iterations());
+  state.counters["heap_allocations"] =
+    benchmark::Counter(static_cast<double>(num_heap_allocations_after - num_heap_allocations_before), benchmark::Counter::kAvgIterations);
 }
 
 BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ServerRespond)
@@ -32,3 +40,46 @@ BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ServerRespond)
   ->MeasureProcessCPUTime()
   ->UseRealTime()
   ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ServerRespondStreamed)(benchmark::State& state)
+{
+  // Query is fed in chunks, as they'd be read off a socket.
+  constexpr size_t chunk_byte_len = 1ul << 16;
+
+  const size_t db_row_idx = generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, response_byte_len>(response_bytes);
+
+  assert(client_handle.prepare_query(db_row_idx, csprng));
+  assert(client_handle.query(db_row_idx, query_bytes_span));
+
+  bool is_responded = true;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(server_handle);
+    benchmark::DoNotOptimize(query_bytes_span);
+    benchmark::DoNotOptimize(response_bytes_span);
+
+    auto stream = server_handle.begin();
+    for (size_t chunk_offset = 0; chunk_offset < query_byte_len; chunk_offset += chunk_byte_len) {
+      const size_t num_bytes = std::min(chunk_byte_len, query_byte_len - chunk_offset);
+      is_responded &= stream.feed(chunk_offset, query_bytes_span.subspan(chunk_offset, num_bytes));
+    }
+    is_responded &= stream.finish(response_bytes_span);
+
+    benchmark::DoNotOptimize(is_responded);
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_responded);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ServerRespondStreamed)
+  ->Name(std::format("frodoPIR/server_respond_streamed/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
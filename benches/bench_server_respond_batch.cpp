@@ -0,0 +1,70 @@
+#include "allocation_counter.hpp"
+#include "bench_common.hpp"
+#include "pir_online_phase_fixture.hpp"
+#include <format>
+
+BENCHMARK_DEFINE_F(FrodoPIROnlinePhaseFixture, ServerRespondBatch)(benchmark::State& state)
+{
+  using parsed_db_transposed_mat_t = server_t::parsed_db_transposed_mat_t;
+
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  const size_t db_row_idx = generate_random_db_index();
+
+  auto query_bytes_span = std::span<uint8_t, query_byte_len>(query_bytes);
+
+  assert(client_handle.prepare_query(db_row_idx, csprng));
+  assert(client_handle.query(db_row_idx, query_bytes_span));
+
+  // Same query is replicated for filling up the batch, which doesn't change cost of computing responses.
+  std::vector<uint8_t> queries_bytes(batch_size * query_byte_len, 0);
+  std::vector<uint8_t> responses_bytes(batch_size * response_byte_len, 0);
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    std::ranges::copy(query_bytes, queries_bytes.begin() + static_cast<ptrdiff_t>(b_idx * query_byte_len));
+  }
+
+  auto queries_bytes_span = std::span(queries_bytes);
+  auto responses_bytes_span = std::span(responses_bytes);
+
+  // Only two small arrays, of pointers to queries and responses, are allocated per batch.
+  const size_t num_heap_allocations_before = allocation_counter::count();
+
+  bool is_batch_responded = true;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(is_batch_responded);
+    benchmark::DoNotOptimize(server_handle);
+    benchmark::DoNotOptimize(queries_bytes_span);
+    benchmark::DoNotOptimize(responses_bytes_span);
+
+    is_batch_responded &= server_handle.respond_batch(queries_bytes_span, responses_bytes_span);
+
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_batch_responded);
+
+  const size_t num_heap_allocations_after = allocation_counter::count();
+
+  const auto num_queries = static_cast<double>(state.iterations() * batch_size);
+  const auto num_db_bytes_touched = num_queries * static_cast<double>(parsed_db_transposed_mat_t::get_byte_len());
+
+  // Effective bandwidth is what single query `respond` would need to sustain for matching the throughput of batched `respond`.
+  state.counters["queries/s"] = benchmark::Counter(num_queries, benchmark::Counter::kIsRate);
+  state.counters["effective_bandwidth"] = benchmark::Counter(num_db_bytes_touched, benchmark::Counter::kIsRate, benchmark::Counter::kIs1024);
+  state.counters["heap_allocations"] =
+    benchmark::Counter(static_cast<double>(num_heap_allocations_after - num_heap_allocations_before), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(static_cast<int64_t>(num_queries));
+}
+
+BENCHMARK_REGISTER_F(FrodoPIROnlinePhaseFixture, ServerRespondBatch)
+  ->Name(std::format("frodoPIR/server_respond_batch/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ArgName("batch_size")
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->Arg(64)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
@@ -1,12 +1,15 @@
 #include "bench_common.hpp"
 #include "frodoPIR/server.hpp"
 #include <benchmark/benchmark.h>
+#include <filesystem>
 #include <format>
+#include <unistd.h>
 
 static constexpr size_t db_entry_count = 1ul << 20;
 static constexpr size_t db_entry_byte_len = 1024;
 static constexpr size_t mat_element_bitlen = 9;
 
+template<bool is_streaming>
 static void
 bench_server_setup(benchmark::State& state)
 {
@@ -29,7 +32,7 @@ bench_server_setup(benchmark::State& state)
     benchmark::DoNotOptimize(seed_μ_span);
     benchmark::DoNotOptimize(db_bytes_span);
 
-    auto [server, M] = server_t::setup(seed_μ_span, db_bytes_span);
+    auto [server, M] = is_streaming ? server_t::setup_streaming(seed_μ_span, db_bytes_span) : server_t::setup(seed_μ_span, db_bytes_span);
 
     benchmark::DoNotOptimize(server);
     benchmark::DoNotOptimize(M);
@@ -39,10 +42,76 @@ bench_server_setup(benchmark::State& state)
   state.SetItemsProcessed(state.iterations());
 }
 
-BENCHMARK(bench_server_setup)
+BENCHMARK(bench_server_setup<false>)
   ->Name(std::format("frodoPIR/server_setup/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max)
   ->MeasureProcessCPUTime()
   ->UseRealTime()
   ->Unit(benchmark::kSecond);
+
+BENCHMARK(bench_server_setup<true>)
+  ->Name(std::format("frodoPIR/server_setup_streaming/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kSecond);
+
+// Opening server state, persisted by `server_t::save`, instead of setting up the server again. Page cache is warm, so this measures
+// checksum verification when `verify_checksum` is set, otherwise only cost of mapping and validating the header.
+template<bool verify_checksum>
+static void
+bench_server_open_mmap(benchmark::State& state)
+{
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  std::array<uint8_t, frodoPIR_server::λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+
+  auto seed_μ_span = std::span(seed_μ);
+  auto db_bytes_span = std::span<uint8_t, db_byte_len>(db_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ_span);
+  csprng.generate(db_bytes_span);
+
+  const auto path = std::filesystem::temp_directory_path() / std::format("frodoPIR-bench-{}.db", ::getpid());
+
+  {
+    auto [server, M] = server_t::setup(seed_μ_span, db_bytes_span);
+    if (!server.save(path, M)) {
+      state.SkipWithError("Failed to save server state");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    auto opened = server_t::open_mmap(path, { .verify_checksum = verify_checksum });
+
+    benchmark::DoNotOptimize(opened);
+    benchmark::ClobberMemory();
+  }
+
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bench_server_open_mmap<true>)
+  ->Name(std::format("frodoPIR/server_open_mmap/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(bench_server_open_mmap<false>)
+  ->Name(std::format("frodoPIR/server_open_mmap_unverified/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
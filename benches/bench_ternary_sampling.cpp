@@ -0,0 +1,35 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+
+// Rejection sampling a vector of `num_elements` -many elements from uniform ternary distribution, as client does, for secret vector, which has
+// `LWE_DIMENSION` -many elements, and for error vector, which has as many elements as there are database entries.
+template<size_t num_elements>
+static void
+bench_ternary_sampling(benchmark::State& state)
+{
+  using vector_t = frodoPIR_vector::row_vector_t<num_elements>;
+
+  csprng::csprng_t csprng{};
+
+  for (auto _ : state) {
+    auto sampled = vector_t::sample_from_uniform_ternary_distribution(csprng);
+
+    benchmark::DoNotOptimize(sampled);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_elements));
+}
+
+#define REGISTER_TERNARY_SAMPLING_BENCH(num_elements)                                                                                             \
+  BENCHMARK(bench_ternary_sampling<num_elements>)                                                                                                 \
+    ->Name(std::format("frodoPIR/ternary_sampling/{}", format_number(num_elements)))                                                              \
+    ->ComputeStatistics("min", compute_min)                                                                                                       \
+    ->ComputeStatistics("max", compute_max)                                                                                                       \
+    ->Unit(benchmark::kMicrosecond)
+
+REGISTER_TERNARY_SAMPLING_BENCH(1774);
+REGISTER_TERNARY_SAMPLING_BENCH(1ul << 20);
@@ -0,0 +1,72 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <format>
+#include <thread>
+#include <vector>
+
+// Dispatching a parallel job, over small inputs, is dominated by cost of distributing work among threads. This benchmark compares
+// spawning and joining `std::thread::hardware_concurrency()` -many fresh threads per call (which is what every parallel routine used
+// to do) against issuing the same job on the persistent thread pool.
+
+template<bool use_thread_pool>
+static void
+bench_parallel_for(benchmark::State& state)
+{
+  const size_t num_items = static_cast<size_t>(state.range(0));
+  std::vector<uint32_t> items(num_items, 1);
+
+  auto increment_items = [&](const size_t begin, const size_t end) {
+    for (size_t idx = begin; idx < end; idx++) {
+      items[idx]++;
+    }
+  };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(items.data());
+
+    if constexpr (use_thread_pool) {
+      frodoPIR_thread_pool::thread_pool_t::global().parallel_for(num_items, increment_items);
+    } else {
+      const size_t spawnable_num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+      const size_t num_items_per_thread = (num_items + (spawnable_num_threads - 1)) / spawnable_num_threads;
+
+      std::vector<std::thread> threads;
+      threads.reserve(spawnable_num_threads);
+
+      for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
+        const size_t begin = std::min(t_idx * num_items_per_thread, num_items);
+        const size_t end = std::min(begin + num_items_per_thread, num_items);
+
+        threads.emplace_back(increment_items, begin, end);
+      }
+
+      std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_items));
+}
+
+BENCHMARK(bench_parallel_for<false>)
+  ->Name(std::format("frodoPIR/parallel_for/spawn_per_call/{}", format_number(std::thread::hardware_concurrency())))
+  ->RangeMultiplier(8)
+  ->Range(1ul << 6, 1ul << 18)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(bench_parallel_for<true>)
+  ->Name(std::format("frodoPIR/parallel_for/thread_pool/{}", format_number(std::thread::hardware_concurrency())))
+  ->RangeMultiplier(8)
+  ->Range(1ul << 6, 1ul << 18)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max)
+  ->MeasureProcessCPUTime()
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
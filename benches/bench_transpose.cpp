@@ -0,0 +1,49 @@
+#include "bench_common.hpp"
+#include "frodoPIR/internals/matrix/serialization.hpp"
+#include <benchmark/benchmark.h>
+#include <format>
+
+static constexpr size_t db_entry_byte_len = 1024;
+
+// Transposition of parsed database matrix, which is done during server setup, for each of the recommended parameter sets.
+template<size_t db_entry_count, size_t mat_element_bitlen>
+static void
+bench_transpose(benchmark::State& state)
+{
+  using parsed_db_mat_t = frodoPIR_serialization::parsed_db_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  auto db_bytes_span = std::span<uint8_t, db_byte_len>(db_bytes);
+
+  csprng::csprng_t csprng{};
+  csprng.generate(db_bytes_span);
+
+  const parsed_db_mat_t D = frodoPIR_serialization::parse_db_bytes<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes_span);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(D);
+
+    auto D_transposed = D.transpose();
+
+    benchmark::DoNotOptimize(D_transposed);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(parsed_db_mat_t::get_byte_len()));
+}
+
+#define REGISTER_TRANSPOSE_BENCH(db_entry_count, mat_element_bitlen)                                                                                   \
+  BENCHMARK(bench_transpose<db_entry_count, mat_element_bitlen>)                                                                                       \
+    ->Name(std::format("frodoPIR/transpose/{}/{}", format_number(db_entry_count), format_bytes(db_entry_byte_len)))                                  \
+    ->ComputeStatistics("min", compute_min)                                                                                                            \
+    ->ComputeStatistics("max", compute_max)                                                                                                            \
+    ->MeasureProcessCPUTime()                                                                                                                          \
+    ->UseRealTime()                                                                                                                                    \
+    ->Unit(benchmark::kMillisecond)
+
+REGISTER_TRANSPOSE_BENCH(1ul << 16, 10);
+REGISTER_TRANSPOSE_BENCH(1ul << 17, 10);
+REGISTER_TRANSPOSE_BENCH(1ul << 18, 10);
+REGISTER_TRANSPOSE_BENCH(1ul << 19, 9);
+REGISTER_TRANSPOSE_BENCH(1ul << 20, 9);
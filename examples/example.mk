@@ -9,7 +9,7 @@ $(EXAMPLE_BUILD_DIR):
 	mkdir -p $@
 
 $(EXAMPLE_BUILD_DIR)/%.exe: $(EXAMPLE_DIR)/%.cpp $(EXAMPLE_BUILD_DIR)
-	$(CXX) $(CXX_DEFS) $(CXX_FLAGS) $(WARN_FLAGS) $(RELEASE_FLAGS) $(I_FLAGS) $(DEP_IFLAGS) $< -o $@
+	$(CXX) $(CXX_DEFS) $(CXX_FLAGS) $(WARN_FLAGS) $(RELEASE_FLAGS) $(I_FLAGS) $(DEP_IFLAGS) $< $(NUMA_LINK_FLAGS) -o $@
 
 example: $(EXAMPLE_EXECS) ## Build and run example program, demonstrating usage of FrodoPIR API
 	$(foreach exec,$^,./$(exec))
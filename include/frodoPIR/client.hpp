@@ -1,13 +1,28 @@
 #pragma once
 #include "frodoPIR/internals/matrix/matrix.hpp"
 #include "frodoPIR/internals/matrix/serialization.hpp"
+#include "frodoPIR/internals/matrix/simd.hpp"
 #include "frodoPIR/internals/matrix/vector.hpp"
 #include "frodoPIR/internals/utility/csprng.hpp"
 #include "frodoPIR/internals/utility/params.hpp"
+#include "frodoPIR/internals/utility/slab.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/internals/utility/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -20,13 +35,23 @@ enum class query_status_t : uint32_t
   sent,
 };
 
-// FrodoPIR client query data type
+// FrodoPIR client query data type. Vector `b`, which is as long as the database, lives in a slot of the client's query arena, until the query
+// is sent, after which only `c` is kept around, for decoding the response.
 template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
 struct client_query_t
 {
   query_status_t status;
   size_t db_index;
-  frodoPIR_vector::row_vector_t<db_entry_count> b;
+  std::optional<size_t> b_slot;
+  frodoPIR_vector::row_vector_t<frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)> c;
+};
+
+// FrodoPIR client query data type, which is not yet bound to any database row index. Neither `b` nor `c` depend on the index, until
+// the query is finalized, so these can be prepared ahead of time, without knowing which database rows are going to be enquired.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+struct unbound_client_query_t
+{
+  size_t b_slot;
   frodoPIR_vector::row_vector_t<frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)> c;
 };
 
@@ -34,6 +59,69 @@ static constexpr size_t λ = 128;
 static constexpr size_t LWE_DIMENSION = 1774;
 static constexpr size_t SEED_BYTE_LEN = λ / std::numeric_limits<uint8_t>::digits;
 
+// Given a `λ` -bit seed of public matrix A, having `db_entry_count` -many columns, and k -many secret vectors S_i, this routine computes S_i * A,
+// accumulating them into corresponding row vectors of `res`, without ever materializing A. Rather, rows of A are expanded from the seed, as per
+// `A_expansion_mode`, `A_row_block_len` -many at a time. Each block of A is then walked in column tiles s.t. each row of a tile gets added to
+// (or subtracted from) tiles of `res`, for which corresponding secret vector coefficient is +1 (or -1), while tiles of `res` stay cache
+// resident. As secret vectors are ternary, no multiplication is needed.
+template<size_t db_entry_count>
+forceinline void
+accumulate_secrets_x_expanded_pub_mat_A(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                        std::span<const frodoPIR_vector::row_vector_t<LWE_DIMENSION>> S,
+                                        std::span<frodoPIR_vector::row_vector_t<db_entry_count>> res,
+                                        const size_t A_row_block_len,
+                                        frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+                                        const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+{
+  constexpr size_t tile_width = std::min<size_t>(db_entry_count, 512);
+  const size_t batch_size = std::min(S.size(), res.size());
+
+  if (batch_size == 0) {
+    return;
+  }
+
+  const frodoPIR_matrix::ternary_index_t<LWE_DIMENSION> S_index(S.first(batch_size));
+  const auto kernel = frodoPIR_simd::get_ternary_accumulate_row_kernel<frodoPIR_matrix::zq_t>();
+
+  std::vector<frodoPIR_matrix::zq_t*> res_rows(batch_size);
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    res_rows[b_idx] = res[b_idx].row(0).data();
+  }
+
+  frodoPIR_matrix::matrix_row_stream_t<db_entry_count, λ> A_row_stream(seed_μ, A_expansion_mode);
+  std::vector<frodoPIR_matrix::zq_t> A_row_block(A_row_block_len * db_entry_count);
+
+  for (size_t r_idx_begin = 0; r_idx_begin < LWE_DIMENSION; r_idx_begin += A_row_block_len) {
+    const size_t num_rows_in_block = std::min(A_row_block_len, LWE_DIMENSION - r_idx_begin);
+
+    A_row_stream.next_rows(A_row_block.data(), num_rows_in_block, pool);
+
+    // Column tiles are distributed among threads of the pool.
+    pool.parallel_for(
+      db_entry_count,
+      [&](const size_t c_idx_begin, const size_t c_idx_end) {
+        for (size_t tile_begin = c_idx_begin; tile_begin < c_idx_end; tile_begin += tile_width) {
+          const size_t tile_end = std::min(tile_begin + tile_width, c_idx_end);
+
+          for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+            const auto positives = S_index.positives(r_idx_begin + r_idx);
+            const auto negatives = S_index.negatives(r_idx_begin + r_idx);
+
+            kernel(A_row_block.data() + r_idx * db_entry_count + tile_begin,
+                   tile_end - tile_begin,
+                   res_rows.data(),
+                   tile_begin,
+                   positives.data(),
+                   positives.size(),
+                   negatives.data(),
+                   negatives.size());
+          }
+        }
+      },
+      tile_width);
+  }
+}
+
 // Frodo *P*rivate *I*nformation *R*etrieval Client
 template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
   requires(frodoPIR_params::check_frodoPIR_params(db_entry_count, mat_element_bitlen))
@@ -45,13 +133,18 @@ public:
   static constexpr auto PUBLIC_MATRIX_M_BYTE_LEN = LWE_DIMENSION * NUM_COLUMNS_IN_PARSED_DB * sizeof(frodoPIR_matrix::zq_t);
   static constexpr auto QUERY_BYTE_LEN = db_entry_count * sizeof(frodoPIR_matrix::zq_t);
   static constexpr auto RESPONSE_BYTE_LEN = NUM_COLUMNS_IN_PARSED_DB * sizeof(frodoPIR_matrix::zq_t);
+  static constexpr size_t DEFAULT_A_ROW_BLOCK_LEN = 16;
+  static constexpr size_t MAX_UNBOUND_QUERY_REFILL_BATCH_LEN = 16;
+  static constexpr size_t QUERY_ARENA_SLOTS_PER_SLAB = 8;
 
   // Type aliases.
   using pub_mat_A_t = frodoPIR_matrix::matrix_t<LWE_DIMENSION, db_entry_count>;
   using pub_mat_M_t = frodoPIR_matrix::matrix_t<LWE_DIMENSION, NUM_COLUMNS_IN_PARSED_DB>;
+  using pub_mat_M_delta_t = frodoPIR_matrix::low_rank_delta_t<LWE_DIMENSION, NUM_COLUMNS_IN_PARSED_DB>;
   using secret_vec_t = frodoPIR_vector::row_vector_t<LWE_DIMENSION>;
   using error_vec_t = frodoPIR_vector::row_vector_t<db_entry_count>;
   using query_t = client_query_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using unbound_query_t = unbound_client_query_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
   using response_t = frodoPIR_vector::row_vector_t<NUM_COLUMNS_IN_PARSED_DB>;
 
   // Constructor(s)
@@ -60,71 +153,319 @@ public:
     , M(std::move(pub_matM))
   {
   }
+  explicit constexpr client_t(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                              auto pub_matM,
+                              const size_t A_row_block_len,
+                              const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+    : M(std::move(pub_matM))
+    , A_row_block_len(std::max<size_t>(A_row_block_len, 1))
+    , A_expansion_mode(A_expansion_mode)
+  {
+    std::ranges::copy(seed_μ, this->seed_μ.begin());
+  }
 
   client_t() = default;
-  client_t(const client_t&) = default;
-  client_t(client_t&&) = default;
-  client_t& operator=(const client_t&) = default;
-  client_t& operator=(client_t&&) = default;
+  ~client_t() { this->stop_background_refill(); }
+
+  // Copy starts with an empty pool of unbound queries, without background refill, because reusing an unbound query for two different database
+  // rows reveals both of them to the server. Vectors `b` of prepared queries are copied into a query arena of its own.
+  client_t(const client_t& other)
+    : seed_μ(other.seed_μ)
+    , A(other.A)
+    , M(other.M)
+    , A_row_block_len(other.A_row_block_len)
+    , A_expansion_mode(other.A_expansion_mode)
+    , queries(other.queries)
+    , pool(other.pool)
+    , query_arena(other.query_arena->create_empty_like())
+  {
+    for (auto& [_, query] : this->queries) {
+      if (query.b_slot.has_value()) {
+        const auto b_slot = this->query_arena->allocate();
+        std::ranges::copy(other.query_arena->slot(*query.b_slot), this->query_arena->slot(*b_slot).begin());
+
+        query.b_slot = b_slot;
+      }
+    }
+  }
+
+  // Background refill, if running, is stopped on source and restarted on destination, as it works on the client handle it was started on.
+  client_t(client_t&& other) { *this = std::move(other); }
+
+  client_t& operator=(const client_t& other)
+  {
+    if (this != &other) {
+      *this = client_t(other);
+    }
+    return *this;
+  }
+
+  client_t& operator=(client_t&& other)
+  {
+    if (this == &other) {
+      return *this;
+    }
+
+    this->stop_background_refill();
+    const size_t watermark = other.stop_background_refill();
+
+    this->seed_μ = other.seed_μ;
+    this->A = std::move(other.A);
+    this->M = std::move(other.M);
+    this->A_row_block_len = other.A_row_block_len;
+    this->A_expansion_mode = other.A_expansion_mode;
+    this->queries = std::move(other.queries);
+    this->pool = other.pool;
+    std::swap(this->unbound_queries, other.unbound_queries);
+    std::swap(this->query_arena, other.query_arena);
+
+    if (watermark > 0) {
+      this->start_background_refill(watermark);
+    }
+    return *this;
+  }
 
   // Given a `λ` -bit seed and a byte serialized public matrix M, computed by frodoPIR server, this routine can be used
-  // for setting up FrodoPIR client, ready to generate queries and process server response.
-  static forceinline constexpr client_t setup(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ, std::span<const uint8_t, PUBLIC_MATRIX_M_BYTE_LEN> pub_matM_bytes)
+  // for setting up FrodoPIR client, ready to generate queries and process server response. Public matrix A is expanded from the seed, as per
+  // `A_expansion_mode`, which must be the one server was set up with. Unless it's `sequential`, A is expanded using all threads of `pool`.
+  static forceinline constexpr client_t setup(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                              std::span<const uint8_t, PUBLIC_MATRIX_M_BYTE_LEN> pub_matM_bytes,
+                                              frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+                                              const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    client_t client(pub_mat_A_t::template generate<λ>(seed_μ, A_expansion_mode, pool), pub_mat_M_t::from_le_bytes(pub_matM_bytes));
+    client.A_expansion_mode = A_expansion_mode;
+
+    return client;
+  }
+
+  // Given a `λ` -bit seed and a byte serialized public matrix M, computed by frodoPIR server, this routine can be used for setting up a low-memory
+  // FrodoPIR client, which only keeps the seed and M, instead of materializing public matrix A. Every time a query is prepared, rows of A are
+  // expanded from the seed, `A_row_block_len` -many at a time. So client setup is almost instant and client memory usage is bounded by M and a
+  // single block of A, at the cost of expanding A during each query preparation. Larger blocks use more memory, with fewer passes of the
+  // accumulation loop over the query vector.
+  static forceinline constexpr client_t setup_lowmem(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                                     std::span<const uint8_t, PUBLIC_MATRIX_M_BYTE_LEN> pub_matM_bytes,
+                                                     const size_t A_row_block_len = DEFAULT_A_ROW_BLOCK_LEN,
+                                                     const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
   {
-    return client_t(pub_mat_A_t::template generate<λ>(seed_μ), pub_mat_M_t::from_le_bytes(pub_matM_bytes));
+    return client_t(seed_μ, pub_mat_M_t::from_le_bytes(pub_matM_bytes), A_row_block_len, A_expansion_mode);
+  }
+
+  // Sets the thread pool, which is used for preparing queries. It must outlive this client handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    const size_t watermark = this->stop_background_refill();
+    this->pool = &pool;
+
+    if (watermark > 0) {
+      this->start_background_refill(watermark);
+    }
+  }
+
+  // Given byte serialized delta of public matrix M, returned by `server_t::update_rows`, this routine brings public matrix M, kept by this client,
+  // in sync with the updated database. As each query caches S * M, computed using the stale M, all pending queries, prepared or sent, are dropped.
+  // So deltas must be applied in between rounds of queries, in the order the server produced them. Returns false, if delta is malformed, in
+  // which case nothing changes.
+  [[nodiscard("Must use status of applying delta of public matrix M")]] bool apply_pub_mat_M_delta(std::span<const uint8_t> pub_matM_delta_bytes)
+  {
+    const auto M_delta = pub_mat_M_delta_t::from_le_bytes(pub_matM_delta_bytes);
+    if (!M_delta.has_value()) {
+      return false;
+    }
+
+    const size_t watermark = this->stop_background_refill();
+
+    M_delta->apply_to(this->M, *this->pool);
+    this->queries.clear();
+    this->unbound_queries->queries.clear();
+    this->query_arena->clear();
+
+    if (watermark > 0) {
+      this->start_background_refill(watermark);
+    }
+
+    return true;
+  }
+
+  // Given maximum number of prepared queries and optionally a spill directory, this routine replaces the arena, holding vector `b` of each
+  // prepared (bound or unbound) query, which takes `QUERY_BYTE_LEN` -bytes. Once the arena is full, no more queries get prepared, until some
+  // of them are sent, as `b` is dropped from the arena, with its memory handed back to the OS, as soon as the query is serialized. Sent queries
+  // only keep `RESPONSE_BYTE_LEN` -bytes.
+  // If spill directory is given, arena lives in an unlinked temporary file there, mapped into memory, so that the kernel can write `b` vectors
+  // back to disk under memory pressure. Returns false, if there are prepared queries, or the arena can't be created in the spill directory.
+  [[nodiscard("Must use status of replacing query arena")]] bool set_query_arena(const size_t max_num_prepared_queries,
+                                                                                 std::optional<std::filesystem::path> spill_directory = std::nullopt)
+  {
+    const size_t watermark = this->stop_background_refill();
+
+    bool is_replaced = false;
+    if (this->query_arena->num_allocated_slots() == 0) {
+      auto query_arena =
+        frodoPIR_slab::slab_allocator_t::create(QUERY_BYTE_LEN, QUERY_ARENA_SLOTS_PER_SLAB, max_num_prepared_queries, std::move(spill_directory));
+
+      if (query_arena) {
+        this->query_arena = std::move(query_arena);
+        is_replaced = true;
+      }
+    }
+
+    if (watermark > 0) {
+      this->start_background_refill(watermark);
+    }
+    return is_replaced;
+  }
+
+  // Returns number of prepared (bound or unbound) queries, whose vector `b` is held by the query arena.
+  size_t num_prepared_queries() const { return this->query_arena->num_allocated_slots(); }
+
+  // Given `n`, this routine prepares `n` -many queries, which are not bound to any database row index, appending them to the pool of unbound
+  // queries. Later, when `query` is asked to finalize query for a database row index, for which no query has been prepared, it claims one
+  // unbound query from the pool, in O(1). So all the heavy work of query preparation can be done off the critical path, without knowing
+  // which database rows are going to be enquired. Unbound queries are prepared as a batch, same as `prepare_query` does. Returns number
+  // of prepared queries, which is lesser than `n`, only if query arena is full.
+  size_t prepare_unbound_queries(const size_t n, csprng::csprng_t& csprng)
+  {
+    auto prepared_queries = this->prepare_unbound_query_batch(n, csprng);
+    const size_t num_prepared_queries = prepared_queries.size();
+
+    std::scoped_lock lock(this->unbound_queries->lock);
+    std::ranges::move(prepared_queries, std::back_inserter(this->unbound_queries->queries));
+
+    return num_prepared_queries;
+  }
+
+  // Returns number of unbound queries, which are ready to be claimed by `query`.
+  size_t num_unbound_queries() const
+  {
+    std::scoped_lock lock(this->unbound_queries->lock);
+    return this->unbound_queries->queries.size();
+  }
+
+  // Given a watermark, this routine starts a background thread, which keeps the pool of unbound queries filled up to the watermark, preparing
+  // at most `MAX_UNBOUND_QUERY_REFILL_BATCH_LEN` -many queries at a time, using its own CSPRNG and the thread pool of this client. Each unbound
+  // query takes `QUERY_BYTE_LEN + RESPONSE_BYTE_LEN` -bytes of memory. If refill is already running, it's restarted with the new watermark.
+  // A zero watermark just stops it.
+  void start_background_refill(const size_t watermark)
+  {
+    this->stop_background_refill();
+    if (watermark == 0) {
+      return;
+    }
+
+    auto& state = *this->unbound_queries;
+
+    state.watermark = watermark;
+    state.stop_refill = false;
+    state.refiller = std::thread([this, &state]() {
+      csprng::csprng_t csprng{};
+      std::unique_lock lock(state.lock);
+
+      while (true) {
+        state.refill_cv.wait(lock, [&]() { return state.stop_refill || (state.queries.size() < state.watermark); });
+        if (state.stop_refill) {
+          break;
+        }
+
+        const size_t batch_size = std::min(state.watermark - state.queries.size(), MAX_UNBOUND_QUERY_REFILL_BATCH_LEN);
+
+        lock.unlock();
+        auto prepared_queries = this->prepare_unbound_query_batch(batch_size, csprng);
+        lock.lock();
+
+        // When query arena is full, wait for a query to be sent, which frees up a slot, or refill to be stopped.
+        if (prepared_queries.empty()) {
+          state.refill_cv.wait(lock, [&]() { return state.stop_refill || std::exchange(state.slot_released, false); });
+        }
+
+        std::ranges::move(prepared_queries, std::back_inserter(state.queries));
+      }
+    });
+  }
+
+  // Stops background refill of the pool of unbound queries, if running, waiting for the batch being prepared to be pooled. Returns the
+  // watermark it was running with, or zero, if it wasn't running.
+  size_t stop_background_refill()
+  {
+    if (!this->unbound_queries->refiller.joinable()) {
+      return 0;
+    }
+
+    auto& state = *this->unbound_queries;
+    {
+      std::scoped_lock lock(state.lock);
+      state.stop_refill = true;
+    }
+
+    state.refill_cv.notify_one();
+    state.refiller.join();
+
+    return std::exchange(state.watermark, 0);
   }
 
   // Given `n` -many database row indices, this routine prepares `n` -many queries, for enquiring their values,
   // using FrodoPIR scheme. This function returns a boolean vector of length `n` s.t. each boolean value denotes
   // status of query preparation, for corresponding database row index, as appearing in `db_row_indices`, in order.
+  //
+  // Secret vectors of all queries, being prepared, are stacked s.t. S * A and S * M are computed as blocked matrix products,
+  // streaming (or expanding, for low-memory client) public matrix A only once per batch, instead of once per query.
   [[nodiscard("Must use status of query preparation for DB row indices")]] constexpr std::vector<bool> prepare_query(std::span<const size_t> db_row_indices,
                                                                                                                      csprng::csprng_t& csprng)
   {
-    std::vector<bool> query_prep_status;
-    query_prep_status.reserve(db_row_indices.size());
+    return this->bind_prepared_queries(db_row_indices, [&](std::span<const size_t> q_indices) {
+      return this->prepare_unbound_query_batch(q_indices.size(), csprng);
+    });
+  }
 
-    for (const auto db_row_index : db_row_indices) {
-      query_prep_status.push_back(this->prepare_query(db_row_index, csprng));
+  // Same as above, but secret vectors S_i and row vectors b_i = S_i * A + E_i, one for each of `n` -many database row indices, in order, are
+  // computed outside of this client, e.g. in a single pass over public matrix A, expanded from a seed, which is shared by many clients. So
+  // only c_i = S_i * M is computed here. Secret and row vectors, corresponding to row indices, which can't be prepared, are ignored. If there
+  // aren't as many secret and row vectors, as row indices, no query is prepared.
+  [[nodiscard("Must use status of query preparation for DB row indices")]] std::vector<bool> prepare_query(std::span<const size_t> db_row_indices,
+                                                                                                           std::span<const secret_vec_t> S,
+                                                                                                           std::span<const error_vec_t> B)
+  {
+    if ((S.size() != db_row_indices.size()) || (B.size() != db_row_indices.size())) {
+      return std::vector<bool>(db_row_indices.size(), false);
     }
 
-    return query_prep_status;
+    return this->bind_prepared_queries(db_row_indices, [&](std::span<const size_t> q_indices) {
+      const auto b_slots = this->allocate_b_slots(q_indices.size());
+
+      std::vector<secret_vec_t> S_prepared;
+      std::vector<const error_vec_t*> B_prepared;
+
+      S_prepared.reserve(b_slots.size());
+      B_prepared.reserve(b_slots.size());
+
+      for (size_t b_idx = 0; b_idx < b_slots.size(); b_idx++) {
+        S_prepared.push_back(S[q_indices[b_idx]]);
+        B_prepared.push_back(&B[q_indices[b_idx]]);
+      }
+
+      return this->finish_unbound_query_batch(b_slots, S_prepared, B_prepared);
+    });
   }
 
   // Given a database row index, this routine prepares a query, so that value at that index can be enquired, using FrodoPIR scheme.
   // This routine returns boolean truth value if query for requested database row index is prepared - ready to be used, while also
   // placing an entry of query for corresponding database row index in the internal cache. But in case, query for corresponding database
-  // row index has already been prepared, it returns false, denoting that no change has been done to the internal cache.
+  // row index has already been prepared or query arena is full, it returns false, denoting that no change has been done to the internal cache.
   [[nodiscard("Must use status of query preparation")]] constexpr bool prepare_query(const size_t db_row_index, csprng::csprng_t& csprng)
   {
-    if (this->queries.contains(db_row_index)) {
-      return false;
-    }
-
-    const auto s = secret_vec_t::sample_from_uniform_ternary_distribution(csprng); // secret vector
-    const auto e = error_vec_t::sample_from_uniform_ternary_distribution(csprng);  // error vector
-
-    const auto b = s * this->A + e;
-    const auto c = s * this->M;
-
-    this->queries[db_row_index] = query_t{
-      .status = query_status_t::prepared,
-      .db_index = db_row_index,
-      .b = b,
-      .c = c,
-    };
-
-    return true;
+    const auto query_prep_status = this->prepare_query(std::span(&db_row_index, 1), csprng);
+    return query_prep_status[0];
   }
 
   // Given a database row index, for which query has already been prepared, this routine finalizes the query, making it ready
-  // for processing at the server's end. This routine returns boolean truth value if byte serialized query is ready to be sent to server.
-  // Or else it returns false, denoting either of
+  // for processing at the server's end. If no query has been prepared for the index, an unbound query is claimed from the pool, if any.
+  // This routine returns boolean truth value if byte serialized query is ready to be sent to server. Or else it returns false, denoting either of
   //
-  // (a) Query is not yet prepared for requested database row index.
+  // (a) Query is not yet prepared for requested database row index and pool of unbound queries is empty.
   // (b) Query is already sent to server for requested database row index.
-  [[nodiscard("Must use status of query finalization")]] constexpr bool query(const size_t db_row_index, std::span<uint8_t, QUERY_BYTE_LEN> query_bytes)
+  [[nodiscard("Must use status of query finalization")]] bool query(const size_t db_row_index, std::span<uint8_t, QUERY_BYTE_LEN> query_bytes)
   {
-    if (!this->queries.contains(db_row_index)) {
+    if (!this->queries.contains(db_row_index) && !this->claim_unbound_query(db_row_index)) {
       return false;
     }
     if (this->queries[db_row_index].status != query_status_t::prepared) {
@@ -134,9 +475,19 @@ public:
     constexpr auto rho = 1ul << mat_element_bitlen;
     constexpr auto query_indicator_value = static_cast<frodoPIR_matrix::zq_t>(frodoPIR_matrix::Q / rho);
 
-    this->queries[db_row_index].b[db_row_index] += query_indicator_value;
-    this->queries[db_row_index].b.to_le_bytes(query_bytes);
-    this->queries[db_row_index].status = query_status_t::sent;
+    auto& query = this->queries[db_row_index];
+
+    // b is kept in little-endian byte order, so it's serialized by copying, followed by adding the indicator value to b[db_row_index].
+    std::ranges::copy(this->query_arena->slot(*query.b_slot), query_bytes.begin());
+
+    auto indicator_bytes = query_bytes.subspan(db_row_index * sizeof(frodoPIR_matrix::zq_t), sizeof(frodoPIR_matrix::zq_t));
+    const auto indicated_value = frodoPIR_utils::from_le_bytes<frodoPIR_matrix::zq_t>(indicator_bytes) + query_indicator_value;
+    frodoPIR_utils::to_le_bytes(indicated_value, indicator_bytes);
+
+    // b is not needed anymore, only c is, for decoding the response.
+    this->release_b_slot(*query.b_slot);
+    query.b_slot.reset();
+    query.status = query_status_t::sent;
 
     return true;
   }
@@ -152,44 +503,213 @@ public:
                                                                                         std::span<const uint8_t, RESPONSE_BYTE_LEN> response_bytes,
                                                                                         std::span<uint8_t, db_entry_byte_len> db_row_bytes)
   {
-    if (!this->queries.contains(db_row_index)) {
+    const auto it = this->queries.find(db_row_index);
+    if (it == this->queries.end()) {
       return false;
     }
-    if (this->queries[db_row_index].status != query_status_t::sent) {
+    if (it->second.status != query_status_t::sent) {
       return false;
     }
 
-    constexpr auto rho = 1ul << mat_element_bitlen;
-    constexpr auto rounding_factor = static_cast<frodoPIR_matrix::zq_t>(frodoPIR_matrix::Q / rho);
-    constexpr auto rounding_floor = rounding_factor / 2;
+    // As rounding factor Q / ρ is a power of 2, rounding (c~ - c) to nearest multiple of it, with ties rounded down, boils down to adding
+    // one less than half of it and keeping top `mat_element_bitlen` bits.
+    constexpr auto rounding_shift = static_cast<uint32_t>(std::numeric_limits<frodoPIR_matrix::zq_t>::digits - mat_element_bitlen);
+    constexpr auto rounding_offset = (frodoPIR_matrix::zq_t(1) << (rounding_shift - 1)) - 1;
+
+    using elem_t = frodoPIR_serialization::parsed_db_elem_t<mat_element_bitlen>;
+
+    std::array<elem_t, NUM_COLUMNS_IN_PARSED_DB> db_matrix_row{};
+    frodoPIR_simd::get_decode_response_kernel<elem_t>()(
+      response_bytes.data(), it->second.c.row(0).data(), NUM_COLUMNS_IN_PARSED_DB, rounding_offset, rounding_shift, db_matrix_row.data());
+
+    frodoPIR_serialization::serialize_db_row<mat_element_bitlen, elem_t>(db_matrix_row, db_row_bytes);
+    this->queries.erase(it);
+
+    return true;
+  }
+
+private:
+  std::array<uint8_t, SEED_BYTE_LEN> seed_μ{};
+  std::optional<pub_mat_A_t> A{};
+  pub_mat_M_t M{};
+  size_t A_row_block_len = DEFAULT_A_ROW_BLOCK_LEN;
+  frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential;
+  std::unordered_map<size_t, query_t> queries{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+
+  // Pool of unbound queries, shared with the background refill thread. It lives on heap, so that it doesn't move along with the client handle.
+  struct unbound_query_pool_t
+  {
+    mutable std::mutex lock{};
+    std::condition_variable refill_cv{};
+    std::deque<unbound_query_t> queries{};
+    size_t watermark = 0;
+    bool stop_refill = false;
+    bool slot_released = false;
+    std::thread refiller{};
+  };
+  std::unique_ptr<unbound_query_pool_t> unbound_queries = std::make_unique<unbound_query_pool_t>();
+
+  // Arena of fixed-size slots, each holding vector `b` of a prepared query, in little-endian byte order.
+  std::unique_ptr<frodoPIR_slab::slab_allocator_t> query_arena = frodoPIR_slab::slab_allocator_t::create(QUERY_BYTE_LEN, QUERY_ARENA_SLOTS_PER_SLAB);
+
+  // Releases slot of query arena, waking up background refill, in case it's waiting for a free slot.
+  forceinline void release_b_slot(const size_t b_slot)
+  {
+    this->query_arena->release(b_slot);
+    {
+      std::scoped_lock lock(this->unbound_queries->lock);
+      this->unbound_queries->slot_released = true;
+    }
+    this->unbound_queries->refill_cv.notify_one();
+  }
+
+  // Given `n` -many database row indices, this routine picks the ones, which can be prepared i.e. which are neither already prepared nor
+  // repeated, handing their positions in `db_row_indices` to `prepare_batch`, which returns as many unbound queries, in order, as it could
+  // prepare. Those get bound to corresponding row indices. Returns status of query preparation, for each row index, in order.
+  template<typename prepare_batch_t>
+  std::vector<bool> bind_prepared_queries(std::span<const size_t> db_row_indices, prepare_batch_t&& prepare_batch)
+  {
+    std::vector<bool> query_prep_status(db_row_indices.size(), false);
+
+    std::vector<size_t> preparable_q_indices;
+    std::unordered_set<size_t> seen_db_row_indices;
+
+    for (size_t q_idx = 0; q_idx < db_row_indices.size(); q_idx++) {
+      const auto db_row_index = db_row_indices[q_idx];
+
+      if (!this->queries.contains(db_row_index) && seen_db_row_indices.insert(db_row_index).second) {
+        preparable_q_indices.push_back(q_idx);
+      }
+    }
 
-    response_t db_matrix_row{};
-    auto c_tilda = response_t::from_le_bytes(response_bytes);
+    auto prepared_queries = prepare_batch(std::span<const size_t>(preparable_q_indices));
 
-    for (size_t idx = 0; idx < NUM_COLUMNS_IN_PARSED_DB; idx++) {
-      const auto unscaled_res = c_tilda[idx] - this->queries[db_row_index].c[idx];
+    // Queries, which couldn't be prepared because query arena is full, are reported as not prepared.
+    for (size_t b_idx = 0; b_idx < prepared_queries.size(); b_idx++) {
+      const auto q_idx = preparable_q_indices[b_idx];
+      const auto db_row_index = db_row_indices[q_idx];
 
-      const auto scaled_res = unscaled_res / rounding_factor;
-      const auto scaled_rem = unscaled_res % rounding_factor;
+      this->queries[db_row_index] = query_t{
+        .status = query_status_t::prepared,
+        .db_index = db_row_index,
+        .b_slot = prepared_queries[b_idx].b_slot,
+        .c = std::move(prepared_queries[b_idx].c),
+      };
+      query_prep_status[q_idx] = true;
+    }
+
+    return query_prep_status;
+  }
+
+  // Allocates up to `n` -many slots of query arena, stopping as soon as it's full.
+  std::vector<size_t> allocate_b_slots(const size_t n) const
+  {
+    std::vector<size_t> b_slots;
+    b_slots.reserve(n);
+
+    for (size_t b_idx = 0; b_idx < n; b_idx++) {
+      const auto b_slot = this->query_arena->allocate();
+      if (!b_slot.has_value()) {
+        break;
+      }
+
+      b_slots.push_back(*b_slot);
+    }
+
+    return b_slots;
+  }
+
+  // Given `n`, this routine samples `n` -many secret vectors S_i and error vectors E_i, computing b_i = S_i * A + E_i and c_i = S_i * M. These
+  // don't depend on database row index, which gets mixed in only when query is finalized. Each b_i is placed in a slot of query arena, so at
+  // most as many queries are prepared, as there are free slots. Only reads A, M and thread pool of this client, besides allocating slots.
+  std::vector<unbound_query_t> prepare_unbound_query_batch(const size_t n, csprng::csprng_t& csprng) const
+  {
+    const auto b_slots = this->allocate_b_slots(n);
+    const size_t batch_size = b_slots.size();
+
+    std::vector<secret_vec_t> S;
+    std::vector<error_vec_t> B;
+
+    S.reserve(batch_size);
+    B.reserve(batch_size);
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      S.push_back(secret_vec_t::sample_from_uniform_ternary_distribution(csprng)); // secret vector
+      B.push_back(error_vec_t::sample_from_uniform_ternary_distribution(csprng));  // error vector
+    }
+
+    // B = S * A + E, where B is initialized with E
+    this->accumulate_secrets_x_pub_mat_A(S, B);
+
+    std::vector<const error_vec_t*> B_rows(batch_size);
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      B_rows[b_idx] = &B[b_idx];
+    }
+
+    return this->finish_unbound_query_batch(b_slots, S, B_rows);
+  }
 
-      auto rounded_res = scaled_res;
+  // Given k -many allocated slots of query arena, secret vectors S_i and row vectors b_i = S_i * A + E_i, this routine computes c_i = S_i * M,
+  // placing each b_i in its slot, returning k -many unbound queries.
+  std::vector<unbound_query_t> finish_unbound_query_batch(std::span<const size_t> b_slots,
+                                                          std::span<const secret_vec_t> S,
+                                                          std::span<const error_vec_t* const> B) const
+  {
+    const size_t batch_size = b_slots.size();
+
+    // C = S * M
+    std::vector<response_t> C(batch_size);
+    secret_vec_t::ternary_row_vectors_x_matrix(S.first(batch_size), this->M, std::span(C), *this->pool);
 
-      rounded_res += ((scaled_rem > rounding_floor) ? 1 : 0);
-      rounded_res %= static_cast<frodoPIR_matrix::zq_t>(rho);
+    std::vector<unbound_query_t> prepared_queries;
+    prepared_queries.reserve(batch_size);
 
-      db_matrix_row[idx] = rounded_res;
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      B[b_idx]->to_le_bytes(this->query_arena->slot(b_slots[b_idx]).template first<QUERY_BYTE_LEN>());
+      prepared_queries.push_back(unbound_query_t{ .b_slot = b_slots[b_idx], .c = std::move(C[b_idx]) });
     }
 
-    frodoPIR_serialization::serialize_db_row<db_entry_byte_len, mat_element_bitlen>(db_matrix_row, db_row_bytes);
-    this->queries.erase(db_row_index);
+    return prepared_queries;
+  }
+
+  // Claims an unbound query from the pool, if any, binding it to given database row index. Returns false, if the pool is empty.
+  bool claim_unbound_query(const size_t db_row_index)
+  {
+    auto& state = *this->unbound_queries;
+    std::unique_lock lock(state.lock);
+
+    if (state.queries.empty()) {
+      return false;
+    }
+
+    auto unbound_query = std::move(state.queries.front());
+    state.queries.pop_front();
+
+    lock.unlock();
+    state.refill_cv.notify_one();
+
+    this->queries[db_row_index] = query_t{
+      .status = query_status_t::prepared,
+      .db_index = db_row_index,
+      .b_slot = unbound_query.b_slot,
+      .c = std::move(unbound_query.c),
+    };
 
     return true;
   }
 
-private:
-  pub_mat_A_t A{};
-  pub_mat_M_t M{};
-  std::unordered_map<size_t, query_t> queries{};
+  // Given k -many secret vectors S_i, this routine computes S_i * A, accumulating them into corresponding row vectors of `res`, using public
+  // matrix A, if it's materialized. Otherwise rows of A are expanded from the seed, `A_row_block_len` -many at a time.
+  forceinline void accumulate_secrets_x_pub_mat_A(std::span<const secret_vec_t> S, std::span<error_vec_t> res) const
+  {
+    if (this->A.has_value()) {
+      secret_vec_t::ternary_row_vectors_x_matrix(S, *this->A, res, *this->pool);
+      return;
+    }
+
+    accumulate_secrets_x_expanded_pub_mat_A<db_entry_count>(this->seed_μ, S, res, this->A_row_block_len, *this->pool, this->A_expansion_mode);
+  }
 };
 
 }
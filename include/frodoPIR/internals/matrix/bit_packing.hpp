@@ -0,0 +1,330 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include "frodoPIR/internals/utility/utils.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FRODOPIR_BIT_PACKING_X86 1
+#include <immintrin.h>
+#endif
+
+// Kernels for unpacking database entries into elements of parsed database matrix, each of `bitlen` significant bits, and packing them back,
+// specialized for each bit length, at compile-time. As 8 elements of `bitlen` bits take exactly `bitlen` bytes, both are done a group of 8
+// elements at a time, s.t. each group begins at a byte boundary, leaving only the trailing, partial group of a row to the bit-at-a-time
+// routines of `frodoPIR_serialization`. Best kernel, supported by the CPU, is chosen at runtime, while the scalar one is the portable fallback.
+namespace frodoPIR_bit_packing {
+
+// Number of elements in a group, which takes `bitlen` -many bytes.
+inline constexpr size_t GROUP_LEN = std::numeric_limits<uint8_t>::digits;
+
+// Group kernels exist for elements, which are wider than a byte, but still fit in 16 -bit lanes, with room for a whole element to be
+// extracted by shifting a 16 -bit lane. This covers all recommended parameter sets.
+template<size_t bitlen>
+inline constexpr bool has_group_kernels = (std::numeric_limits<uint8_t>::digits < bitlen) && (bitlen < std::numeric_limits<uint16_t>::digits);
+
+// Implementations of group kernels.
+enum class impl_t : uint32_t
+{
+  scalar,
+  bmi2,
+  avx2,
+};
+
+inline constexpr std::array ALL_IMPLS = { impl_t::scalar, impl_t::bmi2, impl_t::avx2 };
+
+// Given `num_groups` -many groups, beginning at `bytes`, this kernel unpacks them into `num_groups * GROUP_LEN` -many elements.
+using unpack_groups_fn_t = void (*)(const uint8_t* bytes, size_t num_groups, uint16_t* elems);
+
+// Given `num_groups * GROUP_LEN` -many elements, this kernel packs their low `bitlen` bits into `num_groups` -many groups, beginning at `bytes`.
+template<typename elem_t>
+using pack_groups_fn_t = void (*)(const elem_t* elems, size_t num_groups, uint8_t* bytes);
+
+// Given a group of `bitlen` bytes, returns two 64 -bit words, holding first and last 4 elements of the group, respectively, in their low
+// `4 * bitlen` bits.
+template<size_t bitlen>
+forceinline std::array<uint64_t, 2>
+load_group_halves(const uint8_t* const group)
+{
+  constexpr size_t half_bitlen = (GROUP_LEN / 2) * bitlen;
+  constexpr size_t word_byte_len = sizeof(uint64_t);
+
+  const auto w0 = frodoPIR_utils::from_le_bytes<uint64_t>(std::span(group, word_byte_len));
+  const auto w1 = frodoPIR_utils::from_le_bytes<uint64_t>(std::span(group + word_byte_len, bitlen - word_byte_len));
+
+  return { w0, (w0 >> half_bitlen) | (w1 << (std::numeric_limits<uint64_t>::digits - half_bitlen)) };
+}
+
+// Given two 64 -bit words, holding first and last 4 elements of a group, in their low `4 * bitlen` bits, writes the group of `bitlen` bytes.
+template<size_t bitlen>
+forceinline void
+store_group_halves(const uint64_t lo, const uint64_t hi, uint8_t* const group)
+{
+  constexpr size_t half_bitlen = (GROUP_LEN / 2) * bitlen;
+  constexpr size_t word_byte_len = sizeof(uint64_t);
+
+  frodoPIR_utils::to_le_bytes(lo | (hi << half_bitlen), std::span(group, word_byte_len));
+  frodoPIR_utils::to_le_bytes(hi >> (std::numeric_limits<uint64_t>::digits - half_bitlen), std::span(group + word_byte_len, bitlen - word_byte_len));
+}
+
+// Portable unpacking kernel, extracting each element of a group using a constant shift and mask.
+template<size_t bitlen>
+inline void
+unpack_groups_scalar(const uint8_t* bytes, const size_t num_groups, uint16_t* elems)
+{
+  constexpr uint64_t mask = (1ul << bitlen) - 1ul;
+  constexpr size_t half_len = GROUP_LEN / 2;
+
+  for (size_t g_idx = 0; g_idx < num_groups; g_idx++) {
+    const auto [lo, hi] = load_group_halves<bitlen>(bytes + g_idx * bitlen);
+    uint16_t* const group_elems = elems + g_idx * GROUP_LEN;
+
+    for (size_t i = 0; i < half_len; i++) {
+      group_elems[i] = static_cast<uint16_t>((lo >> (i * bitlen)) & mask);
+      group_elems[half_len + i] = static_cast<uint16_t>((hi >> (i * bitlen)) & mask);
+    }
+  }
+}
+
+// Portable packing kernel, placing each element of a group using a constant mask and shift.
+template<size_t bitlen, typename elem_t>
+inline void
+pack_groups_scalar(const elem_t* elems, const size_t num_groups, uint8_t* bytes)
+{
+  constexpr uint64_t mask = (1ul << bitlen) - 1ul;
+  constexpr size_t half_len = GROUP_LEN / 2;
+
+  for (size_t g_idx = 0; g_idx < num_groups; g_idx++) {
+    const elem_t* const group_elems = elems + g_idx * GROUP_LEN;
+
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    for (size_t i = 0; i < half_len; i++) {
+      lo |= (static_cast<uint64_t>(group_elems[i]) & mask) << (i * bitlen);
+      hi |= (static_cast<uint64_t>(group_elems[half_len + i]) & mask) << (i * bitlen);
+    }
+
+    store_group_halves<bitlen>(lo, hi, bytes + g_idx * bitlen);
+  }
+}
+
+#if defined(FRODOPIR_BIT_PACKING_X86)
+
+// Mask, selecting low `bitlen` bits of each of 4 16 -bit lanes of a 64 -bit word.
+template<size_t bitlen>
+inline constexpr uint64_t BMI2_LANE_MASK = ((1ul << bitlen) - 1ul) * 0x0001000100010001ul;
+
+// BMI2 unpacking kernel, depositing each half of a group right into 4 16 -bit lanes, using a single `pdep`.
+template<size_t bitlen>
+__attribute__((target("bmi2"))) inline void
+unpack_groups_bmi2(const uint8_t* bytes, const size_t num_groups, uint16_t* elems)
+{
+  for (size_t g_idx = 0; g_idx < num_groups; g_idx++) {
+    const auto [lo, hi] = load_group_halves<bitlen>(bytes + g_idx * bitlen);
+
+    const uint64_t lo_lanes = _pdep_u64(lo, BMI2_LANE_MASK<bitlen>);
+    const uint64_t hi_lanes = _pdep_u64(hi, BMI2_LANE_MASK<bitlen>);
+
+    std::memcpy(elems + g_idx * GROUP_LEN, &lo_lanes, sizeof(lo_lanes));
+    std::memcpy(elems + g_idx * GROUP_LEN + GROUP_LEN / 2, &hi_lanes, sizeof(hi_lanes));
+  }
+}
+
+// BMI2 packing kernel, extracting low `bitlen` bits of 4 16 -bit lanes at once, using a single `pext`. Elements wider than 16 -bit are first
+// narrowed, as only their low `bitlen` bits are packed.
+template<size_t bitlen, typename elem_t>
+__attribute__((target("bmi2"))) inline void
+pack_groups_bmi2(const elem_t* elems, const size_t num_groups, uint8_t* bytes)
+{
+  for (size_t g_idx = 0; g_idx < num_groups; g_idx++) {
+    std::array<uint16_t, GROUP_LEN> group_elems{};
+    for (size_t i = 0; i < GROUP_LEN; i++) {
+      group_elems[i] = static_cast<uint16_t>(elems[g_idx * GROUP_LEN + i]);
+    }
+
+    uint64_t lo_lanes = 0;
+    uint64_t hi_lanes = 0;
+    std::memcpy(&lo_lanes, group_elems.data(), sizeof(lo_lanes));
+    std::memcpy(&hi_lanes, group_elems.data() + GROUP_LEN / 2, sizeof(hi_lanes));
+
+    store_group_halves<bitlen>(_pext_u64(lo_lanes, BMI2_LANE_MASK<bitlen>), _pext_u64(hi_lanes, BMI2_LANE_MASK<bitlen>), bytes + g_idx * bitlen);
+  }
+}
+
+// AVX2 unpacking, which needs each element of a group to lie within 4 bytes, beginning at a byte within first 13 bytes of the group, so that
+// a 16 -byte load covers whole group.
+template<size_t bitlen>
+inline constexpr bool has_avx2_unpack_kernel = has_group_kernels<bitlen> && ((((GROUP_LEN - 1) * bitlen) / 8 + sizeof(uint32_t)) <= 16);
+
+// Per 32 -bit lane shuffle indices and right shifts, s.t. lane i holds element i of a group in its low `bitlen` bits, after shuffling bytes of
+// the group, broadcasted to both 128 -bit halves, and shifting each lane.
+template<size_t bitlen>
+inline constexpr std::array<uint8_t, 32> AVX2_UNPACK_SHUFFLE = []() {
+  std::array<uint8_t, 32> shuffle{};
+  for (size_t i = 0; i < GROUP_LEN; i++) {
+    for (size_t b_idx = 0; b_idx < sizeof(uint32_t); b_idx++) {
+      shuffle[i * sizeof(uint32_t) + b_idx] = static_cast<uint8_t>((i * bitlen) / 8 + b_idx);
+    }
+  }
+  return shuffle;
+}();
+
+template<size_t bitlen>
+inline constexpr std::array<uint32_t, GROUP_LEN> AVX2_UNPACK_SHIFT = []() {
+  std::array<uint32_t, GROUP_LEN> shift{};
+  for (size_t i = 0; i < GROUP_LEN; i++) {
+    shift[i] = static_cast<uint32_t>((i * bitlen) % 8);
+  }
+  return shift;
+}();
+
+// Unpacks a group, beginning at `group`, into 8 32 -bit lanes, reading 16 bytes.
+template<size_t bitlen>
+__attribute__((target("avx2"))) inline __m256i
+avx2_unpack_group(const uint8_t* group, const __m256i shuffle, const __m256i shift, const __m256i mask)
+{
+  const __m256i group_bytes = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+  return _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(group_bytes, shuffle), shift), mask);
+}
+
+// AVX2 unpacking kernel, shuffling bytes of two groups into 32 -bit lanes, shifting each lane by its own amount, before narrowing all of them
+// to 16 -bit elements. As each group is read using a 16 -byte load, trailing groups, which are less than 16 bytes away from the end, are left
+// to the scalar kernel.
+template<size_t bitlen>
+__attribute__((target("avx2"))) inline void
+unpack_groups_avx2(const uint8_t* bytes, const size_t num_groups, uint16_t* elems)
+{
+  constexpr size_t load_byte_len = 16;
+
+  const __m256i shuffle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(AVX2_UNPACK_SHUFFLE<bitlen>.data()));
+  const __m256i shift = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(AVX2_UNPACK_SHIFT<bitlen>.data()));
+  const __m256i mask = _mm256_set1_epi32((1 << bitlen) - 1);
+
+  const size_t total_byte_len = num_groups * bitlen;
+
+  size_t g_idx = 0;
+  for (; (g_idx + 1) * bitlen + load_byte_len <= total_byte_len; g_idx += 2) {
+    const __m256i group0 = avx2_unpack_group<bitlen>(bytes + g_idx * bitlen, shuffle, shift, mask);
+    const __m256i group1 = avx2_unpack_group<bitlen>(bytes + (g_idx + 1) * bitlen, shuffle, shift, mask);
+
+    // Narrowing packs 128 -bit halves separately, so 64 -bit quarters are reordered to put both halves of each group together.
+    const __m256i narrowed = _mm256_permute4x64_epi64(_mm256_packus_epi32(group0, group1), 0b11011000);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(elems + g_idx * GROUP_LEN), narrowed);
+  }
+
+  unpack_groups_scalar<bitlen>(bytes + g_idx * bitlen, num_groups - g_idx, elems + g_idx * GROUP_LEN);
+}
+
+#endif
+
+// Returns truth value, denoting whether kernels of requested implementation are compiled in and supported by this CPU.
+inline bool
+is_supported(const impl_t impl)
+{
+  switch (impl) {
+    case impl_t::scalar:
+      return true;
+#if defined(FRODOPIR_BIT_PACKING_X86)
+    case impl_t::bmi2:
+      return __builtin_cpu_supports("bmi2");
+    case impl_t::avx2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+// Returns human readable name of implementation.
+inline constexpr std::string_view
+impl_name(const impl_t impl)
+{
+  switch (impl) {
+    case impl_t::bmi2:
+      return "bmi2";
+    case impl_t::avx2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+// Given an implementation, supported by this CPU, returns unpacking kernel of it, for elements of `bitlen` bits. Falls back to the scalar
+// kernel, if requested implementation has no unpacking kernel, for that bit length.
+template<size_t bitlen>
+  requires(has_group_kernels<bitlen>)
+inline unpack_groups_fn_t
+get_unpack_groups_kernel(const impl_t impl)
+{
+  switch (impl) {
+#if defined(FRODOPIR_BIT_PACKING_X86)
+    case impl_t::bmi2:
+      return &unpack_groups_bmi2<bitlen>;
+    case impl_t::avx2:
+      if constexpr (has_avx2_unpack_kernel<bitlen>) {
+        return &unpack_groups_avx2<bitlen>;
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+
+  return &unpack_groups_scalar<bitlen>;
+}
+
+// Given an implementation, supported by this CPU, returns packing kernel of it, for elements of `bitlen` bits. Falls back to the scalar
+// kernel, if requested implementation has no packing kernel.
+template<size_t bitlen, typename elem_t>
+  requires(has_group_kernels<bitlen>)
+inline pack_groups_fn_t<elem_t>
+get_pack_groups_kernel(const impl_t impl)
+{
+  switch (impl) {
+#if defined(FRODOPIR_BIT_PACKING_X86)
+    case impl_t::bmi2:
+      return &pack_groups_bmi2<bitlen, elem_t>;
+#endif
+    default:
+      break;
+  }
+
+  return &pack_groups_scalar<bitlen, elem_t>;
+}
+
+// Returns fastest unpacking kernel, supported by this CPU, for elements of `bitlen` bits. It's chosen once.
+template<size_t bitlen>
+  requires(has_group_kernels<bitlen>)
+forceinline unpack_groups_fn_t
+get_unpack_groups_kernel()
+{
+  static const auto kernel = []() {
+    for (const auto impl : { impl_t::avx2, impl_t::bmi2 }) {
+      if (is_supported(impl)) {
+        return get_unpack_groups_kernel<bitlen>(impl);
+      }
+    }
+
+    return get_unpack_groups_kernel<bitlen>(impl_t::scalar);
+  }();
+
+  return kernel;
+}
+
+// Returns fastest packing kernel, supported by this CPU, for elements of `bitlen` bits. It's chosen once.
+template<size_t bitlen, typename elem_t>
+  requires(has_group_kernels<bitlen>)
+forceinline pack_groups_fn_t<elem_t>
+get_pack_groups_kernel()
+{
+  static const auto kernel = get_pack_groups_kernel<bitlen, elem_t>(is_supported(impl_t::bmi2) ? impl_t::bmi2 : impl_t::scalar);
+  return kernel;
+}
+
+}
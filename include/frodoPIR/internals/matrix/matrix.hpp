@@ -1,18 +1,22 @@
 #pragma once
+#include "frodoPIR/internals/matrix/simd.hpp"
+#include "frodoPIR/internals/utility/allocator.hpp"
 #include "frodoPIR/internals/utility/csprng.hpp"
 #include "frodoPIR/internals/utility/force_inline.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
 #include "frodoPIR/internals/utility/utils.hpp"
 #include "sha3/turboshake128.hpp"
 #include "sha3/turboshake256.hpp"
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <optional>
 #include <span>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,6 +26,10 @@ namespace frodoPIR_matrix {
 using zq_t = uint32_t;
 constexpr auto Q = static_cast<uint64_t>(std::numeric_limits<zq_t>::max()) + 1;
 
+// Views of byte serialized queries and responses, as arrays of `zq_t`, which are read-only and writable, respectively.
+using zq_const_view_t = frodoPIR_utils::le_span_view_t<const zq_t>;
+using zq_view_t = frodoPIR_utils::le_span_view_t<zq_t>;
+
 // Size of interval, used for sampling from uniform ternary distribution χ.
 inline constexpr size_t TERNARY_INTERVAL_SIZE = (std::numeric_limits<zq_t>::max() - 2) / 3;
 // Uniform sampled value to be rejected, if greater than sampling max, which is < uint32_t_MAX.
@@ -35,29 +43,128 @@ constexpr auto get_required_num_columns = [](const size_t db_entry_byte_len, con
   return required_num_cols;
 };
 
-// Matrix of dimension `rows x cols`.
-template<size_t rows, size_t cols>
-  requires((rows > 0) && (cols > 0))
-struct matrix_t
+// Way rows of a pseudo-random matrix, such as public matrix A, are expanded from a `λ` -bit seed μ. As server and clients expand A on their
+// own, they must agree on it, so it's a public parameter, alongside μ. Numeric value of a mode is its version tag, in serialized form.
+enum class expansion_mode_t : uint32_t
+{
+  // All rows are squeezed, one after another, from a single CSPRNG, seeded with TurboSHAKE128(μ). Rows can't be expanded in parallel and
+  // reaching row i requires expanding all rows before it.
+  sequential = 0,
+  // Row i is squeezed from a CSPRNG of its own, seeded with TurboSHAKE128(domain separator || μ || i), where i is a 64 -bit little-endian
+  // integer. So any row can be expanded on its own and a block of rows can be expanded using all cores.
+  row_indexed_v1 = 1,
+};
+
+// Returns truth value, denoting whether given version tag denotes a known expansion mode.
+forceinline constexpr bool
+is_valid_expansion_mode(const uint32_t mode)
+{
+  return mode <= static_cast<uint32_t>(expansion_mode_t::row_indexed_v1);
+}
+
+// Domain separator, absorbed before μ, while seeding CSPRNG of a row, in `expansion_mode_t::row_indexed_v1`.
+inline constexpr std::array<uint8_t, 16> ROW_INDEXED_V1_DOMAIN_SEPARATOR{ 'F', 'r', 'o', 'd', 'o', 'P', 'I', 'R', '/', 'A', '/', 'r', 'o', 'w', '/', '1' };
+
+// Given a `λ` -bit seed μ, uniform random rows, each having `cols` -many elements, can be expanded from it, one after another, in order.
+// As `matrix_t::generate` expands rows from this stream, one can process a pseudo-random matrix, row block by row block, without ever
+// materializing it in full. Unless expansion mode is `sequential`, rows can also be expanded out of order and in parallel.
+template<size_t cols, size_t λ>
+  requires(std::endian::native == std::endian::little)
+struct matrix_row_stream_t
 {
 public:
-  // Constructor(s)
-  forceinline constexpr matrix_t() { this->elements = std::vector<zq_t>(rows * cols, zq_t{}); };
-  explicit matrix_t(std::vector<zq_t> elements)
-    : elements(std::move(elements))
+  static constexpr size_t SEED_BYTE_LEN = λ / std::numeric_limits<uint8_t>::digits;
+
+  explicit matrix_row_stream_t(std::span<const uint8_t, SEED_BYTE_LEN> μ, const expansion_mode_t mode = expansion_mode_t::sequential)
+    : csprng(derive_csprng_seed(μ))
+    , mode(mode)
   {
+    std::ranges::copy(μ, this->μ.begin());
   }
-  matrix_t(const matrix_t&) = default;
-  matrix_t(matrix_t&&) = default;
-  matrix_t& operator=(const matrix_t&) = default;
-  matrix_t& operator=(matrix_t&&) = default;
 
-  // Given a `λ` -bit seed, this routine uniform random samples a matrix of dimension `rows x cols`.
-  template<size_t λ>
-    requires(std::endian::native == std::endian::little)
-  static forceinline matrix_t generate(std::span<const uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ)
+  // Expands next row of the pseudo-random matrix, writing it to `row`.
+  forceinline void next(std::span<zq_t, cols> row)
+  {
+    if (this->mode == expansion_mode_t::sequential) {
+      constexpr size_t row_byte_len = cols * sizeof(zq_t);
+
+      auto row_bytes = std::span<uint8_t, row_byte_len>(reinterpret_cast<uint8_t*>(row.data()), row_byte_len);
+      this->csprng.generate(row_bytes);
+    } else {
+      expand_row(this->μ, this->next_row_idx, row);
+    }
+
+    this->next_row_idx++;
+  }
+
+  // Expands next `num_rows` -many rows of the pseudo-random matrix, writing them consecutively, beginning at `rows`. Unless expansion mode is
+  // `sequential`, rows are expanded in parallel, using threads of the pool.
+  forceinline void next_rows(zq_t* const rows,
+                             const size_t num_rows,
+                             frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    this->next_rows(num_rows, [&](const size_t r_idx) { return std::span<zq_t, cols>(rows + r_idx * cols, cols); }, pool);
+  }
+
+  // Same as above, but i-th of next `num_rows` -many rows is written to `row_at(i)`, which must return a `std::span<zq_t, cols>`, for rows not
+  // laid out consecutively.
+  template<typename row_at_t>
+  forceinline void next_rows(const size_t num_rows,
+                             row_at_t&& row_at,
+                             frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    if (this->mode == expansion_mode_t::sequential) {
+      for (size_t r_idx = 0; r_idx < num_rows; r_idx++) {
+        this->next(row_at(r_idx));
+      }
+      return;
+    }
+
+    const size_t first_row_idx = this->next_row_idx;
+    pool.parallel_for(
+      num_rows,
+      [&](const size_t r_idx_begin, const size_t r_idx_end) {
+        for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
+          expand_row(this->μ, first_row_idx + r_idx, row_at(r_idx));
+        }
+      },
+      1);
+
+    this->next_row_idx += num_rows;
+  }
+
+  // Given a `λ` -bit seed μ and index of a row, this routine expands that row alone, in `expansion_mode_t::row_indexed_v1`.
+  static forceinline void expand_row(std::span<const uint8_t, SEED_BYTE_LEN> μ, const size_t r_idx, std::span<zq_t, cols> row)
+  {
+    constexpr size_t row_byte_len = cols * sizeof(zq_t);
+
+    std::array<uint8_t, sizeof(uint64_t)> r_idx_bytes{};
+    frodoPIR_utils::to_le_bytes(static_cast<uint64_t>(r_idx), std::span(r_idx_bytes));
+
+    std::array<uint8_t, csprng::csprng_t::seed_byte_len> seed{};
+
+    turboshake128::turboshake128_t xof;
+    xof.absorb(ROW_INDEXED_V1_DOMAIN_SEPARATOR);
+    xof.absorb(μ);
+    xof.absorb(r_idx_bytes);
+    xof.finalize();
+    xof.squeeze(seed);
+
+    csprng::csprng_t row_csprng(seed);
+
+    auto row_bytes = std::span<uint8_t, row_byte_len>(reinterpret_cast<uint8_t*>(row.data()), row_byte_len);
+    row_csprng.generate(row_bytes);
+  }
+
+private:
+  csprng::csprng_t csprng;
+  std::array<uint8_t, SEED_BYTE_LEN> μ{};
+  expansion_mode_t mode;
+  size_t next_row_idx = 0;
+
+  // Pass `λ`-bit seed μ through TurboSHAKE128 to produce longer seed, needed to initialize RandomSHAKE CSPRNG.
+  static forceinline std::array<uint8_t, csprng::csprng_t::seed_byte_len> derive_csprng_seed(std::span<const uint8_t, SEED_BYTE_LEN> μ)
   {
-    // Pass `λ`-bit seed μ through TurboSHAKE128 to produce longer (= 136-bytes) seed need to initialize RandomSHAKE CSPRNG.
     std::array<uint8_t, csprng::csprng_t::seed_byte_len> seed{ 0 };
 
     turboshake128::turboshake128_t xof;
@@ -65,20 +172,371 @@ public:
     xof.finalize();
     xof.squeeze(seed);
 
-    csprng::csprng_t csprng(seed);
+    return seed;
+  }
+};
 
-    constexpr size_t row_byte_len = cols * sizeof(zq_t);
-    matrix_t mat{};
+// Given k -many ternary vectors of length `len`, each coefficient ∈ {-1, 0, +1}, encoded as {Q-1, 0, 1}, this structure indexes them
+// position by position, listing for each position which of those k vectors hold +1 and which hold -1 at that position. Zero coefficients,
+// which are about a third of all coefficients when sampled from uniform ternary distribution χ, don't get indexed at all. So multiplying
+// ternary vectors with a matrix boils down to adding and subtracting whole rows of that matrix.
+template<size_t len>
+struct ternary_index_t
+{
+public:
+  template<typename vector_t>
+  explicit ternary_index_t(std::span<const vector_t> vectors)
+  {
+    this->pos_offsets[0] = 0;
+    this->neg_offsets[0] = 0;
 
-    for (size_t r_idx = 0; r_idx < rows; r_idx++) {
-      const size_t row_begins_at = r_idx * row_byte_len;
+    for (size_t idx = 0; idx < len; idx++) {
+      for (size_t v_idx = 0; v_idx < vectors.size(); v_idx++) {
+        const zq_t coeff = vectors[v_idx][idx];
+
+        if (coeff == 1) {
+          this->pos_vector_indices.push_back(static_cast<uint32_t>(v_idx));
+        } else if (coeff == std::numeric_limits<zq_t>::max()) {
+          this->neg_vector_indices.push_back(static_cast<uint32_t>(v_idx));
+        }
+      }
+
+      this->pos_offsets[idx + 1] = this->pos_vector_indices.size();
+      this->neg_offsets[idx + 1] = this->neg_vector_indices.size();
+    }
+  }
+
+  // Indices of vectors, having +1 coefficient at position `idx`.
+  forceinline std::span<const uint32_t> positives(const size_t idx) const
+  {
+    return std::span(this->pos_vector_indices).subspan(this->pos_offsets[idx], this->pos_offsets[idx + 1] - this->pos_offsets[idx]);
+  }
+
+  // Indices of vectors, having -1 coefficient at position `idx`.
+  forceinline std::span<const uint32_t> negatives(const size_t idx) const
+  {
+    return std::span(this->neg_vector_indices).subspan(this->neg_offsets[idx], this->neg_offsets[idx + 1] - this->neg_offsets[idx]);
+  }
 
-      auto row_begin_ptr = reinterpret_cast<uint8_t*>(mat.elements.data()) + row_begins_at;
-      auto row_span = std::span<uint8_t, row_byte_len>(row_begin_ptr, row_byte_len);
+private:
+  std::array<size_t, len + 1> pos_offsets{};
+  std::array<size_t, len + 1> neg_offsets{};
+  std::vector<uint32_t> pos_vector_indices{};
+  std::vector<uint32_t> neg_vector_indices{};
+};
+
+// Number of consecutive rows of a matrix, transposed together, as a unit of work. Whole block doesn't necessarily fit in L2 cache, e.g. it's
+// ~933 KB for widest rows of parsed database matrix, but it is read in narrow column strips, each of which stays resident in L1 data cache.
+inline constexpr size_t TRANSPOSE_ROW_BLOCK_LEN = 512;
+
+// Given a block of `num_rows x num_cols` elements of a row-major matrix, beginning at `src` s.t. consecutive rows are `src_stride` -many
+// elements apart, this routine writes its transpose, beginning at `dst` s.t. consecutive rows are `dst_stride` -many elements apart.
+//
+// Block is walked in column strips, which are two micro-tiles wide. Each strip is transposed micro-tile by micro-tile, going down the rows,
+// so that only a few rows of destination are written at a time, each of them sequentially. Walking wider tiles instead thrashes caches and
+// TLB, as rows of destination are usually a large power of 2 bytes apart, mapping to the same cache sets.
+template<typename elem_t>
+forceinline void
+transpose_block(const elem_t* src, const size_t src_stride, elem_t* dst, const size_t dst_stride, const size_t num_rows, const size_t num_cols)
+{
+  constexpr size_t tile_dim = frodoPIR_simd::TRANSPOSE_TILE_DIM<elem_t>;
+  constexpr size_t strip_width = 2 * tile_dim;
+
+  for (size_t c_begin = 0; c_begin < num_cols; c_begin += strip_width) {
+    const size_t c_end = std::min(c_begin + strip_width, num_cols);
+
+    size_t r_idx = 0;
+    for (; r_idx + tile_dim <= num_rows; r_idx += tile_dim) {
+      size_t c_idx = c_begin;
+      for (; c_idx + tile_dim <= c_end; c_idx += tile_dim) {
+        frodoPIR_simd::transpose_tile(src + r_idx * src_stride + c_idx, src_stride, dst + c_idx * dst_stride + r_idx, dst_stride);
+      }
+
+      for (; c_idx < c_end; c_idx++) {
+        for (size_t i = r_idx; i < r_idx + tile_dim; i++) {
+          dst[c_idx * dst_stride + i] = src[i * src_stride + c_idx];
+        }
+      }
+    }
+
+    for (; r_idx < num_rows; r_idx++) {
+      for (size_t c_idx = c_begin; c_idx < c_end; c_idx++) {
+        dst[c_idx * dst_stride + r_idx] = src[r_idx * src_stride + c_idx];
+      }
+    }
+  }
+}
+
+// Given k -many row vectors A_i, each of length `row_len`, and `num_rhs_rows` -many rows of a transposed matrix B, each of length `row_len`,
+// stored consecutively beginning at `rhs`, this routine multiplies each A_i with B over Zq, accumulating k -many row vectors C_i, each of length
+// `num_rhs_rows`, into `res`. This is the runtime-sized core of `matrix_t::row_vectors_x_transposed_matrix`, also usable on a slice of the
+// database, whose dimensions are only known at runtime.
+//
+// Rather than streaming whole B once per row vector, columns of B are walked in tiles, which are small enough to stay resident in L1 data
+// cache, while tiles of all k row vectors stay in L2. So each tile of B, once fetched from DRAM, is applied to all k row vectors. Within a
+// tile, a few rows of B are multiplied with each row vector at a time, using the fastest vector kernel, supported by the CPU.
+template<typename rhs_elem_t>
+forceinline void
+row_vectors_x_transposed_rows(std::span<const zq_t* const> lhs,
+                              const rhs_elem_t* const rhs,
+                              const size_t num_rhs_rows,
+                              const size_t row_len,
+                              std::span<zq_t* const> res,
+                              frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  const size_t tile_width = std::min<size_t>(row_len, 1024);
+  const size_t batch_size = std::min(lhs.size(), res.size());
 
-      csprng.generate(row_span);
+  if ((batch_size == 0) || (num_rhs_rows == 0) || (row_len == 0)) {
+    return;
+  }
+
+  const auto row_dot_products = frodoPIR_simd::get_row_dot_products_kernel<rhs_elem_t>();
+
+  // Rows of B are distributed among threads of the pool.
+  pool.parallel_for(num_rhs_rows, [&](const size_t c_idx_begin, const size_t c_idx_end) {
+    for (size_t k_begin = 0; k_begin < row_len; k_begin += tile_width) {
+      const size_t k_end = std::min(k_begin + tile_width, row_len);
+
+      for (size_t c_idx = c_idx_begin; c_idx < c_idx_end; c_idx += frodoPIR_simd::ROW_BLOCK_LEN) {
+        const size_t num_rows_in_block = std::min(frodoPIR_simd::ROW_BLOCK_LEN, c_idx_end - c_idx);
+
+        for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+          row_dot_products(lhs[b_idx] + k_begin, rhs + c_idx * row_len + k_begin, row_len, num_rows_in_block, k_end - k_begin, res[b_idx] + c_idx);
+        }
+      }
     }
+  });
+}
+
+// Given a row vector A ( of length `block_len` ) and a column block of transposed matrix B, consisting of `num_rhs_rows` -many rows s.t. each
+// row starts `rhs_stride` elements after the previous one and holds `block_len` -many elements, this routine multiplies A with that block
+// over Zq, accumulating resulting row vector ( of length `num_rhs_rows` ) into `res`. So, row vector x transposed matrix can be computed
+// piecewise, one column block of B at a time, as consecutive pieces of the row vector become available.
+template<typename rhs_elem_t>
+forceinline void
+row_vector_x_transposed_column_block(const zq_t* const lhs,
+                                     const rhs_elem_t* const rhs,
+                                     const size_t rhs_stride,
+                                     const size_t num_rhs_rows,
+                                     const size_t block_len,
+                                     zq_t* const res,
+                                     frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  if ((num_rhs_rows == 0) || (block_len == 0)) {
+    return;
+  }
+
+  const auto row_dot_products = frodoPIR_simd::get_row_dot_products_kernel<rhs_elem_t>();
+
+  // Rows of B are distributed among threads of the pool.
+  pool.parallel_for(num_rhs_rows, [&](const size_t c_idx_begin, const size_t c_idx_end) {
+    row_dot_products(lhs, rhs + c_idx_begin * rhs_stride, rhs_stride, c_idx_end - c_idx_begin, block_len, res + c_idx_begin);
+  });
+}
+
+// Blocking of matrix multiplication C += A * B, s.t. a `GEMM_KC x nr` sliver of packed B stays in L1 data cache, while being multiplied with
+// each `mr x GEMM_KC` sliver of packed A, a `GEMM_MC x GEMM_KC` block of packed A stays in L2 and a `GEMM_KC x GEMM_NC` panel of packed B in L3.
+inline constexpr size_t GEMM_MC = 96;
+inline constexpr size_t GEMM_KC = 256;
+inline constexpr size_t GEMM_NC = 1024;
+
+// Given matrices A ( of dimension `m x k` ), beginning at `lhs` s.t. consecutive rows are `lhs_stride` -many elements apart, and B ( of
+// dimension `k x n` ), beginning at `rhs` s.t. consecutive rows are `rhs_stride` -many elements apart, this routine multiplies them over Zq,
+// accumulating resulting matrix ( of dimension `m x n` ) into C, beginning at `res` s.t. consecutive rows are `res_stride` -many elements apart.
+//
+// Instead of streaming whole B once per row of A, B is walked one `GEMM_KC x GEMM_NC` panel at a time, which is packed into strips of `nr`
+// columns, widened to Zq, by all threads of the pool. Then rows of A are split into blocks among threads, each of them packing its
+// `GEMM_MC x GEMM_KC` block of A into strips of `mr` rows, before multiplying each strip of A with each strip of B, using a register blocked
+// micro-kernel. So each element of B, once fetched from DRAM, is used `m` times, from cache, and each element of A `nr` times, from registers.
+//
+// If `rhs_is_transposed`, B is rather given as its transpose ( of dimension `n x k` ), beginning at `rhs` s.t. consecutive rows of it are
+// `rhs_stride` -many elements apart, e.g. transposed parsed database matrix. It only changes how panels of B are packed.
+template<bool rhs_is_transposed = false, typename rhs_elem_t>
+forceinline void
+matrix_x_matrix(const zq_t* const lhs,
+                const size_t lhs_stride,
+                const rhs_elem_t* const rhs,
+                const size_t rhs_stride,
+                const size_t m,
+                const size_t k,
+                const size_t n,
+                zq_t* const res,
+                const size_t res_stride,
+                frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+                const frodoPIR_simd::gemm_kernel_t kernel = frodoPIR_simd::get_gemm_kernel())
+{
+  if ((m == 0) || (k == 0) || (n == 0)) {
+    return;
+  }
+
+  const size_t mr = kernel.mr;
+  const size_t nr = kernel.nr;
+
+  // Rows of A are split into at least as many blocks as there are threads, as long as each block has at least one strip.
+  const size_t row_block_len = std::clamp(((m + pool.size() - 1) / pool.size() + (mr - 1)) / mr * mr, mr, GEMM_MC / mr * mr);
+  const size_t num_row_blocks = (m + (row_block_len - 1)) / row_block_len;
+
+  const size_t max_num_col_strips = (std::min(n, GEMM_NC) + (nr - 1)) / nr;
+
+  std::vector<zq_t> A_packed(num_row_blocks * row_block_len * GEMM_KC);
+  std::vector<zq_t> B_packed(max_num_col_strips * nr * GEMM_KC);
+
+  for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+    const size_t nc = std::min(GEMM_NC, n - jc);
+    const size_t num_col_strips = (nc + (nr - 1)) / nr;
+
+    for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+      const size_t kc = std::min(GEMM_KC, k - pc);
+
+      // Pack `kc x nc` panel of B, strip by strip, padding last strip with zeros.
+      pool.parallel_for(num_col_strips, [&](const size_t s_idx_begin, const size_t s_idx_end) {
+        for (size_t s_idx = s_idx_begin; s_idx < s_idx_end; s_idx++) {
+          const size_t c_begin = jc + s_idx * nr;
+          const size_t cols_in_strip = std::min(nr, n - c_begin);
+          zq_t* const strip = B_packed.data() + s_idx * nr * kc;
+
+          if constexpr (rhs_is_transposed) {
+            // Column j of strip is a contiguous slice of row `c_begin + j` of transposed B.
+            for (size_t j = 0; j < cols_in_strip; j++) {
+              const rhs_elem_t* const rhs_row = rhs + (c_begin + j) * rhs_stride + pc;
+
+              for (size_t kk = 0; kk < kc; kk++) {
+                strip[kk * nr + j] = static_cast<zq_t>(rhs_row[kk]);
+              }
+            }
+            for (size_t kk = 0; kk < kc; kk++) {
+              std::fill_n(strip + kk * nr + cols_in_strip, nr - cols_in_strip, zq_t{});
+            }
+          } else {
+            for (size_t kk = 0; kk < kc; kk++) {
+              const rhs_elem_t* const rhs_row = rhs + (pc + kk) * rhs_stride + c_begin;
+
+              for (size_t j = 0; j < cols_in_strip; j++) {
+                strip[kk * nr + j] = static_cast<zq_t>(rhs_row[j]);
+              }
+              std::fill_n(strip + kk * nr + cols_in_strip, nr - cols_in_strip, zq_t{});
+            }
+          }
+        }
+      });
+
+      pool.parallel_for(
+        num_row_blocks,
+        [&](const size_t b_idx_begin, const size_t b_idx_end) {
+          for (size_t b_idx = b_idx_begin; b_idx < b_idx_end; b_idx++) {
+            const size_t ic = b_idx * row_block_len;
+            const size_t mc = std::min(row_block_len, m - ic);
+            const size_t num_row_strips = (mc + (mr - 1)) / mr;
+            zq_t* const A_block = A_packed.data() + b_idx * row_block_len * GEMM_KC;
+
+            // Pack `mc x kc` block of A, strip by strip, padding last strip with zeros.
+            for (size_t s_idx = 0; s_idx < num_row_strips; s_idx++) {
+              const size_t r_begin = ic + s_idx * mr;
+              const size_t rows_in_strip = std::min(mr, m - r_begin);
+              zq_t* const strip = A_block + s_idx * mr * kc;
+
+              transpose_block(lhs + r_begin * lhs_stride + pc, lhs_stride, strip, mr, rows_in_strip, kc);
+              for (size_t kk = 0; kk < kc; kk++) {
+                std::fill_n(strip + kk * mr + rows_in_strip, mr - rows_in_strip, zq_t{});
+              }
+            }
+
+            for (size_t col_s_idx = 0; col_s_idx < num_col_strips; col_s_idx++) {
+              const size_t c_begin = jc + col_s_idx * nr;
+              const size_t cols_in_strip = std::min(nr, n - c_begin);
+              const zq_t* const B_strip = B_packed.data() + col_s_idx * nr * kc;
+
+              for (size_t row_s_idx = 0; row_s_idx < num_row_strips; row_s_idx++) {
+                const size_t r_begin = ic + row_s_idx * mr;
+                const size_t rows_in_strip = std::min(mr, m - r_begin);
+                const zq_t* const A_strip = A_block + row_s_idx * mr * kc;
+
+                zq_t* const res_block = res + r_begin * res_stride + c_begin;
+
+                if ((rows_in_strip == mr) && (cols_in_strip == nr)) {
+                  kernel.fn(kc, A_strip, B_strip, res_block, res_stride);
+                  continue;
+                }
+
+                // Block at the edge of C is computed separately, so that micro-kernel never writes out of bounds.
+                std::array<zq_t, frodoPIR_simd::GEMM_MAX_MR * frodoPIR_simd::GEMM_MAX_NR> edge_block{};
+                kernel.fn(kc, A_strip, B_strip, edge_block.data(), nr);
+
+                for (size_t i = 0; i < rows_in_strip; i++) {
+                  for (size_t j = 0; j < cols_in_strip; j++) {
+                    res_block[i * res_stride + j] += edge_block[i * nr + j];
+                  }
+                }
+              }
+            }
+          }
+        },
+        1);
+    }
+  }
+}
+
+// Read-only, non-owning view of a row-major matrix of dimension `rows x cols`, whose elements live somewhere else e.g. in a `matrix_t` or in
+// a memory-mapped file. Viewed memory must outlive the view.
+template<size_t rows, size_t cols, typename elem_t = zq_t>
+  requires((rows > 0) && (cols > 0) && std::unsigned_integral<elem_t> && (sizeof(elem_t) <= sizeof(zq_t)))
+struct matrix_view_t
+{
+public:
+  constexpr matrix_view_t() = default;
+  explicit constexpr matrix_view_t(std::span<const elem_t, rows * cols> elements)
+    : elements(elements.data())
+  {
+  }
+
+  // Accessor, using {row_index, column_index} pair.
+  forceinline constexpr const elem_t& operator[](const std::pair<size_t, size_t> idx) const { return this->elements[idx.first * cols + idx.second]; }
+
+  // Accessor, returning a view of row at index `r_idx`.
+  forceinline constexpr std::span<const elem_t, cols> row(const size_t r_idx) const
+  {
+    return std::span<const elem_t, cols>(this->elements + r_idx * cols, cols);
+  }
+
+private:
+  const elem_t* elements = nullptr;
+};
+
+// Matrix of dimension `rows x cols`, s.t. each element is stored as an unsigned integer of type `elem_t`. Elements narrower than `zq_t`
+// are meant for storing matrices, whose elements have only a few significant bits (e.g. parsed database), using lesser memory. They get
+// widened to `zq_t` on the fly, when participating in arithmetic over Zq.
+template<size_t rows, size_t cols, typename elem_t = zq_t>
+  requires((rows > 0) && (cols > 0) && std::unsigned_integral<elem_t> && (sizeof(elem_t) <= sizeof(zq_t)))
+struct matrix_t
+{
+public:
+  // Storage of elements, allocated from the memory resource, set using `frodoPIR_allocator::set_matrix_resource`, when it's created.
+  using storage_t = std::vector<elem_t, frodoPIR_allocator::matrix_allocator_t<elem_t>>;
+
+  // Constructor(s)
+  forceinline constexpr matrix_t() { this->elements = storage_t(rows * cols, elem_t{}); };
+  explicit matrix_t(storage_t elements)
+    : elements(std::move(elements))
+  {
+  }
+  matrix_t(const matrix_t&) = default;
+  matrix_t(matrix_t&&) = default;
+  matrix_t& operator=(const matrix_t&) = default;
+  matrix_t& operator=(matrix_t&&) = default;
+
+  // Given a `λ` -bit seed, this routine uniform random samples a matrix of dimension `rows x cols`, expanding its rows as per `mode`. Unless
+  // it's `sequential`, rows are expanded in parallel, using threads of the pool.
+  template<size_t λ>
+    requires((std::endian::native == std::endian::little) && std::same_as<elem_t, zq_t>)
+  static forceinline matrix_t generate(std::span<const uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ,
+                                       const expansion_mode_t mode = expansion_mode_t::sequential,
+                                       frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    matrix_row_stream_t<cols, λ> row_stream(μ, mode);
+    matrix_t mat{};
 
+    row_stream.next_rows(mat.row(0).data(), rows, pool);
     return mat;
   }
 
@@ -87,44 +545,28 @@ public:
   //
   // Collects inspiration from https://github.com/brave-experiments/frodo-pir/blob/15573960/src/utils.rs#L102-L125.
   static forceinline constexpr matrix_t sample_from_uniform_ternary_distribution(csprng::csprng_t& csprng)
-    requires((rows == 1) || (cols == 1))
+    requires(((rows == 1) || (cols == 1)) && std::same_as<elem_t, zq_t>)
   {
     matrix_t mat{};
 
     constexpr size_t buffer_byte_len = (8 * turboshake256::RATE) / std::numeric_limits<uint8_t>::digits;
+    constexpr size_t buffer_num_vals = buffer_byte_len / sizeof(zq_t);
     constexpr size_t total_num_elements = rows * cols;
 
+    static_assert(buffer_byte_len % sizeof(zq_t) == 0, "Buffer must hold a whole number of uniform random values");
+
     std::array<uint8_t, buffer_byte_len> buffer{};
-    auto buffer_span = std::span(buffer);
 
-    size_t buffer_offset = 0;
-    size_t e_idx = 0;
+    // Whole buffer is rejection sampled at once, using the fastest kernel, before it's refilled, squeezing CSPRNG in same sized blocks, and
+    // only when more values are needed, so that sampled vector and state of CSPRNG, left behind, are same as sampling one value at a time
+    // does. Note, first block is the zero initialized buffer, so first values of the vector are 0, exactly as they've been sampled so far.
+    const auto kernel = frodoPIR_simd::get_sample_ternary_kernel();
+    constexpr auto interval_size = static_cast<zq_t>(TERNARY_INTERVAL_SIZE);
 
+    size_t e_idx = kernel(buffer.data(), buffer_num_vals, interval_size, mat.elements.data(), total_num_elements);
     while (e_idx < total_num_elements) {
-      zq_t val = std::numeric_limits<zq_t>::max();
-
-      while (val > TERNARY_REJECTION_SAMPLING_MAX) {
-        if ((buffer_offset + sizeof(zq_t)) > buffer_span.size()) {
-          const size_t remaining_num_random_bytes = buffer_span.size() - buffer_offset;
-
-          std::copy_n(buffer_span.last(remaining_num_random_bytes).begin(), remaining_num_random_bytes, buffer_span.begin());
-          csprng.generate(buffer_span.subspan(remaining_num_random_bytes));
-          buffer_offset = 0;
-        }
-
-        val = frodoPIR_utils::from_le_bytes<zq_t>(buffer_span.subspan(buffer_offset, sizeof(zq_t)));
-        buffer_offset += sizeof(zq_t);
-      }
-
-      zq_t ternary = 0;
-      if ((val > TERNARY_INTERVAL_SIZE) && (val <= (2 * TERNARY_INTERVAL_SIZE))) {
-        ternary = 1;
-      } else if (val > (2 * TERNARY_INTERVAL_SIZE)) {
-        ternary = std::numeric_limits<zq_t>::max();
-      }
-
-      mat[e_idx] = ternary;
-      e_idx++;
+      csprng.generate(buffer);
+      e_idx += kernel(buffer.data(), buffer_num_vals, interval_size, mat.elements.data() + e_idx, total_num_elements - e_idx);
     }
 
     return mat;
@@ -137,35 +579,48 @@ public:
     matrix_t mat{};
 
     for (size_t idx = 0; idx < rows; idx++) {
-      mat[{ idx, idx }] = zq_t(1);
+      mat[{ idx, idx }] = elem_t(1);
     }
 
     return mat;
   }
 
   // Accessor, using {row_index, column_index} pair.
-  forceinline constexpr zq_t& operator[](const std::pair<size_t, size_t> idx)
+  forceinline constexpr elem_t& operator[](const std::pair<size_t, size_t> idx)
   {
     const auto [r_idx, c_idx] = idx;
     return this->elements[r_idx * cols + c_idx];
   }
-  forceinline constexpr const zq_t& operator[](const std::pair<size_t, size_t> idx) const
+  forceinline constexpr const elem_t& operator[](const std::pair<size_t, size_t> idx) const
   {
     const auto [r_idx, c_idx] = idx;
     return this->elements[r_idx * cols + c_idx];
   }
 
   // Accessor, using linearized index.
-  forceinline constexpr zq_t& operator[](const size_t lin_idx) { return this->elements[lin_idx]; }
-  forceinline constexpr const zq_t& operator[](const size_t lin_idx) const { return this->elements[lin_idx]; }
+  forceinline constexpr elem_t& operator[](const size_t lin_idx) { return this->elements[lin_idx]; }
+  forceinline constexpr const elem_t& operator[](const size_t lin_idx) const { return this->elements[lin_idx]; }
+
+  // Accessor, returning a view of row at index `r_idx`.
+  forceinline constexpr std::span<elem_t, cols> row(const size_t r_idx) { return std::span<elem_t, cols>(this->elements.data() + r_idx * cols, cols); }
+  forceinline constexpr std::span<const elem_t, cols> row(const size_t r_idx) const
+  {
+    return std::span<const elem_t, cols>(this->elements.data() + r_idx * cols, cols);
+  }
+
+  // Returns a read-only view of this matrix, which must outlive the view.
+  forceinline constexpr matrix_view_t<rows, cols, elem_t> view() const
+  {
+    return matrix_view_t<rows, cols, elem_t>(std::span<const elem_t, rows * cols>(this->elements.data(), rows * cols));
+  }
 
   // Get byte length of serialized matrix.
-  static forceinline constexpr size_t get_byte_len() { return rows * cols * sizeof(zq_t); }
+  static forceinline constexpr size_t get_byte_len() { return rows * cols * sizeof(elem_t); }
 
   // Check equality of two equal dimension matrices, returning boolean result.
   forceinline constexpr bool operator==(const matrix_t& rhs) const
   {
-    zq_t result = 0;
+    elem_t result = 0;
 
     for (size_t r_idx = 0; r_idx < rows; r_idx++) {
       for (size_t c_idx = 0; c_idx < cols; c_idx++) {
@@ -177,172 +632,270 @@ public:
   }
 
   // Given two matrices A, B of equal dimension, this routine can be used for performing matrix addition over Zq,
-  // returning a matrix of same dimension, using multiple threads.
+  // returning a matrix of same dimension, using multiple threads of the default thread pool.
   forceinline matrix_t operator+(const matrix_t& rhs) const
+    requires(std::same_as<elem_t, zq_t>)
   {
     matrix_t res{};
 
-    constexpr size_t min_num_threads = 1;
-    const size_t hw_hinted_max_num_threads = std::thread::hardware_concurrency();
-    const size_t spawnable_num_threads = std::max(min_num_threads, hw_hinted_max_num_threads);
+    frodoPIR_thread_pool::thread_pool_t::global().parallel_for(rows * cols, [&](const size_t e_idx_begin, const size_t e_idx_end) {
+      for (size_t e_idx = e_idx_begin; e_idx < e_idx_end; e_idx++) {
+        res[e_idx] = (*this)[e_idx] + rhs[e_idx];
+      }
+    });
 
-    const size_t total_num_elements = rows * cols;
-    const size_t num_elements_per_thread = (total_num_elements + (spawnable_num_threads - 1)) / spawnable_num_threads;
+    return res;
+  }
 
-    std::vector<std::thread> threads;
-    threads.reserve(spawnable_num_threads);
+  // Given two matrices A ( of dimension rows x cols ) and B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_rows,
+  // this routine can be used for multiplying them over Zq, resulting into another matrix (C) of dimension rows x rhs_cols,
+  // using cache and register blocked `matrix_x_matrix`, on multiple threads of the default thread pool.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((cols == rhs_rows) && std::same_as<elem_t, zq_t>)
+  forceinline matrix_t<rows, rhs_cols> operator*(const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs) const
+  {
+    return this->multiply(rhs);
+  }
 
-    // Let's spawn N -number of threads s.t. each of first (N-1) of them will have equal many elements to work on,
-    // while the last one might have lesser many elements to process.
-    for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
-      const size_t e_idx_begin = t_idx * num_elements_per_thread;
-      const size_t e_idx_end = std::min(e_idx_begin + num_elements_per_thread, total_num_elements);
+  // Same as `operator*`, but using threads of given pool.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((cols == rhs_rows) && std::same_as<elem_t, zq_t>)
+  forceinline matrix_t<rows, rhs_cols> multiply(const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+                                                frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
+  {
+    matrix_t<rows, rhs_cols> res{};
+    matrix_x_matrix(this->row(0).data(), cols, rhs.row(0).data(), rhs_cols, rows, cols, rhs_cols, res.row(0).data(), rhs_cols, pool);
 
-      auto thread = std::thread([=, this, &rhs, &res]() {
-        for (size_t e_idx = e_idx_begin; e_idx < e_idx_end; e_idx++) {
-          res[e_idx] = (*this)[e_idx] + rhs[e_idx];
-        }
-      });
+    return res;
+  }
 
-      threads.push_back(std::move(thread));
-    }
+  // Given a matrix A ( of dimension rows x cols ) and a transposed matrix B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_cols, this
+  // routine multiplies A with B over Zq, resulting into matrix C of dimension rows x rhs_rows, same as `multiply` does with B itself. So a
+  // matrix, which is only kept in transposed form, needn't be transposed back, before multiplication.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  forceinline matrix_t<rows, rhs_rows> multiply_by_transposed(
+    const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
+  {
+    matrix_t<rows, rhs_rows> res{};
+    matrix_x_matrix<true>(this->row(0).data(), cols, rhs.row(0).data(), rhs_cols, rows, cols, rhs_rows, res.row(0).data(), rhs_rows, pool);
 
-    // Now we wait until all of spawned threads finish their job.
-    std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
+    return res;
+  }
+
+  // Given a matrix of dimension m x n, returns a transposed matrix of dimension n x m. Blocks of consecutive rows are distributed among
+  // threads of the pool, while each block is transposed in cache friendly micro-tiles. See `transpose_block`.
+  forceinline matrix_t<cols, rows, elem_t> transpose(frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
+  {
+    matrix_t<cols, rows, elem_t> res{};
+
+    pool.parallel_for(
+      rows,
+      [&](const size_t r_idx_begin, const size_t r_idx_end) {
+        transpose_block(this->row(r_idx_begin).data(), cols, res.row(0).data() + r_idx_begin, rows, r_idx_end - r_idx_begin, cols);
+      },
+      TRANSPOSE_ROW_BLOCK_LEN);
 
     return res;
   }
 
-  // Given two matrices A ( of dimension rows x cols ) and B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_rows,
-  // this routine can be used for multiplying them over Zq, resulting into another matrix (C) of dimension rows x rhs_cols.
+  // Given one row vector A ( of length cols ) and a transposed matrix B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_cols,
+  // this routine can be used for multiplying them over Zq, resulting into a row vector (C) of length rhs_rows. Elements of B can be of
+  // narrower unsigned type than `zq_t`, in which case they are widened before multiply-accumulate, so that B takes lesser memory bandwidth.
   //
-  // Following home-brewed matrix multiplication technique from
-  // https://lemire.me/blog/2024/06/13/rolling-your-own-fast-matrix-multiplication-loop-order-and-vectorization, while also
-  // parallelizing the outer loop using std::thread API.
-  template<size_t rhs_rows, size_t rhs_cols>
-    requires((cols == rhs_rows))
-  forceinline matrix_t<rows, rhs_cols> operator*(const matrix_t<rhs_rows, rhs_cols>& rhs) const
+  // This vector matrix multiplication collects inspiration from
+  // https://github.com/itzmeanjan/ChalametPIR/blob/7b4fcae6dfaefeffa93458dbdd48a5b408beff71/src/pir_internals/matrix.rs#L63-L77,
+  // so that server-respond function can enjoy better memory bandwidth. Dot products are computed using the fastest vector kernel, supported
+  // by the CPU, which is picked at runtime. See `frodoPIR_simd`.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  forceinline matrix_t<rows, rhs_rows> row_vector_x_transposed_matrix(
+    const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
   {
-    matrix_t<rows, rhs_cols> res{};
+    return this->row_vector_x_transposed_matrix(rhs.view(), pool);
+  }
+
+  // Same as above, but transposed matrix B is a (possibly memory-mapped) view.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  forceinline matrix_t<rows, rhs_rows> row_vector_x_transposed_matrix(
+    const matrix_view_t<rhs_rows, rhs_cols, rhs_elem_t> rhs,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
+  {
+    matrix_t<rows, rhs_rows> res{};
+    row_vector_x_transposed_matrix(this->row(0), rhs, res.row(0), pool);
 
-    constexpr size_t min_num_threads = 1;
-    const size_t hw_hinted_max_num_threads = std::thread::hardware_concurrency();
-    const size_t spawnable_num_threads = std::max(min_num_threads, hw_hinted_max_num_threads);
+    return res;
+  }
 
-    // Distribute work either row-wise or column-wise, based on which one has more work.
-    constexpr size_t distributable_work_count = std::max(rows, rhs_cols);
-    constexpr bool if_distribute_across_row = rows >= rhs_cols;
+  // Same as above, but row vector A and resulting row vector C live in caller provided buffers, e.g. right inside serialized query and
+  // response, so that no intermediate matrix is allocated. Whatever `res` holds, gets overwritten.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  static forceinline void row_vector_x_transposed_matrix(std::span<const zq_t, cols> lhs,
+                                                         const matrix_view_t<rhs_rows, rhs_cols, rhs_elem_t> rhs,
+                                                         std::span<zq_t, rhs_rows> res,
+                                                         frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    const auto row_dot_products = frodoPIR_simd::get_row_dot_products_kernel<rhs_elem_t>();
 
-    const size_t num_work_per_thread = (distributable_work_count + (spawnable_num_threads - 1)) / spawnable_num_threads;
+    // Rows of B are distributed among threads of the pool.
+    pool.parallel_for(rhs_rows, [&](const size_t c_idx_begin, const size_t c_idx_end) {
+      std::fill(res.data() + c_idx_begin, res.data() + c_idx_end, zq_t{});
+      row_dot_products(lhs.data(), rhs.row(c_idx_begin).data(), rhs_cols, c_idx_end - c_idx_begin, cols, res.data() + c_idx_begin);
+    });
+  }
 
-    std::vector<std::thread> threads;
-    threads.reserve(spawnable_num_threads);
+  // Given k -many row vectors A_i ( each of length cols ) and a transposed matrix B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_cols,
+  // this routine can be used for multiplying each of them with B over Zq, accumulating k -many row vectors C_i ( each of length rhs_rows ) into
+  // `res`. Both `lhs` and `res` must hold same number of row vectors, while `res` is expected to be zero initialized.
+  //
+  // Rather than streaming whole B once per row vector, columns of B are walked in tiles, which are small enough to stay resident in L1 data
+  // cache, while tiles of all k row vectors stay in L2. So each tile of B, once fetched from DRAM, is applied to all k row vectors, turning
+  // batched server-respond from memory bandwidth bound into compute bound, for large enough k. Within a tile, a few rows of B are multiplied
+  // with each row vector at a time, using the fastest vector kernel, supported by the CPU.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  static forceinline void row_vectors_x_transposed_matrix(std::span<const matrix_t> lhs,
+                                                          const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+                                                          std::span<matrix_t<rows, rhs_rows>> res,
+                                                          frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    row_vectors_x_transposed_matrix(lhs, rhs.view(), res, pool);
+  }
 
-    // Let's spawn N -number of threads s.t. each of first (N-1) of them will have equal many rows/ cols to work on,
-    // while the last one might have lesser many rows/ cols to process.
-    for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
-      if constexpr (if_distribute_across_row) {
-        // If there are more (or equal many) rows than columns, it's better to distribute computation of rows.
-        const size_t r_idx_begin = t_idx * num_work_per_thread;
-        const size_t r_idx_end = std::min(r_idx_begin + num_work_per_thread, distributable_work_count);
+  // Same as above, but transposed matrix B is a (possibly memory-mapped) view.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  static forceinline void row_vectors_x_transposed_matrix(std::span<const matrix_t> lhs,
+                                                          const matrix_view_t<rhs_rows, rhs_cols, rhs_elem_t> rhs,
+                                                          std::span<matrix_t<rows, rhs_rows>> res,
+                                                          frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    const size_t batch_size = std::min(lhs.size(), res.size());
 
-        auto thread = std::thread([=, this, &rhs, &res]() {
-          for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
-            for (size_t k = 0; k < cols; k++) {
-              for (size_t c_idx = 0; c_idx < rhs_cols; c_idx++) {
-                res[{ r_idx, c_idx }] += (*this)[{ r_idx, k }] * rhs[{ k, c_idx }];
-              }
-            }
-          }
-        });
-
-        threads.push_back(std::move(thread));
-      } else {
-        // If there are more columns, it's better to distribute computation of columns across threads.
-        const size_t c_idx_begin = t_idx * num_work_per_thread;
-        const size_t c_idx_end = std::min(c_idx_begin + num_work_per_thread, distributable_work_count);
-
-        auto thread = std::thread([=, this, &rhs, &res]() {
-          for (size_t r_idx = 0; r_idx < rows; r_idx++) {
-            for (size_t k = 0; k < cols; k++) {
-              for (size_t c_idx = c_idx_begin; c_idx < c_idx_end; c_idx++) {
-                res[{ r_idx, c_idx }] += (*this)[{ r_idx, k }] * rhs[{ k, c_idx }];
-              }
-            }
-          }
-        });
+    std::vector<const zq_t*> lhs_rows(batch_size);
+    std::vector<zq_t*> res_rows(batch_size);
 
-        threads.push_back(std::move(thread));
-      }
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      lhs_rows[b_idx] = lhs[b_idx].row(0).data();
+      res_rows[b_idx] = res[b_idx].row(0).data();
     }
 
-    // Now we wait until all of spawned threads finish their job.
-    std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
+    row_vectors_x_transposed_matrix(std::span<const zq_t* const>(lhs_rows), rhs, std::span<zq_t* const>(res_rows), pool);
+  }
 
-    return res;
+  // Same as above, but each of k -many row vectors A_i ( of length cols ) and C_i ( of length rhs_rows ) lives in a caller provided buffer,
+  // e.g. right inside serialized queries and responses, so that none of them is copied.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_cols) && std::same_as<elem_t, zq_t>)
+  static forceinline void row_vectors_x_transposed_matrix(std::span<const zq_t* const> lhs,
+                                                          const matrix_view_t<rhs_rows, rhs_cols, rhs_elem_t> rhs,
+                                                          std::span<zq_t* const> res,
+                                                          frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    row_vectors_x_transposed_rows(lhs, rhs.row(0).data(), rhs_rows, rhs_cols, res, pool);
   }
 
-  // Given a matrix of dimension m x n, returns a transposed matrix of dimension n x m.
-  forceinline matrix_t<cols, rows> transpose() const
+  // Given k -many row vectors A_i ( each of length cols ) and a matrix B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_rows, this
+  // routine can be used for multiplying each of them with B over Zq, accumulating k -many row vectors C_i ( each of length rhs_cols ) into
+  // `res`. Both `lhs` and `res` must hold same number of row vectors.
+  //
+  // Columns of B are walked in tiles s.t. corresponding tiles of all k row vectors of `res` stay cache resident, while each row of a tile of B,
+  // once fetched from DRAM, gets applied to all k row vectors. So B is streamed once for the whole batch, instead of once per row vector.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_rows) && std::same_as<elem_t, zq_t>)
+  static forceinline void row_vectors_x_matrix(std::span<const matrix_t> lhs,
+                                               const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+                                               std::span<matrix_t<rows, rhs_cols>> res,
+                                               frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
   {
-    matrix_t<cols, rows> res{};
+    constexpr size_t tile_width = std::min<size_t>(rhs_cols, 512);
+    const size_t batch_size = std::min(lhs.size(), res.size());
 
-    for (size_t r_idx = 0; r_idx < cols; r_idx++) {
-      for (size_t c_idx = 0; c_idx < rows; c_idx++) {
-        res[{ r_idx, c_idx }] = (*this)[{ c_idx, r_idx }];
-      }
+    if (batch_size == 0) {
+      return;
     }
 
-    return res;
+    // Columns of B are distributed among threads of the pool, in multiples of tile width.
+    pool.parallel_for(
+      rhs_cols,
+      [&](const size_t c_idx_begin, const size_t c_idx_end) {
+        for (size_t tile_begin = c_idx_begin; tile_begin < c_idx_end; tile_begin += tile_width) {
+          const size_t tile_end = std::min(tile_begin + tile_width, c_idx_end);
+
+          for (size_t k = 0; k < cols; k++) {
+            for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+              const zq_t coeff = lhs[b_idx][{ 0, k }];
+              if (coeff == 0) {
+                continue;
+              }
+
+              for (size_t c_idx = tile_begin; c_idx < tile_end; c_idx++) {
+                res[b_idx][{ 0, c_idx }] += coeff * static_cast<zq_t>(rhs[{ k, c_idx }]);
+              }
+            }
+          }
+        }
+      },
+      tile_width);
   }
 
-  // Given one row vector A ( of length cols ) and a transposed matrix B ( of dimension rhs_rows x rhs_cols ) s.t. cols == rhs_cols,
-  // this routine can be used for multiplying them over Zq, resulting into a row vector (C) of length rhs_rows.
-  //
-  // This vector matrix multiplication collects inspiration from
-  // https://github.com/itzmeanjan/ChalametPIR/blob/7b4fcae6dfaefeffa93458dbdd48a5b408beff71/src/pir_internals/matrix.rs#L63-L77,
-  // so that server-respond function can enjoy better memory bandwidth.
-  template<size_t rhs_rows, size_t rhs_cols>
-    requires((rows == 1) && (cols == rhs_cols))
-  forceinline matrix_t<rows, rhs_rows> row_vector_x_transposed_matrix(const matrix_t<rhs_rows, rhs_cols>& rhs) const
+  // Same as `row_vectors_x_matrix`, but each coefficient of each row vector A_i must be ∈ {-1, 0, +1}, encoded as {Q-1, 0, 1}, which is
+  // the case for secret vectors sampled from uniform ternary distribution χ. So rather than multiplying, each row of a tile of B gets added
+  // to (or subtracted from) corresponding tiles of those row vectors of `res`, for which matching coefficient is +1 (or -1), while zero
+  // coefficients are skipped altogether.
+  template<size_t rhs_rows, size_t rhs_cols, typename rhs_elem_t>
+    requires((rows == 1) && (cols == rhs_rows) && std::same_as<elem_t, zq_t>)
+  static forceinline void ternary_row_vectors_x_matrix(std::span<const matrix_t> lhs,
+                                                       const matrix_t<rhs_rows, rhs_cols, rhs_elem_t>& rhs,
+                                                       std::span<matrix_t<rows, rhs_cols>> res,
+                                                       frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
   {
-    matrix_t<rows, rhs_rows> res{};
+    constexpr size_t tile_width = std::min<size_t>(rhs_cols, 512);
+    const size_t batch_size = std::min(lhs.size(), res.size());
 
-    constexpr size_t min_num_threads = 1;
-    const size_t hw_hinted_max_num_threads = std::thread::hardware_concurrency();
-    const size_t spawnable_num_threads = std::max(min_num_threads, hw_hinted_max_num_threads);
+    if (batch_size == 0) {
+      return;
+    }
 
-    constexpr size_t distributable_work_count = rhs_rows;
-    const size_t num_work_per_thread = (distributable_work_count + (spawnable_num_threads - 1)) / spawnable_num_threads;
+    const ternary_index_t<cols> lhs_index(lhs.first(batch_size));
+    const auto kernel = frodoPIR_simd::get_ternary_accumulate_row_kernel<rhs_elem_t>();
 
-    std::vector<std::thread> threads;
-    threads.reserve(spawnable_num_threads);
+    std::vector<zq_t*> res_rows(batch_size);
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      res_rows[b_idx] = res[b_idx].row(0).data();
+    }
 
-    // Let's spawn N -number of threads s.t. each of first (N-1) of them will have equal many cols to work on,
-    // while the last one might have lesser many cols to process.
-    for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
-      const size_t c_idx_begin = t_idx * num_work_per_thread;
-      const size_t c_idx_end = std::min(c_idx_begin + num_work_per_thread, distributable_work_count);
+    // Columns of B are distributed among threads of the pool, in multiples of tile width.
+    pool.parallel_for(
+      rhs_cols,
+      [&](const size_t c_idx_begin, const size_t c_idx_end) {
+        for (size_t tile_begin = c_idx_begin; tile_begin < c_idx_end; tile_begin += tile_width) {
+          const size_t tile_end = std::min(tile_begin + tile_width, c_idx_end);
 
-      auto thread = std::thread([=, this, &rhs, &res]() {
-        for (size_t c_idx = c_idx_begin; c_idx < c_idx_end; c_idx++) {
           for (size_t k = 0; k < cols; k++) {
-            res[{ 0, c_idx }] += (*this)[{ 0, k }] * rhs[{ c_idx, k }];
+            const auto positives = lhs_index.positives(k);
+            const auto negatives = lhs_index.negatives(k);
+
+            kernel(rhs.row(k).data() + tile_begin,
+                   tile_end - tile_begin,
+                   res_rows.data(),
+                   tile_begin,
+                   positives.data(),
+                   positives.size(),
+                   negatives.data(),
+                   negatives.size());
           }
         }
-      });
-
-      threads.push_back(std::move(thread));
-    }
-
-    // Now we wait until all of spawned threads finish their job.
-    std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
-
-    return res;
+      },
+      tile_width);
   }
 
   // Given a matrix M of dimension `rows x cols`, this routine can be used for serializing each of its elements as
-  // four little-endian bytes and concatenating them in order to compute a byte array of length `rows * cols * 4`.
+  // `sizeof(elem_t)` little-endian bytes and concatenating them in order to compute a byte array of length `rows * cols * sizeof(elem_t)`.
   forceinline void to_le_bytes(std::span<uint8_t, matrix_t::get_byte_len()> bytes) const
     requires(std::endian::native == std::endian::little)
   {
@@ -350,8 +903,8 @@ public:
     memcpy(bytes.data(), elements_ptr, bytes.size());
   }
 
-  // Given a byte array of length `rows * cols * 4`, this routine can be used for deserializing it as a matrix of dimension
-  // `rows x cols` s.t. each matrix element is computed by interpreting four consecutive bytes in little-endian order.
+  // Given a byte array of length `rows * cols * sizeof(elem_t)`, this routine can be used for deserializing it as a matrix of dimension
+  // `rows x cols` s.t. each matrix element is computed by interpreting `sizeof(elem_t)` consecutive bytes in little-endian order.
   forceinline static matrix_t from_le_bytes(std::span<const uint8_t, matrix_t::get_byte_len()> bytes)
     requires(std::endian::native == std::endian::little)
   {
@@ -364,7 +917,75 @@ public:
   }
 
 private:
-  std::vector<zq_t> elements;
+  storage_t elements;
+};
+
+// Delta of a matrix of dimension `rows x cols`, which is known to be a product U * V of a matrix U ( of dimension `rows x rank` ) and a
+// matrix V ( of dimension `rank x cols` ), for a small `rank`, only known at runtime. It's kept and serialized in this factored form, taking
+// O((rows + cols) x rank) space, instead of O(rows x cols), as a dense delta would.
+//
+// Serialized form is `rank` as 8 little-endian bytes, followed by elements of U and then those of V, each as `sizeof(zq_t)` little-endian
+// bytes, in row-major order.
+template<size_t rows, size_t cols>
+struct low_rank_delta_t
+{
+public:
+  size_t rank = 0;
+  std::vector<zq_t> U{};
+  std::vector<zq_t> V{};
+
+  // Given `rank`, returns a zeroed delta of that rank.
+  static forceinline low_rank_delta_t zeros(const size_t rank)
+  {
+    return low_rank_delta_t{ .rank = rank, .U = std::vector<zq_t>(rows * rank), .V = std::vector<zq_t>(rank * cols) };
+  }
+
+  // Returns byte length of serialized delta of given `rank`.
+  static forceinline constexpr size_t get_byte_len(const size_t rank) { return sizeof(uint64_t) + (rows + cols) * rank * sizeof(zq_t); }
+
+  // Returns byte length of serialized form of this delta.
+  forceinline constexpr size_t get_byte_len() const { return get_byte_len(this->rank); }
+
+  // Given a matrix of dimension `rows x cols`, this routine adds this delta to it, computing U * V on threads of given pool.
+  forceinline void apply_to(matrix_t<rows, cols>& mat, frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global()) const
+  {
+    matrix_x_matrix(this->U.data(), this->rank, this->V.data(), cols, rows, this->rank, cols, mat.row(0).data(), cols, pool);
+  }
+
+  // Serializes this delta into `bytes`, which must be `get_byte_len()` -bytes long.
+  forceinline void to_le_bytes(std::span<uint8_t> bytes) const
+    requires(std::endian::native == std::endian::little)
+  {
+    frodoPIR_utils::to_le_bytes(static_cast<uint64_t>(this->rank), bytes.first(sizeof(uint64_t)));
+
+    const auto U_bytes = bytes.subspan(sizeof(uint64_t), this->U.size() * sizeof(zq_t));
+    const auto V_bytes = bytes.subspan(sizeof(uint64_t) + U_bytes.size(), this->V.size() * sizeof(zq_t));
+
+    memcpy(U_bytes.data(), this->U.data(), U_bytes.size());
+    memcpy(V_bytes.data(), this->V.data(), V_bytes.size());
+  }
+
+  // Given serialized form of a delta, this routine deserializes it. Returns nothing, if byte length doesn't match the encoded rank.
+  static forceinline std::optional<low_rank_delta_t> from_le_bytes(std::span<const uint8_t> bytes)
+    requires(std::endian::native == std::endian::little)
+  {
+    if (bytes.size() < sizeof(uint64_t)) {
+      return std::nullopt;
+    }
+
+    // Rank is checked to be small enough, before computing expected byte length, so that it can't overflow.
+    const auto rank = frodoPIR_utils::from_le_bytes<uint64_t>(bytes.first(sizeof(uint64_t)));
+    if ((rank > (bytes.size() / ((rows + cols) * sizeof(zq_t)))) || (bytes.size() != get_byte_len(rank))) {
+      return std::nullopt;
+    }
+
+    auto delta = zeros(rank);
+
+    memcpy(delta.U.data(), bytes.subspan(sizeof(uint64_t)).data(), delta.U.size() * sizeof(zq_t));
+    memcpy(delta.V.data(), bytes.subspan(sizeof(uint64_t) + delta.U.size() * sizeof(zq_t)).data(), delta.V.size() * sizeof(zq_t));
+
+    return delta;
+  }
 };
 
 }
@@ -1,195 +1,271 @@
 #pragma once
+#include "frodoPIR/internals/matrix/bit_packing.hpp"
 #include "frodoPIR/internals/matrix/matrix.hpp"
 #include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <limits>
-#include <thread>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace frodoPIR_serialization {
 
-// Given a byte serialized database s.t. it has `db_entry_count` -number of rows and each row contains `db_entry_byte_len` -bytes
-// entry, this routines parses database into a matrix s.t. each element of matrix has at max `mat_element_bitlen` significant bits.
-//
-// Note, 0 < `mat_element_bitlen` < 32.
-// Collects inspiration from https://github.com/brave-experiments/frodo-pir/blob/15573960/src/db.rs#L229-L254, while also making it multi-threaded.
+// Narrowest unsigned integer type, capable of holding an element of parsed database matrix, which has at max `mat_element_bitlen` significant bits.
+// For all recommended parameter sets, this keeps parsed database matrix at half the size of what it'd be, if each element were stored as `zq_t`.
+template<size_t mat_element_bitlen>
+using parsed_db_elem_t = std::conditional_t<(mat_element_bitlen <= std::numeric_limits<uint16_t>::digits), uint16_t, frodoPIR_matrix::zq_t>;
+
+// Parsed database matrix, having `db_entry_count` -many rows s.t. each element of it has at max `mat_element_bitlen` significant bits.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+using parsed_db_mat_t = frodoPIR_matrix::
+  matrix_t<db_entry_count, frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen), parsed_db_elem_t<mat_element_bitlen>>;
+
+// Parsed database matrix, in transposed form, having `db_entry_count` -many columns, which is how FrodoPIR server keeps it.
 template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+using parsed_db_transposed_mat_t = frodoPIR_matrix::
+  matrix_t<frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen), db_entry_count, parsed_db_elem_t<mat_element_bitlen>>;
+
+// Given a database entry, of any byte length, this routine parses it into a row of matrix s.t. each element of the row has at max
+// `mat_element_bitlen` significant bits. Row must have `get_required_num_columns(bytes.size(), mat_element_bitlen)` -many elements.
+//
+// Collects inspiration from https://github.com/brave-experiments/frodo-pir/blob/15573960/src/db.rs#L229-L254.
+template<size_t mat_element_bitlen>
   requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
-frodoPIR_matrix::matrix_t<db_entry_count, frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)>
-parse_db_bytes(std::span<const uint8_t, db_entry_count * db_entry_byte_len> bytes)
+forceinline void
+parse_db_row(std::span<const uint8_t> bytes, std::span<parsed_db_elem_t<mat_element_bitlen>> row)
 {
-  constexpr auto mat_element_mask = (1ul << mat_element_bitlen) - 1ul;
-  constexpr size_t rows = db_entry_count;
-  constexpr size_t cols = frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen);
+  using elem_t = parsed_db_elem_t<mat_element_bitlen>;
 
-  frodoPIR_matrix::matrix_t<rows, cols> mat{};
+  constexpr auto mat_element_mask = (1ul << mat_element_bitlen) - 1ul;
 
-  auto parse_db_row = [=, &bytes, &mat](const size_t r_idx) {
-    uint64_t buffer = 0;
-    size_t buf_num_bits = 0;
-    size_t c_idx = 0;
+  if constexpr (frodoPIR_bit_packing::has_group_kernels<mat_element_bitlen>) {
+    // Whole groups of 8 elements, each group spanning `mat_element_bitlen` bytes, are unpacked by the fastest kernel, leaving only the trailing
+    // bytes to be parsed bit-by-bit, below.
+    const size_t num_groups = std::min(bytes.size() / mat_element_bitlen, row.size() / frodoPIR_bit_packing::GROUP_LEN);
+    frodoPIR_bit_packing::get_unpack_groups_kernel<mat_element_bitlen>()(bytes.data(), num_groups, row.data());
 
-    size_t byte_off = r_idx * db_entry_byte_len;
-    const size_t till_byte_off = byte_off + db_entry_byte_len;
+    bytes = bytes.subspan(num_groups * mat_element_bitlen);
+    row = row.subspan(num_groups * frodoPIR_bit_packing::GROUP_LEN);
+  }
 
-    while (byte_off < till_byte_off) {
-      const size_t remaining_num_bytes = till_byte_off - byte_off;
+  const size_t db_entry_byte_len = bytes.size();
+  const size_t cols = row.size();
 
-      const size_t fillable_num_bits = std::numeric_limits<decltype(buffer)>::digits - buf_num_bits;
-      const size_t readable_num_bits = fillable_num_bits & (-std::numeric_limits<uint8_t>::digits);
-      const size_t readable_num_bytes = std::min(readable_num_bits / std::numeric_limits<uint8_t>::digits, remaining_num_bytes);
-      const size_t read_num_bits = readable_num_bytes * std::numeric_limits<uint8_t>::digits;
+  uint64_t buffer = 0;
+  size_t buf_num_bits = 0;
+  size_t c_idx = 0;
+  size_t byte_off = 0;
 
-      const auto read_word = frodoPIR_utils::from_le_bytes<uint64_t>(bytes.subspan(byte_off, readable_num_bytes));
-      byte_off += readable_num_bytes;
+  while (byte_off < db_entry_byte_len) {
+    const size_t remaining_num_bytes = db_entry_byte_len - byte_off;
 
-      buffer |= (read_word << buf_num_bits);
-      buf_num_bits += read_num_bits;
+    const size_t fillable_num_bits = std::numeric_limits<decltype(buffer)>::digits - buf_num_bits;
+    const size_t readable_num_bits = fillable_num_bits & (-std::numeric_limits<uint8_t>::digits);
+    const size_t readable_num_bytes = std::min(readable_num_bits / std::numeric_limits<uint8_t>::digits, remaining_num_bytes);
+    const size_t read_num_bits = readable_num_bytes * std::numeric_limits<uint8_t>::digits;
 
-      const size_t fillable_mat_elem_count = buf_num_bits / mat_element_bitlen;
+    const auto read_word = frodoPIR_utils::from_le_bytes<uint64_t>(bytes.subspan(byte_off, readable_num_bytes));
+    byte_off += readable_num_bytes;
 
-      for (size_t elem_idx = 0; elem_idx < fillable_mat_elem_count; elem_idx++) {
-        const auto mat_element = static_cast<frodoPIR_matrix::zq_t>(buffer & mat_element_mask);
-        mat[{ r_idx, c_idx + elem_idx }] = mat_element;
+    buffer |= (read_word << buf_num_bits);
+    buf_num_bits += read_num_bits;
 
-        buffer >>= mat_element_bitlen;
-        buf_num_bits -= mat_element_bitlen;
-      }
+    const size_t fillable_mat_elem_count = buf_num_bits / mat_element_bitlen;
 
-      c_idx += fillable_mat_elem_count;
-    }
+    for (size_t elem_idx = 0; elem_idx < fillable_mat_elem_count; elem_idx++) {
+      row[c_idx + elem_idx] = static_cast<elem_t>(buffer & mat_element_mask);
 
-    if ((buf_num_bits > 0) && (c_idx < cols)) {
-      mat[{ r_idx, c_idx }] = buffer & mat_element_mask;
+      buffer >>= mat_element_bitlen;
+      buf_num_bits -= mat_element_bitlen;
     }
-  };
-
-  constexpr size_t min_num_threads = 1;
-  const size_t hw_hinted_max_num_threads = std::thread::hardware_concurrency();
-  const size_t spawnable_num_threads = std::max(min_num_threads, hw_hinted_max_num_threads);
-
-  const size_t num_rows_per_thread = rows / spawnable_num_threads;
-  const size_t num_rows_distributed = num_rows_per_thread * spawnable_num_threads;
-  const size_t remaining_num_rows = rows - num_rows_distributed;
-
-  std::vector<std::thread> threads;
-  threads.reserve(spawnable_num_threads);
-
-  // Let's first spawn N -number of threads s.t. each of them will have equal many database rows to parse.
-  for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
-    const size_t r_idx_begin = t_idx * num_rows_per_thread;
-    const size_t r_idx_end = r_idx_begin + num_rows_per_thread;
 
-    auto thread = std::thread([=]() {
-      for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
-        parse_db_row(r_idx);
-      }
-    });
+    c_idx += fillable_mat_elem_count;
+  }
 
-    threads.push_back(std::move(thread));
+  if ((buf_num_bits > 0) && (c_idx < cols)) {
+    row[c_idx] = static_cast<elem_t>(buffer & mat_element_mask);
   }
+}
 
-  // Finally, remaining rows, if any, are parsed by "this" parent thread.
-  if (remaining_num_rows > 0) {
-    const size_t final_thread_r_idx_begin = num_rows_distributed;
-    const size_t final_thread_r_idx_end = final_thread_r_idx_begin + remaining_num_rows;
+// Same as above, but for a database entry of `db_entry_byte_len` -bytes, known at compile-time.
+template<size_t db_entry_byte_len, size_t mat_element_bitlen>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+forceinline void
+parse_db_row(std::span<const uint8_t, db_entry_byte_len> bytes,
+             std::span<parsed_db_elem_t<mat_element_bitlen>, frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)> row)
+{
+  parse_db_row<mat_element_bitlen>(std::span<const uint8_t>(bytes), std::span<parsed_db_elem_t<mat_element_bitlen>>(row));
+}
 
-    for (size_t r_idx = final_thread_r_idx_begin; r_idx < final_thread_r_idx_end; r_idx++) {
-      parse_db_row(r_idx);
-    }
-  }
+// Given a byte serialized database s.t. it has `db_entry_count` -number of rows and each row contains `db_entry_byte_len` -bytes
+// entry, this routines parses database into a matrix s.t. each element of matrix has at max `mat_element_bitlen` significant bits.
+//
+// Note, 0 < `mat_element_bitlen` < 32.
+// Collects inspiration from https://github.com/brave-experiments/frodo-pir/blob/15573960/src/db.rs#L229-L254, while also making it multi-threaded.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+parsed_db_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>
+parse_db_bytes(std::span<const uint8_t, db_entry_count * db_entry_byte_len> bytes,
+               frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  parsed_db_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen> mat{};
 
-  // Now we wait until all of spawned threads finish their job.
-  std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
+  // Database rows are distributed among threads of the pool.
+  pool.parallel_for(db_entry_count, [&](const size_t r_idx_begin, const size_t r_idx_end) {
+    for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
+      const auto row_bytes = bytes.subspan(r_idx * db_entry_byte_len).template first<db_entry_byte_len>();
+      parse_db_row<db_entry_byte_len, mat_element_bitlen>(row_bytes, mat.row(r_idx));
+    }
+  });
 
   return mat;
 }
 
-// Given a parsed database matrix as input s.t. each element of matrix has at max `mat_element_bitlen` significant bits, this routine serializes it
-// into little-endian bytes of length `db_entry_count x db_entry_byte_len`, which can be interpretted as a database having `db_entry_count` -many
-// entries s.t. each of those entries are `db_entry_byte_len` -bytes, using multiple threads.
-//
-// M = parse_db_bytes(orig_database_bytes)
-// comp_database_bytes = serialize_parsed_db_matrix(M)
-// assert(orig_database_bytes == comp_database_bytes)
-template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+// Given any number of consecutive database rows, each of `db_entry_byte_len` -bytes, this routine parses them, writing them as columns of a
+// transposed parsed database matrix, beginning at `dst` s.t. consecutive rows of the transposed matrix are `dst_stride` -many elements apart.
+// Each thread parses a block of `TRANSPOSE_ROW_BLOCK_LEN` consecutive database rows into a thread-local buffer and transposes it right into
+// its place. Number of database rows and their byte length are only known at runtime, so that it can also parse a slice of the database or
+// a database, whose shape is not known at compile-time.
+template<size_t mat_element_bitlen>
   requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
 void
-serialize_parsed_db_matrix(
-  frodoPIR_matrix::matrix_t<db_entry_count, frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)> const& db_matrix,
-  std::span<uint8_t, db_entry_count * db_entry_byte_len> bytes)
+parse_db_rows_transposed(std::span<const uint8_t> bytes,
+                         const size_t db_entry_byte_len,
+                         parsed_db_elem_t<mat_element_bitlen>* const dst,
+                         const size_t dst_stride,
+                         frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
 {
-  constexpr auto mat_element_mask = (1ul << mat_element_bitlen) - 1ul;
-  constexpr size_t rows = db_entry_count;
-  constexpr size_t cols = frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen);
-  constexpr size_t total_num_writable_bits_per_row = db_entry_byte_len * std::numeric_limits<uint8_t>::digits;
+  using elem_t = parsed_db_elem_t<mat_element_bitlen>;
+  const size_t cols = frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen);
 
-  auto serialize_parsed_db_row = [=, &db_matrix, &bytes](const size_t r_idx) {
-    uint64_t buffer = 0;
-    auto buffer_span = std::span<uint8_t, sizeof(buffer)>(reinterpret_cast<uint8_t*>(&buffer), sizeof(buffer));
+  const size_t num_rows = bytes.size() / db_entry_byte_len;
 
-    size_t buf_num_bits = 0;
-    size_t c_idx = 0;
+  // Blocks of database rows are distributed among threads of the pool.
+  pool.parallel_for(
+    num_rows,
+    [&](const size_t r_idx_begin, const size_t r_idx_end) {
+      std::vector<elem_t> row_block(frodoPIR_matrix::TRANSPOSE_ROW_BLOCK_LEN * cols);
 
-    size_t byte_off = 0;
-    const size_t row_begins_at_offset = r_idx * db_entry_byte_len;
+      for (size_t block_begin = r_idx_begin; block_begin < r_idx_end; block_begin += frodoPIR_matrix::TRANSPOSE_ROW_BLOCK_LEN) {
+        const size_t num_rows_in_block = std::min(frodoPIR_matrix::TRANSPOSE_ROW_BLOCK_LEN, r_idx_end - block_begin);
 
-    while (c_idx < cols) {
-      const size_t remaining_num_bits = total_num_writable_bits_per_row - ((byte_off * std::numeric_limits<uint8_t>::digits) + buf_num_bits);
-      const auto selected_bits = static_cast<uint64_t>(db_matrix[{ r_idx, c_idx }] & mat_element_mask);
+        for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+          const auto row_bytes = bytes.subspan((block_begin + r_idx) * db_entry_byte_len, db_entry_byte_len);
+          parse_db_row<mat_element_bitlen>(row_bytes, std::span<elem_t>(row_block.data() + r_idx * cols, cols));
+        }
 
-      buffer |= (selected_bits << buf_num_bits);
-      buf_num_bits += std::min(mat_element_bitlen, remaining_num_bits);
+        frodoPIR_matrix::transpose_block(row_block.data(), cols, dst + block_begin, dst_stride, num_rows_in_block, cols);
+      }
+    },
+    frodoPIR_matrix::TRANSPOSE_ROW_BLOCK_LEN);
+}
 
-      const size_t writable_num_bits = buf_num_bits & (-std::numeric_limits<uint8_t>::digits);
-      const size_t writable_num_bytes = writable_num_bits / std::numeric_limits<uint8_t>::digits;
+// Same as above, but for database rows of `db_entry_byte_len` -bytes, known at compile-time.
+template<size_t db_entry_byte_len, size_t mat_element_bitlen>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+void
+parse_db_rows_transposed(std::span<const uint8_t> bytes,
+                         parsed_db_elem_t<mat_element_bitlen>* const dst,
+                         const size_t dst_stride,
+                         frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  parse_db_rows_transposed<mat_element_bitlen>(bytes, db_entry_byte_len, dst, dst_stride, pool);
+}
 
-      std::copy_n(buffer_span.begin(), writable_num_bytes, bytes.subspan(row_begins_at_offset + byte_off).begin());
+// Same as `parse_db_bytes`, but returns transposed parsed database matrix, without ever materializing the parsed database matrix itself. Each
+// thread parses a block of consecutive database rows into a thread-local buffer, and transposes it right into its place in the resulting
+// matrix, while it's still cache resident, though not necessarily in L2, as it's ~933 KB for widest database rows. So, compared to parsing
+// and then transposing, it takes half the memory and a single pass over it.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+parsed_db_transposed_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>
+parse_db_bytes_transposed(std::span<const uint8_t, db_entry_count * db_entry_byte_len> bytes,
+                          frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  parsed_db_transposed_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen> mat_transposed{};
+  parse_db_rows_transposed<db_entry_byte_len, mat_element_bitlen>(bytes, mat_transposed.row(0).data(), db_entry_count, pool);
 
-      buffer >>= writable_num_bits;
-      buf_num_bits -= writable_num_bits;
+  return mat_transposed;
+}
 
-      c_idx++;
-      byte_off += writable_num_bytes;
-    }
-  };
+// Given a row of parsed database matrix s.t. each element of it, of type `elem_t`, has at max `mat_element_bitlen` significant bits, this
+// routine serializes it into little-endian bytes, which can be interpretted as a database entry of `bytes.size()` -bytes. Row must have
+// `get_required_num_columns(bytes.size(), mat_element_bitlen)` -many elements.
+template<size_t mat_element_bitlen, typename elem_t>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+forceinline constexpr void
+serialize_db_row(std::span<const elem_t> db_row, std::span<uint8_t> bytes)
+{
+  constexpr auto mat_element_mask = (1ul << mat_element_bitlen) - 1ul;
 
-  constexpr size_t min_num_threads = 1;
-  const size_t hw_hinted_max_num_threads = std::thread::hardware_concurrency();
-  const size_t spawnable_num_threads = std::max(min_num_threads, hw_hinted_max_num_threads);
+  if constexpr (frodoPIR_bit_packing::has_group_kernels<mat_element_bitlen>) {
+    if (!std::is_constant_evaluated()) {
+      // Whole groups of 8 elements are packed into `mat_element_bitlen` bytes each, by the fastest kernel, leaving only the trailing elements
+      // to be serialized bit-by-bit, below.
+      const size_t num_groups = std::min(bytes.size() / mat_element_bitlen, db_row.size() / frodoPIR_bit_packing::GROUP_LEN);
+      frodoPIR_bit_packing::get_pack_groups_kernel<mat_element_bitlen, elem_t>()(db_row.data(), num_groups, bytes.data());
 
-  const size_t num_rows_per_thread = rows / spawnable_num_threads;
-  const size_t num_rows_distributed = num_rows_per_thread * spawnable_num_threads;
-  const size_t remaining_num_rows = rows - num_rows_distributed;
+      bytes = bytes.subspan(num_groups * mat_element_bitlen);
+      db_row = db_row.subspan(num_groups * frodoPIR_bit_packing::GROUP_LEN);
+    }
+  }
 
-  std::vector<std::thread> threads;
-  threads.reserve(spawnable_num_threads);
+  const size_t cols = db_row.size();
+  const size_t total_num_writable_bits_per_row = bytes.size() * std::numeric_limits<uint8_t>::digits;
 
-  // Let's first spawn N -number of threads s.t. each of them will have equal many database rows to serialize.
-  for (size_t t_idx = 0; t_idx < spawnable_num_threads; t_idx++) {
-    const size_t r_idx_begin = t_idx * num_rows_per_thread;
-    const size_t r_idx_end = r_idx_begin + num_rows_per_thread;
+  uint64_t buffer = 0;
+  size_t buf_num_bits = 0;
+  size_t c_idx = 0;
+  size_t byte_off = 0;
 
-    auto thread = std::thread([=]() {
-      for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
-        serialize_parsed_db_row(r_idx);
-      }
-    });
+  while (c_idx < cols) {
+    const size_t remaining_num_bits = total_num_writable_bits_per_row - ((byte_off * std::numeric_limits<uint8_t>::digits) + buf_num_bits);
+    const auto selected_bits = static_cast<uint64_t>(db_row[c_idx] & mat_element_mask);
 
-    threads.push_back(std::move(thread));
-  }
+    buffer |= (selected_bits << buf_num_bits);
+    buf_num_bits += std::min(mat_element_bitlen, remaining_num_bits);
 
-  // Finally, remaining rows, if any, are serialized by "this" parent thread.
-  if (remaining_num_rows > 0) {
-    const size_t final_thread_r_idx_begin = num_rows_distributed;
-    const size_t final_thread_r_idx_end = final_thread_r_idx_begin + remaining_num_rows;
+    const size_t writable_num_bits = buf_num_bits & (-std::numeric_limits<uint8_t>::digits);
+    const size_t writable_num_bytes = writable_num_bits / std::numeric_limits<uint8_t>::digits;
 
-    for (size_t r_idx = final_thread_r_idx_begin; r_idx < final_thread_r_idx_end; r_idx++) {
-      serialize_parsed_db_row(r_idx);
+    for (size_t b_idx = 0; b_idx < writable_num_bytes; b_idx++) {
+      bytes[byte_off + b_idx] = static_cast<uint8_t>(buffer >> (b_idx * std::numeric_limits<uint8_t>::digits));
     }
+
+    buffer >>= writable_num_bits;
+    buf_num_bits -= writable_num_bits;
+
+    c_idx++;
+    byte_off += writable_num_bytes;
   }
+}
 
-  // Now we wait until all of spawned threads finish their job.
-  std::ranges::for_each(threads, [](auto& handle) { handle.join(); });
+// Given a parsed database matrix as input s.t. each element of matrix, of type `elem_t`, has at max `mat_element_bitlen` significant bits, this
+// routine serializes it into little-endian bytes of length `db_entry_count x db_entry_byte_len`, which can be interpretted as a database having
+// `db_entry_count` -many entries s.t. each of those entries are `db_entry_byte_len` -bytes, using multiple threads.
+//
+// M = parse_db_bytes(orig_database_bytes)
+// comp_database_bytes = serialize_parsed_db_matrix(M)
+// assert(orig_database_bytes == comp_database_bytes)
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen, typename elem_t>
+  requires(((0 < mat_element_bitlen) && (mat_element_bitlen < std::numeric_limits<frodoPIR_matrix::zq_t>::digits)))
+void
+serialize_parsed_db_matrix(
+  frodoPIR_matrix::matrix_t<db_entry_count, frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen), elem_t> const& db_matrix,
+  std::span<uint8_t, db_entry_count * db_entry_byte_len> bytes,
+  frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+{
+  constexpr size_t cols = frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen);
+
+  // Database rows are distributed among threads of the pool.
+  pool.parallel_for(db_entry_count, [&](const size_t r_idx_begin, const size_t r_idx_end) {
+    for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
+      serialize_db_row<mat_element_bitlen, elem_t>(std::span<const elem_t>(db_matrix.row(r_idx).data(), cols),
+                                                   bytes.subspan(r_idx * db_entry_byte_len, db_entry_byte_len));
+    }
+  });
 }
 
 // Given a row of parsed database s.t. each coefficient of input vector has at max `mat_element_bitlen` -many significant bits,
@@ -199,7 +275,7 @@ constexpr void
 serialize_db_row(frodoPIR_vector::row_vector_t<frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen)> const& db_row,
                  std::span<uint8_t, db_entry_byte_len> bytes)
 {
-  serialize_parsed_db_matrix<1, db_entry_byte_len, mat_element_bitlen>(db_row, bytes);
+  serialize_db_row<mat_element_bitlen, frodoPIR_matrix::zq_t>(db_row.row(0), bytes);
 }
 
 }
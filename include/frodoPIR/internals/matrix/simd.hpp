@@ -0,0 +1,1200 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FRODOPIR_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define FRODOPIR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Hand-written vector kernels for the server's hot loop i.e. multiplying a row vector of Zq elements with rows of a (transposed) matrix, whose
+// elements are either 16 -bit or 32 -bit unsigned integers, for computing public matrix M = A * D, during server setup, and for sampling secret
+// and error vectors, multiplying them with public matrices and decoding server response, on client. Best kernel, supported by the CPU, is
+// chosen at runtime, so that a single binary can run everywhere, while the scalar kernel serves as the portable fallback. All arithmetic is
+// over Zq, where Q = 2^32, so it's wrapping.
+namespace frodoPIR_simd {
+
+// Instruction set extensions, for which vector kernels are available.
+enum class isa_t : uint32_t
+{
+  scalar,
+  avx2,
+  avx512,
+  neon,
+};
+
+inline constexpr std::array ALL_ISAS = { isa_t::scalar, isa_t::avx2, isa_t::avx512, isa_t::neon };
+
+// Given `num_rows` -many rows of matrix B, beginning at `rhs` s.t. consecutive rows are `rhs_stride` -many elements apart, this kernel computes
+// dot product of first `len` elements of each of those rows with row vector `lhs`, adding them to `res[0 .. num_rows)`.
+template<typename rhs_elem_t>
+using row_dot_products_fn_t = void (*)(const uint32_t* lhs, const rhs_elem_t* rhs, size_t rhs_stride, size_t num_rows, size_t len, uint32_t* res);
+
+// Number of rows of B, processed together by a kernel, s.t. each loaded chunk of the row vector gets reused for all of them.
+inline constexpr size_t ROW_BLOCK_LEN = 4;
+
+// How far ahead, in bytes, rows of B are prefetched into cache, while being walked sequentially. Prefetched address is clamped to the last
+// element of the row, so that it never points past the row.
+inline constexpr size_t PREFETCH_DISTANCE = 512;
+
+// Given packed panels of A and B, s.t. for each of `kc` -many steps, `mr` -many consecutive elements of a column of A are followed by next
+// ones and so are `nr` -many consecutive elements of a row of B, this micro-kernel computes their product, of dimension `mr x nr`, adding it to
+// C, whose consecutive rows are `ldc` -many elements apart. Dimensions `mr` and `nr` are fixed by the micro-kernel, see `gemm_kernel_t`.
+using gemm_micro_kernel_fn_t = void (*)(size_t kc, const uint32_t* a, const uint32_t* b, uint32_t* c, size_t ldc);
+
+// GEMM micro-kernel, along with dimension of the block of C it computes, which is as large as it can be, while keeping all accumulators
+// in vector registers.
+struct gemm_kernel_t
+{
+  size_t mr;
+  size_t nr;
+  gemm_micro_kernel_fn_t fn;
+};
+
+// Largest block of C, computed by any GEMM micro-kernel.
+inline constexpr size_t GEMM_MAX_MR = 8;
+inline constexpr size_t GEMM_MAX_NR = 32;
+
+// Given `len` -many elements of server response c~, serialized in little-endian byte order, beginning at `c_tilda`, and as many elements of
+// vector c, kept by the client, this kernel decodes each element of the queried database row as ((c~ - c) + round_offset) >> shift, over Zq,
+// writing it to `res`. Decoded elements must fit in `res_elem_t`.
+template<typename res_elem_t>
+using decode_response_fn_t = void (*)(const uint8_t* c_tilda, const uint32_t* c, size_t len, uint32_t round_offset, uint32_t shift, res_elem_t* res);
+
+// Given `len` -many elements of a row of matrix B, beginning at `rhs`, this kernel adds them to `len` -many elements of rows `res_rows[i]`,
+// beginning at column `res_offset`, for each i in `pos_indices`, and subtracts them from those, for each i in `neg_indices`. It's the step of
+// multiplying ternary row vectors with B, for a coefficient, which is +1 for the former row vectors and -1 for the latter ones.
+template<typename rhs_elem_t>
+using ternary_accumulate_row_fn_t = void (*)(const rhs_elem_t* rhs,
+                                             size_t len,
+                                             uint32_t* const* res_rows,
+                                             size_t res_offset,
+                                             const uint32_t* pos_indices,
+                                             size_t num_pos,
+                                             const uint32_t* neg_indices,
+                                             size_t num_neg);
+
+// Given `num_vals` -many uniform random 32 -bit values, serialized in little-endian byte order, beginning at `bytes`, this kernel rejection
+// samples them, in order, from uniform ternary distribution χ, accepting values <= 3 * `interval_size` and mapping accepted ones, which fall in
+// first, second and third interval, to 0, +1 and -1, respectively. It writes at max `max_num_res` -many sampled values to `res`, stopping
+// early, if that many are sampled, and returns number of sampled values.
+using sample_ternary_fn_t = size_t (*)(const uint8_t* bytes, size_t num_vals, uint32_t interval_size, uint32_t* res, size_t max_num_res);
+
+template<typename rhs_elem_t>
+inline constexpr bool is_vectorizable_elem_t = std::is_same_v<rhs_elem_t, uint16_t> || std::is_same_v<rhs_elem_t, uint32_t>;
+
+// Portable kernel, leaving vectorization, if any, to the compiler.
+template<typename rhs_elem_t>
+inline void
+row_dot_products_scalar(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t num_rows, const size_t len, uint32_t* res)
+{
+  for (size_t r_idx = 0; r_idx < num_rows; r_idx++) {
+    const rhs_elem_t* rhs_row = rhs + r_idx * rhs_stride;
+
+    uint32_t acc = 0;
+    for (size_t k = 0; k < len; k++) {
+      acc += lhs[k] * static_cast<uint32_t>(rhs_row[k]);
+    }
+
+    res[r_idx] += acc;
+  }
+}
+
+// Portable GEMM micro-kernel, leaving vectorization to the compiler.
+template<size_t mr, size_t nr>
+inline void
+gemm_micro_kernel_scalar(const size_t kc, const uint32_t* a, const uint32_t* b, uint32_t* c, const size_t ldc)
+{
+  uint32_t acc[mr][nr]{};
+
+  for (size_t k = 0; k < kc; k++) {
+    for (size_t i = 0; i < mr; i++) {
+      for (size_t j = 0; j < nr; j++) {
+        acc[i][j] += a[k * mr + i] * b[k * nr + j];
+      }
+    }
+  }
+
+  for (size_t i = 0; i < mr; i++) {
+    for (size_t j = 0; j < nr; j++) {
+      c[i * ldc + j] += acc[i][j];
+    }
+  }
+}
+
+// Portable response decoding kernel.
+template<typename res_elem_t>
+inline void
+decode_response_scalar(const uint8_t* c_tilda, const uint32_t* c, const size_t len, const uint32_t round_offset, const uint32_t shift, res_elem_t* res)
+{
+  for (size_t idx = 0; idx < len; idx++) {
+    const uint8_t* bytes = c_tilda + idx * sizeof(uint32_t);
+    const auto c_tilda_elem = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16) |
+                              (static_cast<uint32_t>(bytes[3]) << 24);
+
+    res[idx] = static_cast<res_elem_t>((c_tilda_elem - c[idx] + round_offset) >> shift);
+  }
+}
+
+// Portable ternary accumulation kernel, leaving vectorization, if any, to the compiler.
+template<typename rhs_elem_t>
+inline void
+ternary_accumulate_row_scalar(const rhs_elem_t* rhs,
+                              const size_t len,
+                              uint32_t* const* res_rows,
+                              const size_t res_offset,
+                              const uint32_t* pos_indices,
+                              const size_t num_pos,
+                              const uint32_t* neg_indices,
+                              const size_t num_neg)
+{
+  for (size_t p_idx = 0; p_idx < num_pos; p_idx++) {
+    uint32_t* res = res_rows[pos_indices[p_idx]] + res_offset;
+    for (size_t c_idx = 0; c_idx < len; c_idx++) {
+      res[c_idx] += static_cast<uint32_t>(rhs[c_idx]);
+    }
+  }
+
+  for (size_t n_idx = 0; n_idx < num_neg; n_idx++) {
+    uint32_t* res = res_rows[neg_indices[n_idx]] + res_offset;
+    for (size_t c_idx = 0; c_idx < len; c_idx++) {
+      res[c_idx] -= static_cast<uint32_t>(rhs[c_idx]);
+    }
+  }
+}
+
+// Portable ternary sampling kernel.
+inline size_t
+sample_ternary_scalar(const uint8_t* bytes, const size_t num_vals, const uint32_t interval_size, uint32_t* res, const size_t max_num_res)
+{
+  size_t num_res = 0;
+
+  for (size_t idx = 0; (idx < num_vals) && (num_res < max_num_res); idx++) {
+    const uint8_t* val_bytes = bytes + idx * sizeof(uint32_t);
+    const auto val = static_cast<uint32_t>(val_bytes[0]) | (static_cast<uint32_t>(val_bytes[1]) << 8) | (static_cast<uint32_t>(val_bytes[2]) << 16) |
+                     (static_cast<uint32_t>(val_bytes[3]) << 24);
+
+    if (val > 3 * interval_size) {
+      continue;
+    }
+
+    res[num_res] = -static_cast<uint32_t>(val > 2 * interval_size) | static_cast<uint32_t>(val > interval_size);
+    num_res++;
+  }
+
+  return num_res;
+}
+
+#if defined(FRODOPIR_SIMD_X86)
+
+// Loads 8 consecutive elements of B, widening them to 32 -bit lanes, if needed.
+template<typename rhs_elem_t>
+__attribute__((target("avx2"))) inline __m256i
+avx2_load_rhs(const rhs_elem_t* ptr)
+{
+  if constexpr (std::is_same_v<rhs_elem_t, uint16_t>) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+  } else {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  }
+}
+
+__attribute__((target("avx2"))) inline uint32_t
+avx2_reduce_add(const __m256i vec)
+{
+  const __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(vec), _mm256_extracti128_si256(vec, 1));
+  const __m128i sum64 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+  const __m128i sum32 = _mm_add_epi32(sum64, _mm_shuffle_epi32(sum64, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(sum32));
+}
+
+// Computes dot products of row vector with a block of `num_block_rows` -many consecutive rows of B, using two independent accumulators per row.
+template<size_t num_block_rows, typename rhs_elem_t>
+__attribute__((target("avx2"))) inline void
+avx2_row_block_dot_products(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t len, uint32_t* res)
+{
+  constexpr size_t lanes = 8;
+  constexpr size_t step = 2 * lanes;
+  constexpr size_t prefetch_elems = PREFETCH_DISTANCE / sizeof(rhs_elem_t);
+
+  const size_t vec_len = len - (len % step);
+
+  const rhs_elem_t* rows[num_block_rows];
+  __m256i acc[num_block_rows][2];
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    rows[i] = rhs + i * rhs_stride;
+    acc[i][0] = _mm256_setzero_si256();
+    acc[i][1] = _mm256_setzero_si256();
+  }
+
+  for (size_t k = 0; k < vec_len; k += step) {
+    const size_t prefetch_k = std::min(k + prefetch_elems, len - 1);
+
+    const __m256i lhs0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + k));
+    const __m256i lhs1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + k + lanes));
+
+    for (size_t i = 0; i < num_block_rows; i++) {
+      _mm_prefetch(reinterpret_cast<const char*>(rows[i] + prefetch_k), _MM_HINT_T0);
+
+      acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_mullo_epi32(lhs0, avx2_load_rhs(rows[i] + k)));
+      acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_mullo_epi32(lhs1, avx2_load_rhs(rows[i] + k + lanes)));
+    }
+  }
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    uint32_t sum = avx2_reduce_add(_mm256_add_epi32(acc[i][0], acc[i][1]));
+    for (size_t k = vec_len; k < len; k++) {
+      sum += lhs[k] * static_cast<uint32_t>(rows[i][k]);
+    }
+
+    res[i] += sum;
+  }
+}
+
+// AVX2 kernel, processing rows of B in blocks.
+template<typename rhs_elem_t>
+__attribute__((target("avx2"))) inline void
+row_dot_products_avx2(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t num_rows, const size_t len, uint32_t* res)
+{
+  size_t r_idx = 0;
+  for (; r_idx + ROW_BLOCK_LEN <= num_rows; r_idx += ROW_BLOCK_LEN) {
+    avx2_row_block_dot_products<ROW_BLOCK_LEN>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+  for (; r_idx < num_rows; r_idx++) {
+    avx2_row_block_dot_products<1>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+}
+
+// AVX2 ternary accumulation kernel. Row of B is walked in chunks of two vectors, each loaded (and widened) once, and then added to (or
+// subtracted from) all result rows.
+template<typename rhs_elem_t>
+__attribute__((target("avx2"))) inline void
+ternary_accumulate_row_avx2(const rhs_elem_t* rhs,
+                            const size_t len,
+                            uint32_t* const* res_rows,
+                            const size_t res_offset,
+                            const uint32_t* pos_indices,
+                            const size_t num_pos,
+                            const uint32_t* neg_indices,
+                            const size_t num_neg)
+{
+  constexpr size_t lanes = 8;
+
+  if ((num_pos + num_neg) == 0) {
+    return;
+  }
+
+  size_t c_idx = 0;
+  for (; c_idx + 2 * lanes <= len; c_idx += 2 * lanes) {
+    const __m256i rhs_lo = avx2_load_rhs(rhs + c_idx);
+    const __m256i rhs_hi = avx2_load_rhs(rhs + c_idx + lanes);
+
+    for (size_t p_idx = 0; p_idx < num_pos; p_idx++) {
+      auto* res = reinterpret_cast<__m256i*>(res_rows[pos_indices[p_idx]] + res_offset + c_idx);
+      _mm256_storeu_si256(res, _mm256_add_epi32(_mm256_loadu_si256(res), rhs_lo));
+      _mm256_storeu_si256(res + 1, _mm256_add_epi32(_mm256_loadu_si256(res + 1), rhs_hi));
+    }
+
+    for (size_t n_idx = 0; n_idx < num_neg; n_idx++) {
+      auto* res = reinterpret_cast<__m256i*>(res_rows[neg_indices[n_idx]] + res_offset + c_idx);
+      _mm256_storeu_si256(res, _mm256_sub_epi32(_mm256_loadu_si256(res), rhs_lo));
+      _mm256_storeu_si256(res + 1, _mm256_sub_epi32(_mm256_loadu_si256(res + 1), rhs_hi));
+    }
+  }
+
+  ternary_accumulate_row_scalar<rhs_elem_t>(rhs + c_idx, len - c_idx, res_rows, res_offset + c_idx, pos_indices, num_pos, neg_indices, num_neg);
+}
+
+// AVX2 GEMM micro-kernel, computing a 6 x 16 block of C, in 12 accumulators, each holding 8 lanes of a row of the block.
+__attribute__((target("avx2"))) inline void
+gemm_micro_kernel_avx2(const size_t kc, const uint32_t* a, const uint32_t* b, uint32_t* c, const size_t ldc)
+{
+  constexpr size_t mr = 6;
+  constexpr size_t lanes = 8;
+  constexpr size_t nr = 2 * lanes;
+
+  __m256i acc[mr][2];
+  for (size_t i = 0; i < mr; i++) {
+    acc[i][0] = _mm256_setzero_si256();
+    acc[i][1] = _mm256_setzero_si256();
+  }
+
+  for (size_t k = 0; k < kc; k++) {
+    const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k * nr));
+    const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k * nr + lanes));
+
+    for (size_t i = 0; i < mr; i++) {
+      const __m256i a_i = _mm256_set1_epi32(static_cast<int>(a[k * mr + i]));
+
+      acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_mullo_epi32(a_i, b0));
+      acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_mullo_epi32(a_i, b1));
+    }
+  }
+
+  for (size_t i = 0; i < mr; i++) {
+    auto* c_row = reinterpret_cast<__m256i*>(c + i * ldc);
+    auto* c_row_hi = reinterpret_cast<__m256i*>(c + i * ldc + lanes);
+
+    _mm256_storeu_si256(c_row, _mm256_add_epi32(_mm256_loadu_si256(c_row), acc[i][0]));
+    _mm256_storeu_si256(c_row_hi, _mm256_add_epi32(_mm256_loadu_si256(c_row_hi), acc[i][1]));
+  }
+}
+
+// Decodes 8 consecutive elements of response, into 32 -bit lanes.
+__attribute__((target("avx2"))) inline __m256i
+avx2_decode_response(const uint8_t* c_tilda, const uint32_t* c, const __m256i round_offset, const __m128i shift)
+{
+  const __m256i c_tilda_elems = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c_tilda));
+  const __m256i c_elems = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c));
+
+  return _mm256_srl_epi32(_mm256_add_epi32(_mm256_sub_epi32(c_tilda_elems, c_elems), round_offset), shift);
+}
+
+// AVX2 response decoding kernel, decoding 16 elements at a time, which are narrowed down to 16 -bit, if needed.
+template<typename res_elem_t>
+__attribute__((target("avx2"))) inline void
+decode_response_avx2(const uint8_t* c_tilda, const uint32_t* c, const size_t len, const uint32_t round_offset, const uint32_t shift, res_elem_t* res)
+{
+  constexpr size_t lanes = 8;
+  constexpr size_t step = 2 * lanes;
+
+  const __m256i round_offset_v = _mm256_set1_epi32(static_cast<int>(round_offset));
+  const __m128i shift_v = _mm_cvtsi32_si128(static_cast<int>(shift));
+
+  size_t idx = 0;
+  for (; idx + step <= len; idx += step) {
+    const __m256i lo = avx2_decode_response(c_tilda + idx * sizeof(uint32_t), c + idx, round_offset_v, shift_v);
+    const __m256i hi = avx2_decode_response(c_tilda + (idx + lanes) * sizeof(uint32_t), c + idx + lanes, round_offset_v, shift_v);
+
+    if constexpr (std::is_same_v<res_elem_t, uint16_t>) {
+      // Narrowing packs 128 -bit halves separately, so 64 -bit quarters are reordered back.
+      const __m256i narrowed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0b11011000);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + idx), narrowed);
+    } else {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + idx), lo);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + idx + lanes), hi);
+    }
+  }
+
+  decode_response_scalar<res_elem_t>(c_tilda + idx * sizeof(uint32_t), c + idx, len - idx, round_offset, shift, res + idx);
+}
+
+// AVX2 ternary sampling kernel, mapping 8 values at a time, using unsigned comparisons. As rejection is very unlikely, 8 values, all of which
+// are accepted, are stored as they are, while the rare ones, having a rejected value, are left to the scalar kernel.
+__attribute__((target("avx2"))) inline size_t
+sample_ternary_avx2(const uint8_t* bytes, const size_t num_vals, const uint32_t interval_size, uint32_t* res, const size_t max_num_res)
+{
+  constexpr size_t lanes = 8;
+
+  const __m256i max_v = _mm256_set1_epi32(static_cast<int>(3 * interval_size));
+  const __m256i first_v = _mm256_set1_epi32(static_cast<int>(interval_size + 1));
+  const __m256i second_v = _mm256_set1_epi32(static_cast<int>(2 * interval_size + 1));
+  const __m256i one = _mm256_set1_epi32(1);
+
+  size_t idx = 0;
+  size_t num_res = 0;
+
+  for (; (idx + lanes <= num_vals) && (num_res + lanes <= max_num_res); idx += lanes) {
+    const __m256i vals = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + idx * sizeof(uint32_t)));
+
+    const __m256i accepted = _mm256_cmpeq_epi32(_mm256_min_epu32(vals, max_v), vals);
+    if (_mm256_movemask_ps(_mm256_castsi256_ps(accepted)) != 0xff) {
+      num_res += sample_ternary_scalar(bytes + idx * sizeof(uint32_t), lanes, interval_size, res + num_res, lanes);
+      continue;
+    }
+
+    const __m256i beyond_first = _mm256_cmpeq_epi32(_mm256_max_epu32(vals, first_v), vals);
+    const __m256i beyond_second = _mm256_cmpeq_epi32(_mm256_max_epu32(vals, second_v), vals);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + num_res), _mm256_or_si256(beyond_second, _mm256_and_si256(beyond_first, one)));
+    num_res += lanes;
+  }
+
+  return num_res + sample_ternary_scalar(bytes + idx * sizeof(uint32_t), num_vals - idx, interval_size, res + num_res, max_num_res - num_res);
+}
+
+// Loads 16 consecutive elements of B, widening them to 32 -bit lanes, if needed.
+template<typename rhs_elem_t>
+__attribute__((target("avx512f"))) inline __m512i
+avx512_load_rhs(const rhs_elem_t* ptr)
+{
+  if constexpr (std::is_same_v<rhs_elem_t, uint16_t>) {
+    // Zero-masked form of the widening conversion is used, as the unmasked one trips GCC's uninitialized variable warning.
+    return _mm512_maskz_cvtepu16_epi32(0xffff, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)));
+  } else {
+    return _mm512_loadu_si512(ptr);
+  }
+}
+
+// Horizontal sum of 16 lanes, which happens once per row of B, so it's not worth shuffling.
+__attribute__((target("avx512f"))) inline uint32_t
+avx512_reduce_add(const __m512i vec)
+{
+  alignas(64) uint32_t lanes[16];
+  _mm512_store_si512(lanes, vec);
+
+  uint32_t sum = 0;
+  for (const auto lane : lanes) {
+    sum += lane;
+  }
+
+  return sum;
+}
+
+// Computes dot products of row vector with a block of `num_block_rows` -many consecutive rows of B, using two independent accumulators per row.
+template<size_t num_block_rows, typename rhs_elem_t>
+__attribute__((target("avx512f"))) inline void
+avx512_row_block_dot_products(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t len, uint32_t* res)
+{
+  constexpr size_t lanes = 16;
+  constexpr size_t step = 2 * lanes;
+  constexpr size_t prefetch_elems = PREFETCH_DISTANCE / sizeof(rhs_elem_t);
+
+  const size_t vec_len = len - (len % step);
+
+  const rhs_elem_t* rows[num_block_rows];
+  __m512i acc[num_block_rows][2];
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    rows[i] = rhs + i * rhs_stride;
+    acc[i][0] = _mm512_setzero_si512();
+    acc[i][1] = _mm512_setzero_si512();
+  }
+
+  for (size_t k = 0; k < vec_len; k += step) {
+    const size_t prefetch_k = std::min(k + prefetch_elems, len - 1);
+
+    const __m512i lhs0 = _mm512_loadu_si512(lhs + k);
+    const __m512i lhs1 = _mm512_loadu_si512(lhs + k + lanes);
+
+    for (size_t i = 0; i < num_block_rows; i++) {
+      _mm_prefetch(reinterpret_cast<const char*>(rows[i] + prefetch_k), _MM_HINT_T0);
+
+      acc[i][0] = _mm512_add_epi32(acc[i][0], _mm512_mullo_epi32(lhs0, avx512_load_rhs(rows[i] + k)));
+      acc[i][1] = _mm512_add_epi32(acc[i][1], _mm512_mullo_epi32(lhs1, avx512_load_rhs(rows[i] + k + lanes)));
+    }
+  }
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    uint32_t sum = avx512_reduce_add(_mm512_add_epi32(acc[i][0], acc[i][1]));
+    for (size_t k = vec_len; k < len; k++) {
+      sum += lhs[k] * static_cast<uint32_t>(rows[i][k]);
+    }
+
+    res[i] += sum;
+  }
+}
+
+// AVX-512 kernel, processing rows of B in blocks.
+template<typename rhs_elem_t>
+__attribute__((target("avx512f"))) inline void
+row_dot_products_avx512(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t num_rows, const size_t len, uint32_t* res)
+{
+  size_t r_idx = 0;
+  for (; r_idx + ROW_BLOCK_LEN <= num_rows; r_idx += ROW_BLOCK_LEN) {
+    avx512_row_block_dot_products<ROW_BLOCK_LEN>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+  for (; r_idx < num_rows; r_idx++) {
+    avx512_row_block_dot_products<1>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+}
+
+// AVX-512 ternary accumulation kernel, walking row of B in chunks of two vectors, same as the AVX2 one.
+template<typename rhs_elem_t>
+__attribute__((target("avx512f"))) inline void
+ternary_accumulate_row_avx512(const rhs_elem_t* rhs,
+                              const size_t len,
+                              uint32_t* const* res_rows,
+                              const size_t res_offset,
+                              const uint32_t* pos_indices,
+                              const size_t num_pos,
+                              const uint32_t* neg_indices,
+                              const size_t num_neg)
+{
+  constexpr size_t lanes = 16;
+
+  if ((num_pos + num_neg) == 0) {
+    return;
+  }
+
+  size_t c_idx = 0;
+  for (; c_idx + 2 * lanes <= len; c_idx += 2 * lanes) {
+    const __m512i rhs_lo = avx512_load_rhs(rhs + c_idx);
+    const __m512i rhs_hi = avx512_load_rhs(rhs + c_idx + lanes);
+
+    for (size_t p_idx = 0; p_idx < num_pos; p_idx++) {
+      uint32_t* res = res_rows[pos_indices[p_idx]] + res_offset + c_idx;
+      _mm512_storeu_si512(res, _mm512_add_epi32(_mm512_loadu_si512(res), rhs_lo));
+      _mm512_storeu_si512(res + lanes, _mm512_add_epi32(_mm512_loadu_si512(res + lanes), rhs_hi));
+    }
+
+    for (size_t n_idx = 0; n_idx < num_neg; n_idx++) {
+      uint32_t* res = res_rows[neg_indices[n_idx]] + res_offset + c_idx;
+      _mm512_storeu_si512(res, _mm512_sub_epi32(_mm512_loadu_si512(res), rhs_lo));
+      _mm512_storeu_si512(res + lanes, _mm512_sub_epi32(_mm512_loadu_si512(res + lanes), rhs_hi));
+    }
+  }
+
+  ternary_accumulate_row_scalar<rhs_elem_t>(rhs + c_idx, len - c_idx, res_rows, res_offset + c_idx, pos_indices, num_pos, neg_indices, num_neg);
+}
+
+// AVX-512 GEMM micro-kernel, computing a 8 x 32 block of C, in 16 accumulators, each holding 16 lanes of a row of the block.
+__attribute__((target("avx512f"))) inline void
+gemm_micro_kernel_avx512(const size_t kc, const uint32_t* a, const uint32_t* b, uint32_t* c, const size_t ldc)
+{
+  constexpr size_t mr = 8;
+  constexpr size_t lanes = 16;
+  constexpr size_t nr = 2 * lanes;
+
+  __m512i acc[mr][2];
+  for (size_t i = 0; i < mr; i++) {
+    acc[i][0] = _mm512_setzero_si512();
+    acc[i][1] = _mm512_setzero_si512();
+  }
+
+  for (size_t k = 0; k < kc; k++) {
+    const __m512i b0 = _mm512_loadu_si512(b + k * nr);
+    const __m512i b1 = _mm512_loadu_si512(b + k * nr + lanes);
+
+    for (size_t i = 0; i < mr; i++) {
+      const __m512i a_i = _mm512_set1_epi32(static_cast<int>(a[k * mr + i]));
+
+      acc[i][0] = _mm512_add_epi32(acc[i][0], _mm512_mullo_epi32(a_i, b0));
+      acc[i][1] = _mm512_add_epi32(acc[i][1], _mm512_mullo_epi32(a_i, b1));
+    }
+  }
+
+  for (size_t i = 0; i < mr; i++) {
+    uint32_t* c_row = c + i * ldc;
+
+    _mm512_storeu_si512(c_row, _mm512_add_epi32(_mm512_loadu_si512(c_row), acc[i][0]));
+    _mm512_storeu_si512(c_row + lanes, _mm512_add_epi32(_mm512_loadu_si512(c_row + lanes), acc[i][1]));
+  }
+}
+
+// AVX-512 response decoding kernel, decoding 16 elements at a time, which are narrowed down to 16 -bit, if needed.
+template<typename res_elem_t>
+__attribute__((target("avx512f"))) inline void
+decode_response_avx512(const uint8_t* c_tilda, const uint32_t* c, const size_t len, const uint32_t round_offset, const uint32_t shift, res_elem_t* res)
+{
+  constexpr size_t lanes = 16;
+
+  const __m512i round_offset_v = _mm512_set1_epi32(static_cast<int>(round_offset));
+  const __m512i shift_v = _mm512_set1_epi32(static_cast<int>(shift));
+
+  size_t idx = 0;
+  for (; idx + lanes <= len; idx += lanes) {
+    const __m512i c_tilda_elems = _mm512_loadu_si512(c_tilda + idx * sizeof(uint32_t));
+    const __m512i c_elems = _mm512_loadu_si512(c + idx);
+    const __m512i decoded = _mm512_maskz_srlv_epi32(0xffff, _mm512_add_epi32(_mm512_sub_epi32(c_tilda_elems, c_elems), round_offset_v), shift_v);
+
+    if constexpr (std::is_same_v<res_elem_t, uint16_t>) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + idx), _mm512_maskz_cvtepi32_epi16(0xffff, decoded));
+    } else {
+      _mm512_storeu_si512(res + idx, decoded);
+    }
+  }
+
+  decode_response_scalar<res_elem_t>(c_tilda + idx * sizeof(uint32_t), c + idx, len - idx, round_offset, shift, res + idx);
+}
+
+// AVX-512 ternary sampling kernel, mapping 16 values at a time, using unsigned comparisons into masks, and compress storing accepted ones.
+__attribute__((target("avx512f"))) inline size_t
+sample_ternary_avx512(const uint8_t* bytes, const size_t num_vals, const uint32_t interval_size, uint32_t* res, const size_t max_num_res)
+{
+  constexpr size_t lanes = 16;
+
+  const __m512i max_v = _mm512_set1_epi32(static_cast<int>(3 * interval_size));
+  const __m512i first_v = _mm512_set1_epi32(static_cast<int>(interval_size));
+  const __m512i second_v = _mm512_set1_epi32(static_cast<int>(2 * interval_size));
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i minus_one = _mm512_set1_epi32(-1);
+
+  size_t idx = 0;
+  size_t num_res = 0;
+
+  for (; (idx + lanes <= num_vals) && (num_res + lanes <= max_num_res); idx += lanes) {
+    const __m512i vals = _mm512_loadu_si512(bytes + idx * sizeof(uint32_t));
+
+    const __mmask16 accepted = _mm512_cmple_epu32_mask(vals, max_v);
+    const __mmask16 beyond_first = _mm512_cmpgt_epu32_mask(vals, first_v);
+    const __mmask16 beyond_second = _mm512_cmpgt_epu32_mask(vals, second_v);
+
+    const __m512i ternary = _mm512_mask_blend_epi32(beyond_second, _mm512_maskz_mov_epi32(beyond_first, one), minus_one);
+
+    if (accepted == 0xffff) {
+      _mm512_storeu_si512(res + num_res, ternary);
+      num_res += lanes;
+    } else {
+      _mm512_mask_compressstoreu_epi32(res + num_res, accepted, ternary);
+      num_res += static_cast<size_t>(__builtin_popcount(accepted));
+    }
+  }
+
+  return num_res + sample_ternary_scalar(bytes + idx * sizeof(uint32_t), num_vals - idx, interval_size, res + num_res, max_num_res - num_res);
+}
+
+#endif
+
+#if defined(FRODOPIR_SIMD_NEON)
+
+// Loads 4 consecutive elements of B, widening them to 32 -bit lanes, if needed.
+template<typename rhs_elem_t>
+forceinline uint32x4_t
+neon_load_rhs(const rhs_elem_t* ptr)
+{
+  if constexpr (std::is_same_v<rhs_elem_t, uint16_t>) {
+    return vmovl_u16(vld1_u16(ptr));
+  } else {
+    return vld1q_u32(ptr);
+  }
+}
+
+// Computes dot products of row vector with a block of `num_block_rows` -many consecutive rows of B, using four independent accumulators per row.
+template<size_t num_block_rows, typename rhs_elem_t>
+forceinline void
+neon_row_block_dot_products(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t len, uint32_t* res)
+{
+  constexpr size_t lanes = 4;
+  constexpr size_t num_accs = 4;
+  constexpr size_t step = num_accs * lanes;
+  constexpr size_t prefetch_elems = PREFETCH_DISTANCE / sizeof(rhs_elem_t);
+
+  const size_t vec_len = len - (len % step);
+
+  const rhs_elem_t* rows[num_block_rows];
+  uint32x4_t acc[num_block_rows][num_accs];
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    rows[i] = rhs + i * rhs_stride;
+    for (size_t j = 0; j < num_accs; j++) {
+      acc[i][j] = vdupq_n_u32(0);
+    }
+  }
+
+  for (size_t k = 0; k < vec_len; k += step) {
+    const size_t prefetch_k = std::min(k + prefetch_elems, len - 1);
+
+    uint32x4_t lhs_vecs[num_accs];
+    for (size_t j = 0; j < num_accs; j++) {
+      lhs_vecs[j] = vld1q_u32(lhs + k + j * lanes);
+    }
+
+    for (size_t i = 0; i < num_block_rows; i++) {
+      __builtin_prefetch(rows[i] + prefetch_k);
+
+      for (size_t j = 0; j < num_accs; j++) {
+        acc[i][j] = vmlaq_u32(acc[i][j], lhs_vecs[j], neon_load_rhs(rows[i] + k + j * lanes));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < num_block_rows; i++) {
+    uint32_t sum = vaddvq_u32(vaddq_u32(vaddq_u32(acc[i][0], acc[i][1]), vaddq_u32(acc[i][2], acc[i][3])));
+    for (size_t k = vec_len; k < len; k++) {
+      sum += lhs[k] * static_cast<uint32_t>(rows[i][k]);
+    }
+
+    res[i] += sum;
+  }
+}
+
+// NEON kernel, processing rows of B in blocks.
+template<typename rhs_elem_t>
+inline void
+row_dot_products_neon(const uint32_t* lhs, const rhs_elem_t* rhs, const size_t rhs_stride, const size_t num_rows, const size_t len, uint32_t* res)
+{
+  size_t r_idx = 0;
+  for (; r_idx + ROW_BLOCK_LEN <= num_rows; r_idx += ROW_BLOCK_LEN) {
+    neon_row_block_dot_products<ROW_BLOCK_LEN>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+  for (; r_idx < num_rows; r_idx++) {
+    neon_row_block_dot_products<1>(lhs, rhs + r_idx * rhs_stride, rhs_stride, len, res + r_idx);
+  }
+}
+
+// NEON ternary accumulation kernel, walking row of B in chunks of two vectors, same as the AVX2 one.
+template<typename rhs_elem_t>
+inline void
+ternary_accumulate_row_neon(const rhs_elem_t* rhs,
+                            const size_t len,
+                            uint32_t* const* res_rows,
+                            const size_t res_offset,
+                            const uint32_t* pos_indices,
+                            const size_t num_pos,
+                            const uint32_t* neg_indices,
+                            const size_t num_neg)
+{
+  constexpr size_t lanes = 4;
+
+  if ((num_pos + num_neg) == 0) {
+    return;
+  }
+
+  size_t c_idx = 0;
+  for (; c_idx + 2 * lanes <= len; c_idx += 2 * lanes) {
+    const uint32x4_t rhs_lo = neon_load_rhs(rhs + c_idx);
+    const uint32x4_t rhs_hi = neon_load_rhs(rhs + c_idx + lanes);
+
+    for (size_t p_idx = 0; p_idx < num_pos; p_idx++) {
+      uint32_t* res = res_rows[pos_indices[p_idx]] + res_offset + c_idx;
+      vst1q_u32(res, vaddq_u32(vld1q_u32(res), rhs_lo));
+      vst1q_u32(res + lanes, vaddq_u32(vld1q_u32(res + lanes), rhs_hi));
+    }
+
+    for (size_t n_idx = 0; n_idx < num_neg; n_idx++) {
+      uint32_t* res = res_rows[neg_indices[n_idx]] + res_offset + c_idx;
+      vst1q_u32(res, vsubq_u32(vld1q_u32(res), rhs_lo));
+      vst1q_u32(res + lanes, vsubq_u32(vld1q_u32(res + lanes), rhs_hi));
+    }
+  }
+
+  ternary_accumulate_row_scalar<rhs_elem_t>(rhs + c_idx, len - c_idx, res_rows, res_offset + c_idx, pos_indices, num_pos, neg_indices, num_neg);
+}
+
+// NEON GEMM micro-kernel, computing a 8 x 8 block of C, in 16 accumulators, each holding 4 lanes of a row of the block.
+inline void
+gemm_micro_kernel_neon(const size_t kc, const uint32_t* a, const uint32_t* b, uint32_t* c, const size_t ldc)
+{
+  constexpr size_t mr = 8;
+  constexpr size_t lanes = 4;
+  constexpr size_t nr = 2 * lanes;
+
+  uint32x4_t acc[mr][2];
+  for (size_t i = 0; i < mr; i++) {
+    acc[i][0] = vdupq_n_u32(0);
+    acc[i][1] = vdupq_n_u32(0);
+  }
+
+  for (size_t k = 0; k < kc; k++) {
+    const uint32x4_t b0 = vld1q_u32(b + k * nr);
+    const uint32x4_t b1 = vld1q_u32(b + k * nr + lanes);
+
+    for (size_t i = 0; i < mr; i++) {
+      acc[i][0] = vmlaq_n_u32(acc[i][0], b0, a[k * mr + i]);
+      acc[i][1] = vmlaq_n_u32(acc[i][1], b1, a[k * mr + i]);
+    }
+  }
+
+  for (size_t i = 0; i < mr; i++) {
+    uint32_t* c_row = c + i * ldc;
+
+    vst1q_u32(c_row, vaddq_u32(vld1q_u32(c_row), acc[i][0]));
+    vst1q_u32(c_row + lanes, vaddq_u32(vld1q_u32(c_row + lanes), acc[i][1]));
+  }
+}
+
+// NEON response decoding kernel, decoding 4 elements at a time, which are narrowed down to 16 -bit, if needed.
+template<typename res_elem_t>
+inline void
+decode_response_neon(const uint8_t* c_tilda, const uint32_t* c, const size_t len, const uint32_t round_offset, const uint32_t shift, res_elem_t* res)
+{
+  constexpr size_t lanes = 4;
+
+  const uint32x4_t round_offset_v = vdupq_n_u32(round_offset);
+  const int32x4_t shift_v = vdupq_n_s32(-static_cast<int32_t>(shift));
+
+  size_t idx = 0;
+  for (; idx + lanes <= len; idx += lanes) {
+    const uint32x4_t c_tilda_elems = vreinterpretq_u32_u8(vld1q_u8(c_tilda + idx * sizeof(uint32_t)));
+    const uint32x4_t decoded = vshlq_u32(vaddq_u32(vsubq_u32(c_tilda_elems, vld1q_u32(c + idx)), round_offset_v), shift_v);
+
+    if constexpr (std::is_same_v<res_elem_t, uint16_t>) {
+      vst1_u16(res + idx, vmovn_u32(decoded));
+    } else {
+      vst1q_u32(res + idx, decoded);
+    }
+  }
+
+  decode_response_scalar<res_elem_t>(c_tilda + idx * sizeof(uint32_t), c + idx, len - idx, round_offset, shift, res + idx);
+}
+
+// NEON ternary sampling kernel, mapping 4 values at a time. Like the AVX2 one, it leaves 4 values, having a rejected value, to the scalar kernel.
+inline size_t
+sample_ternary_neon(const uint8_t* bytes, const size_t num_vals, const uint32_t interval_size, uint32_t* res, const size_t max_num_res)
+{
+  constexpr size_t lanes = 4;
+
+  const uint32x4_t max_v = vdupq_n_u32(3 * interval_size);
+  const uint32x4_t first_v = vdupq_n_u32(interval_size);
+  const uint32x4_t second_v = vdupq_n_u32(2 * interval_size);
+  const uint32x4_t one = vdupq_n_u32(1);
+
+  size_t idx = 0;
+  size_t num_res = 0;
+
+  for (; (idx + lanes <= num_vals) && (num_res + lanes <= max_num_res); idx += lanes) {
+    const uint32x4_t vals = vreinterpretq_u32_u8(vld1q_u8(bytes + idx * sizeof(uint32_t)));
+
+    if (vminvq_u32(vcleq_u32(vals, max_v)) == 0) {
+      num_res += sample_ternary_scalar(bytes + idx * sizeof(uint32_t), lanes, interval_size, res + num_res, lanes);
+      continue;
+    }
+
+    const uint32x4_t ternary = vorrq_u32(vcgtq_u32(vals, second_v), vandq_u32(vcgtq_u32(vals, first_v), one));
+
+    vst1q_u32(res + num_res, ternary);
+    num_res += lanes;
+  }
+
+  return num_res + sample_ternary_scalar(bytes + idx * sizeof(uint32_t), num_vals - idx, interval_size, res + num_res, max_num_res - num_res);
+}
+
+#endif
+
+// Number of rows (and columns) in a square micro-tile, transposed at once, s.t. each row of the micro-tile is 16 bytes wide, which is the
+// width of 128 -bit vector registers, available as baseline on both x86-64 (SSE2) and aarch64 (NEON).
+template<typename elem_t>
+inline constexpr size_t TRANSPOSE_TILE_DIM = 16 / sizeof(elem_t);
+
+// Given a square micro-tile of `TRANSPOSE_TILE_DIM<elem_t>` -many rows and columns, beginning at `src` s.t. consecutive rows are `src_stride`
+// -many elements apart, this routine writes its transpose, beginning at `dst` s.t. consecutive rows are `dst_stride` -many elements apart.
+// Vectorized for 16 -bit and 32 -bit elements, using baseline instructions, which is why no runtime dispatch is needed.
+template<typename elem_t>
+forceinline void
+transpose_tile(const elem_t* src, const size_t src_stride, elem_t* dst, const size_t dst_stride)
+{
+#if defined(FRODOPIR_SIMD_X86)
+  if constexpr (std::is_same_v<elem_t, uint16_t>) {
+    __m128i r[8];
+    for (size_t i = 0; i < 8; i++) {
+      r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * src_stride));
+    }
+
+    const __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+    const __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+    const __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+    const __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+    const __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+    const __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+    const __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+    const __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+    const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+    const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+    const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+    const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+    const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+    const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+    const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+    const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+    const __m128i c[8] = {
+      _mm_unpacklo_epi64(u0, u4), _mm_unpackhi_epi64(u0, u4), _mm_unpacklo_epi64(u1, u5), _mm_unpackhi_epi64(u1, u5),
+      _mm_unpacklo_epi64(u2, u6), _mm_unpackhi_epi64(u2, u6), _mm_unpacklo_epi64(u3, u7), _mm_unpackhi_epi64(u3, u7),
+    };
+
+    for (size_t i = 0; i < 8; i++) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dst_stride), c[i]);
+    }
+    return;
+  } else if constexpr (std::is_same_v<elem_t, uint32_t>) {
+    const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0 * src_stride));
+    const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1 * src_stride));
+    const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * src_stride));
+    const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * src_stride));
+
+    const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0 * dst_stride), _mm_unpacklo_epi64(t0, t2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 1 * dst_stride), _mm_unpackhi_epi64(t0, t2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * dst_stride), _mm_unpacklo_epi64(t1, t3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * dst_stride), _mm_unpackhi_epi64(t1, t3));
+    return;
+  }
+#elif defined(FRODOPIR_SIMD_NEON)
+  if constexpr (std::is_same_v<elem_t, uint16_t>) {
+    uint16x8_t r[8];
+    for (size_t i = 0; i < 8; i++) {
+      r[i] = vld1q_u16(src + i * src_stride);
+    }
+
+    const uint32x4_t t0 = vreinterpretq_u32_u16(vtrn1q_u16(r[0], r[1]));
+    const uint32x4_t t1 = vreinterpretq_u32_u16(vtrn2q_u16(r[0], r[1]));
+    const uint32x4_t t2 = vreinterpretq_u32_u16(vtrn1q_u16(r[2], r[3]));
+    const uint32x4_t t3 = vreinterpretq_u32_u16(vtrn2q_u16(r[2], r[3]));
+    const uint32x4_t t4 = vreinterpretq_u32_u16(vtrn1q_u16(r[4], r[5]));
+    const uint32x4_t t5 = vreinterpretq_u32_u16(vtrn2q_u16(r[4], r[5]));
+    const uint32x4_t t6 = vreinterpretq_u32_u16(vtrn1q_u16(r[6], r[7]));
+    const uint32x4_t t7 = vreinterpretq_u32_u16(vtrn2q_u16(r[6], r[7]));
+
+    const uint64x2_t u0 = vreinterpretq_u64_u32(vtrn1q_u32(t0, t2));
+    const uint64x2_t u1 = vreinterpretq_u64_u32(vtrn1q_u32(t1, t3));
+    const uint64x2_t u2 = vreinterpretq_u64_u32(vtrn2q_u32(t0, t2));
+    const uint64x2_t u3 = vreinterpretq_u64_u32(vtrn2q_u32(t1, t3));
+    const uint64x2_t u4 = vreinterpretq_u64_u32(vtrn1q_u32(t4, t6));
+    const uint64x2_t u5 = vreinterpretq_u64_u32(vtrn1q_u32(t5, t7));
+    const uint64x2_t u6 = vreinterpretq_u64_u32(vtrn2q_u32(t4, t6));
+    const uint64x2_t u7 = vreinterpretq_u64_u32(vtrn2q_u32(t5, t7));
+
+    const uint64x2_t c[8] = {
+      vtrn1q_u64(u0, u4), vtrn1q_u64(u1, u5), vtrn1q_u64(u2, u6), vtrn1q_u64(u3, u7),
+      vtrn2q_u64(u0, u4), vtrn2q_u64(u1, u5), vtrn2q_u64(u2, u6), vtrn2q_u64(u3, u7),
+    };
+
+    for (size_t i = 0; i < 8; i++) {
+      vst1q_u16(dst + i * dst_stride, vreinterpretq_u16_u64(c[i]));
+    }
+    return;
+  } else if constexpr (std::is_same_v<elem_t, uint32_t>) {
+    const uint32x4_t r0 = vld1q_u32(src + 0 * src_stride);
+    const uint32x4_t r1 = vld1q_u32(src + 1 * src_stride);
+    const uint32x4_t r2 = vld1q_u32(src + 2 * src_stride);
+    const uint32x4_t r3 = vld1q_u32(src + 3 * src_stride);
+
+    const uint64x2_t t0 = vreinterpretq_u64_u32(vtrn1q_u32(r0, r1));
+    const uint64x2_t t1 = vreinterpretq_u64_u32(vtrn2q_u32(r0, r1));
+    const uint64x2_t t2 = vreinterpretq_u64_u32(vtrn1q_u32(r2, r3));
+    const uint64x2_t t3 = vreinterpretq_u64_u32(vtrn2q_u32(r2, r3));
+
+    vst1q_u32(dst + 0 * dst_stride, vreinterpretq_u32_u64(vtrn1q_u64(t0, t2)));
+    vst1q_u32(dst + 1 * dst_stride, vreinterpretq_u32_u64(vtrn1q_u64(t1, t3)));
+    vst1q_u32(dst + 2 * dst_stride, vreinterpretq_u32_u64(vtrn2q_u64(t0, t2)));
+    vst1q_u32(dst + 3 * dst_stride, vreinterpretq_u32_u64(vtrn2q_u64(t1, t3)));
+    return;
+  }
+#endif
+
+  constexpr size_t tile_dim = TRANSPOSE_TILE_DIM<elem_t>;
+
+  for (size_t r_idx = 0; r_idx < tile_dim; r_idx++) {
+    for (size_t c_idx = 0; c_idx < tile_dim; c_idx++) {
+      dst[c_idx * dst_stride + r_idx] = src[r_idx * src_stride + c_idx];
+    }
+  }
+}
+
+// Returns truth value, denoting whether vector kernels, using requested instruction set extension, are compiled in and supported by this CPU.
+inline bool
+is_supported(const isa_t isa)
+{
+  switch (isa) {
+    case isa_t::scalar:
+      return true;
+#if defined(FRODOPIR_SIMD_X86)
+    case isa_t::avx2:
+      return __builtin_cpu_supports("avx2");
+    case isa_t::avx512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+    case isa_t::neon:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+// Returns human readable name of instruction set extension.
+inline constexpr std::string_view
+isa_name(const isa_t isa)
+{
+  switch (isa) {
+    case isa_t::avx2:
+      return "avx2";
+    case isa_t::avx512:
+      return "avx512";
+    case isa_t::neon:
+      return "neon";
+    default:
+      return "scalar";
+  }
+}
+
+// Returns widest instruction set extension, supported by this CPU, for which vector kernels are compiled in. It's computed once.
+inline isa_t
+best_supported_isa()
+{
+  static const isa_t best_isa = []() {
+    for (const auto isa : { isa_t::avx512, isa_t::avx2, isa_t::neon }) {
+      if (is_supported(isa)) {
+        return isa;
+      }
+    }
+
+    return isa_t::scalar;
+  }();
+
+  return best_isa;
+}
+
+// Given an instruction set extension, supported by this CPU, returns kernel for computing dot products of a row vector with rows of a matrix.
+// Falls back to the scalar kernel, if no vector kernel is available for requested instruction set extension or element type.
+template<typename rhs_elem_t>
+inline row_dot_products_fn_t<rhs_elem_t>
+get_row_dot_products_kernel(const isa_t isa)
+{
+  if constexpr (is_vectorizable_elem_t<rhs_elem_t>) {
+    switch (isa) {
+#if defined(FRODOPIR_SIMD_X86)
+      case isa_t::avx2:
+        return &row_dot_products_avx2<rhs_elem_t>;
+      case isa_t::avx512:
+        return &row_dot_products_avx512<rhs_elem_t>;
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+      case isa_t::neon:
+        return &row_dot_products_neon<rhs_elem_t>;
+#endif
+      default:
+        break;
+    }
+  }
+
+  return &row_dot_products_scalar<rhs_elem_t>;
+}
+
+// Returns fastest kernel, supported by this CPU, for computing dot products of a row vector with rows of a matrix.
+template<typename rhs_elem_t>
+forceinline row_dot_products_fn_t<rhs_elem_t>
+get_row_dot_products_kernel()
+{
+  static const auto kernel = get_row_dot_products_kernel<rhs_elem_t>(best_supported_isa());
+  return kernel;
+}
+
+// Given an instruction set extension, supported by this CPU, returns GEMM micro-kernel for it, falling back to the scalar one, if no vector
+// micro-kernel is available for requested instruction set extension.
+inline gemm_kernel_t
+get_gemm_kernel(const isa_t isa)
+{
+  switch (isa) {
+#if defined(FRODOPIR_SIMD_X86)
+    case isa_t::avx2:
+      return { .mr = 6, .nr = 16, .fn = &gemm_micro_kernel_avx2 };
+    case isa_t::avx512:
+      return { .mr = 8, .nr = 32, .fn = &gemm_micro_kernel_avx512 };
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+    case isa_t::neon:
+      return { .mr = 8, .nr = 8, .fn = &gemm_micro_kernel_neon };
+#endif
+    default:
+      return { .mr = 4, .nr = 8, .fn = &gemm_micro_kernel_scalar<4, 8> };
+  }
+}
+
+// Returns fastest GEMM micro-kernel, supported by this CPU.
+forceinline gemm_kernel_t
+get_gemm_kernel()
+{
+  static const auto kernel = get_gemm_kernel(best_supported_isa());
+  return kernel;
+}
+
+// Given an instruction set extension, supported by this CPU, returns kernel for decoding server response. Falls back to the scalar kernel, if
+// no vector kernel is available for requested instruction set extension or element type.
+template<typename res_elem_t>
+inline decode_response_fn_t<res_elem_t>
+get_decode_response_kernel(const isa_t isa)
+{
+  if constexpr (is_vectorizable_elem_t<res_elem_t>) {
+    switch (isa) {
+#if defined(FRODOPIR_SIMD_X86)
+      case isa_t::avx2:
+        return &decode_response_avx2<res_elem_t>;
+      case isa_t::avx512:
+        return &decode_response_avx512<res_elem_t>;
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+      case isa_t::neon:
+        return &decode_response_neon<res_elem_t>;
+#endif
+      default:
+        break;
+    }
+  }
+
+  return &decode_response_scalar<res_elem_t>;
+}
+
+// Returns fastest kernel, supported by this CPU, for decoding server response.
+template<typename res_elem_t>
+forceinline decode_response_fn_t<res_elem_t>
+get_decode_response_kernel()
+{
+  static const auto kernel = get_decode_response_kernel<res_elem_t>(best_supported_isa());
+  return kernel;
+}
+
+// Given an instruction set extension, supported by this CPU, returns kernel for adding (or subtracting) a row of a matrix to (or from) rows
+// of the product of ternary row vectors with that matrix. Falls back to the scalar kernel, if no vector kernel is available for requested
+// instruction set extension or element type.
+template<typename rhs_elem_t>
+inline ternary_accumulate_row_fn_t<rhs_elem_t>
+get_ternary_accumulate_row_kernel(const isa_t isa)
+{
+  if constexpr (is_vectorizable_elem_t<rhs_elem_t>) {
+    switch (isa) {
+#if defined(FRODOPIR_SIMD_X86)
+      case isa_t::avx2:
+        return &ternary_accumulate_row_avx2<rhs_elem_t>;
+      case isa_t::avx512:
+        return &ternary_accumulate_row_avx512<rhs_elem_t>;
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+      case isa_t::neon:
+        return &ternary_accumulate_row_neon<rhs_elem_t>;
+#endif
+      default:
+        break;
+    }
+  }
+
+  return &ternary_accumulate_row_scalar<rhs_elem_t>;
+}
+
+// Returns fastest kernel, supported by this CPU, for adding (or subtracting) a row of a matrix to (or from) rows of the product of ternary row
+// vectors with that matrix.
+template<typename rhs_elem_t>
+forceinline ternary_accumulate_row_fn_t<rhs_elem_t>
+get_ternary_accumulate_row_kernel()
+{
+  static const auto kernel = get_ternary_accumulate_row_kernel<rhs_elem_t>(best_supported_isa());
+  return kernel;
+}
+
+// Given an instruction set extension, supported by this CPU, returns kernel for rejection sampling from uniform ternary distribution, falling
+// back to the scalar one, if no vector kernel is available for requested instruction set extension.
+inline sample_ternary_fn_t
+get_sample_ternary_kernel(const isa_t isa)
+{
+  switch (isa) {
+#if defined(FRODOPIR_SIMD_X86)
+    case isa_t::avx2:
+      return &sample_ternary_avx2;
+    case isa_t::avx512:
+      return &sample_ternary_avx512;
+#endif
+#if defined(FRODOPIR_SIMD_NEON)
+    case isa_t::neon:
+      return &sample_ternary_neon;
+#endif
+    default:
+      return &sample_ternary_scalar;
+  }
+}
+
+// Returns fastest kernel, supported by this CPU, for rejection sampling from uniform ternary distribution.
+forceinline sample_ternary_fn_t
+get_sample_ternary_kernel()
+{
+  static const auto kernel = get_sample_ternary_kernel(best_supported_isa());
+  return kernel;
+}
+
+}
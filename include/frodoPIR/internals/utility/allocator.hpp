@@ -0,0 +1,199 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRODOPIR_HAS_MMAP 1
+#include <sys/mman.h>
+#endif
+
+namespace frodoPIR_allocator {
+
+// Alignment of storage of all matrices, so that each of them begins at a cache line boundary.
+inline constexpr size_t MATRIX_ALIGNMENT = 64;
+
+// Huge page sizes, supported by `huge_page_resource_t`.
+inline constexpr size_t HUGE_PAGE_2MIB = 2ul << 20;
+inline constexpr size_t HUGE_PAGE_1GIB = 1ul << 30;
+
+// Memory resource, handing out cache line aligned, huge page backed memory, so that sweeping over a multi-GB matrix takes a few thousand TLB
+// misses, instead of millions of them, as it does with 4KB pages. Allocations of at least 2MB are served by anonymous memory mappings, while
+// smaller ones fall back to `upstream`, not to waste a huge page on each of them.
+//
+// Mappings are first tried to be backed by pre-reserved huge pages of hugetlbfs (see /proc/sys/vm/nr_hugepages), using the largest page size,
+// not larger than the allocation and `max_page_size`. If none are reserved, it falls back to a huge page aligned mapping, kernel is advised to
+// back using transparent huge pages, which it does, unless they are disabled. Elsewhere than Linux, all allocations go to `upstream`.
+class huge_page_resource_t final : public std::pmr::memory_resource
+{
+public:
+  explicit huge_page_resource_t(const size_t max_page_size = HUGE_PAGE_2MIB, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+    : max_page_size(max_page_size)
+    , upstream(upstream)
+  {
+  }
+
+  // Process-wide resources, using up to 2MB and 1GB huge pages, respectively.
+  static forceinline huge_page_resource_t& huge_2mib()
+  {
+    static huge_page_resource_t resource(HUGE_PAGE_2MIB);
+    return resource;
+  }
+  static forceinline huge_page_resource_t& huge_1gib()
+  {
+    static huge_page_resource_t resource(HUGE_PAGE_1GIB);
+    return resource;
+  }
+
+private:
+  size_t max_page_size;
+  std::pmr::memory_resource* upstream;
+
+  // Page size, a mapping of `byte_len` bytes is backed with, or zero, if it's served by `upstream`. Depends only on byte length, so that
+  // deallocation knows, how an allocation was served.
+  forceinline size_t page_size_for([[maybe_unused]] const size_t byte_len, [[maybe_unused]] const size_t alignment) const
+  {
+#if defined(FRODOPIR_HAS_MMAP) && defined(MAP_ANONYMOUS) && defined(__linux__)
+    if ((byte_len < HUGE_PAGE_2MIB) || (alignment > HUGE_PAGE_2MIB)) {
+      return 0;
+    }
+    if ((this->max_page_size >= HUGE_PAGE_1GIB) && (byte_len >= HUGE_PAGE_1GIB)) {
+      return HUGE_PAGE_1GIB;
+    }
+    return HUGE_PAGE_2MIB;
+#else
+    return 0;
+#endif
+  }
+
+  static forceinline constexpr size_t round_up(const size_t byte_len, const size_t page_size) { return (byte_len + (page_size - 1)) & ~(page_size - 1); }
+
+  void* do_allocate(const size_t byte_len, const size_t alignment) override
+  {
+    const size_t page_size = this->page_size_for(byte_len, alignment);
+    if (page_size == 0) {
+      return this->upstream->allocate(byte_len, alignment);
+    }
+
+#if defined(FRODOPIR_HAS_MMAP) && defined(MAP_ANONYMOUS) && defined(__linux__)
+    const size_t mapping_len = round_up(byte_len, page_size);
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    // Explicit huge pages, only if some are reserved. Mapping is aligned to huge page size.
+    const int page_size_flag = static_cast<int>(std::countr_zero(page_size)) << MAP_HUGE_SHIFT;
+    void* addr = ::mmap(nullptr, mapping_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_size_flag, -1, 0);
+    if (addr != MAP_FAILED) {
+      return addr;
+    }
+#endif
+
+    // Transparent huge pages. Mapping is over-allocated by a page, so that it can be trimmed down to a huge page aligned one.
+    auto* base = static_cast<uint8_t*>(::mmap(nullptr, mapping_len + page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (base == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    const auto base_addr = reinterpret_cast<uintptr_t>(base);
+    const size_t head_len = round_up(base_addr, page_size) - base_addr;
+    auto* aligned = base + head_len;
+
+    if (head_len > 0) {
+      ::munmap(base, head_len);
+    }
+    ::munmap(aligned + mapping_len, page_size - head_len);
+
+#if defined(MADV_HUGEPAGE)
+    ::madvise(aligned, mapping_len, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+#else
+    return nullptr;
+#endif
+  }
+
+  void do_deallocate(void* const ptr, const size_t byte_len, const size_t alignment) override
+  {
+    const size_t page_size = this->page_size_for(byte_len, alignment);
+    if (page_size == 0) {
+      this->upstream->deallocate(ptr, byte_len, alignment);
+      return;
+    }
+
+#if defined(FRODOPIR_HAS_MMAP)
+    ::munmap(ptr, round_up(byte_len, page_size));
+#endif
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Memory resource, which storage of newly created matrices is allocated from, unless it's replaced using `set_matrix_resource`.
+forceinline std::pmr::memory_resource*
+default_matrix_resource()
+{
+  return std::pmr::new_delete_resource();
+}
+
+// Process-wide memory resource, storage of newly created matrices is allocated from.
+inline std::atomic<std::pmr::memory_resource*> matrix_resource{ std::pmr::new_delete_resource() };
+
+// Returns memory resource, storage of newly created matrices is allocated from.
+forceinline std::pmr::memory_resource*
+get_matrix_resource()
+{
+  return matrix_resource.load(std::memory_order_acquire);
+}
+
+// Given a memory resource, which must outlive all matrices allocated from it, this routine makes it the one, storage of matrices created from
+// now on, is allocated from, returning previous one. Existing matrices keep using the resource, they were allocated from.
+forceinline std::pmr::memory_resource*
+set_matrix_resource(std::pmr::memory_resource* const resource)
+{
+  return matrix_resource.exchange(resource, std::memory_order_acq_rel);
+}
+
+// Allocator of storage of matrices, handing out `MATRIX_ALIGNMENT` -byte aligned memory from a memory resource, captured at construction.
+// A matrix, copied from another one, is allocated from same resource as the source, so it can be freed by that resource, while a default
+// constructed matrix uses whichever resource is set at that time.
+template<typename T>
+struct matrix_allocator_t
+{
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  std::pmr::memory_resource* resource = get_matrix_resource();
+
+  matrix_allocator_t() noexcept = default;
+  explicit matrix_allocator_t(std::pmr::memory_resource* const resource) noexcept
+    : resource(resource)
+  {
+  }
+  template<typename U>
+  matrix_allocator_t(const matrix_allocator_t<U>& other) noexcept
+    : resource(other.resource)
+  {
+  }
+
+  forceinline T* allocate(const size_t n)
+  {
+    return static_cast<T*>(this->resource->allocate(n * sizeof(T), std::max(MATRIX_ALIGNMENT, alignof(T))));
+  }
+  forceinline void deallocate(T* const ptr, const size_t n) { this->resource->deallocate(ptr, n * sizeof(T), std::max(MATRIX_ALIGNMENT, alignof(T))); }
+
+  template<typename U>
+  friend forceinline bool operator==(const matrix_allocator_t& lhs, const matrix_allocator_t<U>& rhs) noexcept
+  {
+    return lhs.resource->is_equal(*rhs.resource);
+  }
+};
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRODOPIR_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace frodoPIR_mmap {
+
+// Read-only, shared memory mapping of a whole file. As mapping is shared, all processes mapping same file share one copy of it in page cache.
+class mapped_file_t
+{
+public:
+  // Given path to a file, this routine maps all of it, returning a handle to the mapping, or nullptr, if file can't be opened or mapped or is
+  // empty. If `populate` is set, page tables are populated (i.e. file is read into page cache) eagerly, instead of taking page faults later.
+  // If `huge_pages` is set, kernel is advised to back the mapping using transparent huge pages, which it may or may not honour, depending on
+  // the filesystem. Both are only supported on Linux, elsewhere they are ignored.
+  static forceinline std::shared_ptr<const mapped_file_t> open([[maybe_unused]] const std::filesystem::path& path,
+                                                               [[maybe_unused]] const bool populate = false,
+                                                               [[maybe_unused]] const bool huge_pages = false)
+  {
+#if defined(FRODOPIR_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat file_stat{};
+    if ((::fstat(fd, &file_stat) != 0) || (file_stat.st_size <= 0)) {
+      ::close(fd);
+      return nullptr;
+    }
+
+    const auto byte_len = static_cast<size_t>(file_stat.st_size);
+
+    int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+    if (populate) {
+      flags |= MAP_POPULATE;
+    }
+#endif
+
+    void* addr = ::mmap(nullptr, byte_len, PROT_READ, flags, fd, 0);
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+      return nullptr;
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (huge_pages) {
+      ::madvise(addr, byte_len, MADV_HUGEPAGE);
+    }
+#endif
+
+    return std::shared_ptr<const mapped_file_t>(new mapped_file_t(addr, byte_len));
+#else
+    return nullptr;
+#endif
+  }
+
+  mapped_file_t(const mapped_file_t&) = delete;
+  mapped_file_t(mapped_file_t&&) = delete;
+  mapped_file_t& operator=(const mapped_file_t&) = delete;
+  mapped_file_t& operator=(mapped_file_t&&) = delete;
+
+  ~mapped_file_t()
+  {
+#if defined(FRODOPIR_HAS_MMAP)
+    ::munmap(this->addr, this->byte_len);
+#endif
+  }
+
+  // Returns mapped bytes of the file.
+  forceinline std::span<const uint8_t> bytes() const { return std::span<const uint8_t>(static_cast<const uint8_t*>(this->addr), this->byte_len); }
+
+private:
+  void* addr = nullptr;
+  size_t byte_len = 0;
+
+  mapped_file_t(void* addr, const size_t byte_len)
+    : addr(addr)
+    , byte_len(byte_len)
+  {
+  }
+};
+
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+// Define `FRODOPIR_USE_LIBNUMA` and link with `-lnuma`, for strictly binding memory to NUMA nodes, using libnuma. Otherwise memory is placed
+// on a NUMA node by first touching it from a thread pinned to that node, which Linux honours by default, needing no extra dependency.
+#if defined(FRODOPIR_USE_LIBNUMA)
+#include <numa.h>
+#endif
+
+namespace frodoPIR_numa {
+
+// A NUMA node, along with ids of CPUs, belonging to it, on which the calling process is allowed to run.
+struct node_t
+{
+  size_t id = 0;
+  std::vector<size_t> cpu_ids{};
+};
+
+// Given a Linux CPU list string e.g. "0-3,8,10-11", this routine parses it into CPU ids, returning them in ascending order. Malformed ranges
+// are skipped.
+forceinline std::vector<size_t>
+parse_cpu_list(const std::string& cpu_list)
+{
+  std::vector<size_t> cpu_ids;
+
+  size_t pos = 0;
+  while (pos < cpu_list.size()) {
+    const size_t comma = std::min(cpu_list.find(',', pos), cpu_list.size());
+    const std::string range = cpu_list.substr(pos, comma - pos);
+    pos = comma + 1;
+
+    try {
+      const size_t dash = range.find('-');
+      const size_t first = std::stoul(range.substr(0, dash));
+      const size_t last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+
+      for (size_t cpu_id = first; cpu_id <= last; cpu_id++) {
+        cpu_ids.push_back(cpu_id);
+      }
+    } catch (...) {
+      continue;
+    }
+  }
+
+  std::ranges::sort(cpu_ids);
+  return cpu_ids;
+}
+
+// Returns NUMA nodes of this machine, which have at least one CPU, the calling process is allowed to run on, in ascending order of node id.
+// Topology is read from libnuma, if enabled, otherwise from sysfs. Where neither is available, or the machine has a single node, a single node
+// is returned, without any CPU id, meaning threads working on it need not be pinned.
+forceinline std::vector<node_t>
+get_nodes()
+{
+  std::vector<node_t> nodes;
+
+#if defined(__linux__)
+  cpu_set_t allowed_cpus;
+  CPU_ZERO(&allowed_cpus);
+  const bool has_affinity = ::sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) == 0;
+
+  const auto is_allowed = [&](const size_t cpu_id) { return !has_affinity || ((cpu_id < CPU_SETSIZE) && CPU_ISSET(cpu_id, &allowed_cpus)); };
+
+#if defined(FRODOPIR_USE_LIBNUMA)
+  if (::numa_available() >= 0) {
+    const int num_cpus = ::numa_num_configured_cpus();
+
+    for (int node_id = 0; node_id <= ::numa_max_node(); node_id++) {
+      node_t node{ .id = static_cast<size_t>(node_id) };
+
+      for (int cpu_id = 0; cpu_id < num_cpus; cpu_id++) {
+        if ((::numa_node_of_cpu(cpu_id) == node_id) && is_allowed(static_cast<size_t>(cpu_id))) {
+          node.cpu_ids.push_back(static_cast<size_t>(cpu_id));
+        }
+      }
+
+      if (!node.cpu_ids.empty()) {
+        nodes.push_back(std::move(node));
+      }
+    }
+  }
+#else
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const auto name = entry.path().filename().string();
+    if (!name.starts_with("node") || (name.size() == 4) || !std::ranges::all_of(name.substr(4), [](const char ch) { return (ch >= '0') && (ch <= '9'); })) {
+      continue;
+    }
+
+    std::ifstream cpu_list_file(entry.path() / "cpulist");
+    std::string cpu_list;
+    if (!std::getline(cpu_list_file, cpu_list)) {
+      continue;
+    }
+
+    node_t node{ .id = std::stoul(name.substr(4)) };
+    std::ranges::copy_if(parse_cpu_list(cpu_list), std::back_inserter(node.cpu_ids), is_allowed);
+
+    if (!node.cpu_ids.empty()) {
+      nodes.push_back(std::move(node));
+    }
+  }
+
+  std::ranges::sort(nodes, {}, &node_t::id);
+#endif
+#endif
+
+  if (nodes.size() <= 1) {
+    return { node_t{} };
+  }
+
+  return nodes;
+}
+
+// Owning, uninitialized buffer, meant to be placed on a NUMA node. With libnuma, its pages are bound to the node, while they are
+// allocated. Otherwise pages are allocated lazily, so that each one lands on the node of the thread, which first writes to it. So the buffer
+// must be initialized by threads, pinned to the node, it's meant for.
+class node_buffer_t
+{
+public:
+  node_buffer_t() = default;
+
+  // Given a NUMA node id and byte length, this routine allocates a buffer, returning an empty one, if byte length is zero or allocation fails.
+  static forceinline node_buffer_t allocate([[maybe_unused]] const size_t node_id, const size_t byte_len)
+  {
+    if (byte_len == 0) {
+      return node_buffer_t{};
+    }
+
+#if defined(FRODOPIR_USE_LIBNUMA)
+    if (::numa_available() >= 0) {
+      void* addr = ::numa_alloc_onnode(byte_len, static_cast<int>(node_id));
+      return (addr == nullptr) ? node_buffer_t{} : node_buffer_t(static_cast<uint8_t*>(addr), byte_len, kind_t::libnuma);
+    }
+#endif
+
+#if defined(MAP_ANONYMOUS)
+    void* addr = ::mmap(nullptr, byte_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (addr == MAP_FAILED) ? node_buffer_t{} : node_buffer_t(static_cast<uint8_t*>(addr), byte_len, kind_t::mmap);
+#else
+    return node_buffer_t(std::make_unique_for_overwrite<uint8_t[]>(byte_len).release(), byte_len, kind_t::heap);
+#endif
+  }
+
+  node_buffer_t(const node_buffer_t&) = delete;
+  node_buffer_t& operator=(const node_buffer_t&) = delete;
+
+  node_buffer_t(node_buffer_t&& other) noexcept
+    : ptr(std::exchange(other.ptr, nullptr))
+    , byte_len(std::exchange(other.byte_len, 0))
+    , kind(other.kind)
+  {
+  }
+  node_buffer_t& operator=(node_buffer_t&& other) noexcept
+  {
+    if (this != &other) {
+      this->release();
+      this->ptr = std::exchange(other.ptr, nullptr);
+      this->byte_len = std::exchange(other.byte_len, 0);
+      this->kind = other.kind;
+    }
+    return *this;
+  }
+
+  ~node_buffer_t() { this->release(); }
+
+  forceinline uint8_t* data() const { return this->ptr; }
+  forceinline size_t size() const { return this->byte_len; }
+
+private:
+  enum class kind_t : uint8_t
+  {
+    heap,
+    mmap,
+    libnuma,
+  };
+
+  uint8_t* ptr = nullptr;
+  size_t byte_len = 0;
+  kind_t kind = kind_t::heap;
+
+  node_buffer_t(uint8_t* const ptr, const size_t byte_len, const kind_t kind)
+    : ptr(ptr)
+    , byte_len(byte_len)
+    , kind(kind)
+  {
+  }
+
+  forceinline void release()
+  {
+    if (this->ptr == nullptr) {
+      return;
+    }
+
+    switch (this->kind) {
+#if defined(FRODOPIR_USE_LIBNUMA)
+      case kind_t::libnuma:
+        ::numa_free(this->ptr, this->byte_len);
+        break;
+#endif
+#if defined(MAP_ANONYMOUS)
+      case kind_t::mmap:
+        ::munmap(this->ptr, this->byte_len);
+        break;
+#endif
+      default:
+        delete[] this->ptr;
+        break;
+    }
+
+    this->ptr = nullptr;
+    this->byte_len = 0;
+  }
+};
+
+}
@@ -24,16 +24,16 @@ ct_sqrt(const size_t x)
   return ct_sqrt_helper(x, 0, (x / 2ul) + 1ul);
 }
 
-// Compile-time check, if chosen parameters for instantiating FrodoPIR, is correct, following Eq. 8 in section 5.1 of https://ia.cr/2022/981.
-consteval bool
+// Compile-time executable check, if chosen parameters for instantiating FrodoPIR, is correct, following Eq. 8 in section 5.1 of https://ia.cr/2022/981.
+constexpr bool
 check_frodoPIR_param_correctness(const size_t db_entry_count, const size_t mat_element_bitlen)
 {
   const auto ρ = 1ul << mat_element_bitlen;
   return frodoPIR_matrix::Q >= ((8 * ρ * ρ) * ct_sqrt(db_entry_count));
 }
 
-// Compile-time check, if instantiated FrodoPIR uses one of recommended parameters in table 5 of https://ia.cr/2022/981.
-consteval bool
+// Compile-time executable check, if instantiated FrodoPIR uses one of recommended parameters in table 5 of https://ia.cr/2022/981.
+constexpr bool
 check_frodoPIR_params(const size_t db_entry_count, const size_t mat_element_bitlen)
 {
   return check_frodoPIR_param_correctness(db_entry_count, mat_element_bitlen) && // First check if Eq. 8 of https://ia.cr/2022/981 holds
@@ -45,4 +45,12 @@ check_frodoPIR_params(const size_t db_entry_count, const size_t mat_element_bitl
          );
 }
 
+// Compile-time executable function, returning bit length of each parsed database matrix element, recommended in table 5 of
+// https://ia.cr/2022/981, for a database having `db_entry_count` -many rows, which must be one of those, accepted by `check_frodoPIR_params`.
+constexpr size_t
+get_recommended_mat_element_bitlen(const size_t db_entry_count)
+{
+  return (db_entry_count <= (1ul << 18)) ? 10 : 9;
+}
+
 }
@@ -0,0 +1,292 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include "frodoPIR/internals/utility/mmap.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(FRODOPIR_HAS_MMAP)
+#include <cstdlib>
+#endif
+
+namespace frodoPIR_slab {
+
+// Allocator of fixed-size slots, carved out of slabs, each holding `slots_per_slab` -many slots, up to a budget of `max_num_slots` -many slots.
+// Slabs live either on heap or, when a spill directory is given, in shared memory mappings of an unlinked temporary file, in that directory,
+// so that kernel can write cold slots back to disk under memory pressure, instead of keeping all of them resident. Slabs are only unmapped,
+// when the allocator is destroyed, so address of a slot never moves, but whole pages of a released slot are handed back to the OS, right
+// away, so a released slot costs no memory, but for the partial pages at its ends. Content of a slot is unspecified, when it's allocated.
+// Allocating and releasing slots is thread-safe, while writing to or reading from a slot is left to its owner.
+class slab_allocator_t
+{
+public:
+  static constexpr size_t PAGE_BYTE_LEN = 4096;
+  static constexpr size_t SLOT_ALIGNMENT = 64;
+
+  // Given byte length of each slot, number of slots per slab, maximum number of slots and optionally a spill directory, this routine creates
+  // a slab allocator, without allocating any slab yet. Returns nullptr, if spill directory is given, but a temporary file can't be created in
+  // it or memory mapping files is not supported on this platform.
+  static forceinline std::unique_ptr<slab_allocator_t> create(const size_t slot_byte_len,
+                                                              const size_t slots_per_slab,
+                                                              const size_t max_num_slots = std::numeric_limits<size_t>::max(),
+                                                              std::optional<std::filesystem::path> spill_directory = std::nullopt)
+  {
+    if ((slot_byte_len == 0) || (slots_per_slab == 0)) {
+      return nullptr;
+    }
+
+    int fd = -1;
+    if (spill_directory.has_value()) {
+#if defined(FRODOPIR_HAS_MMAP)
+      auto path_template = (*spill_directory / "frodoPIR-slab-XXXXXX").string();
+
+      fd = ::mkstemp(path_template.data());
+      if (fd < 0) {
+        return nullptr;
+      }
+
+      // Only the open file descriptor keeps the file alive, so it's gone with this process, even if it doesn't exit cleanly.
+      ::unlink(path_template.c_str());
+#else
+      return nullptr;
+#endif
+    }
+
+    return std::unique_ptr<slab_allocator_t>(new slab_allocator_t(slot_byte_len, slots_per_slab, max_num_slots, std::move(spill_directory), fd));
+  }
+
+  // Creates a slab allocator, with same configuration as this one, but without any allocated slot. Falls back to heap backed slabs, in case
+  // a new temporary file can't be created in the spill directory.
+  forceinline std::unique_ptr<slab_allocator_t> create_empty_like() const
+  {
+    auto allocator = create(this->slot_byte_len, this->slots_per_slab, this->max_num_slots, this->spill_directory);
+    if (!allocator) {
+      allocator = create(this->slot_byte_len, this->slots_per_slab, this->max_num_slots);
+    }
+
+    return allocator;
+  }
+
+  slab_allocator_t(const slab_allocator_t&) = delete;
+  slab_allocator_t(slab_allocator_t&&) = delete;
+  slab_allocator_t& operator=(const slab_allocator_t&) = delete;
+  slab_allocator_t& operator=(slab_allocator_t&&) = delete;
+
+  ~slab_allocator_t()
+  {
+#if defined(FRODOPIR_HAS_MMAP)
+    if (this->fd >= 0) {
+      for (auto* slab : this->slabs) {
+        ::munmap(slab, this->slab_byte_len);
+      }
+      ::close(this->fd);
+    }
+#endif
+  }
+
+  // Allocates a slot, returning its identifier, or nothing, if budget of slots is exhausted or a new slab can't be allocated.
+  [[nodiscard("Must release allocated slot")]] forceinline std::optional<size_t> allocate()
+  {
+    std::scoped_lock lock(this->lock);
+
+    if (this->free_slots.empty() && !this->grow()) {
+      return std::nullopt;
+    }
+
+    const size_t slot_id = this->free_slots.back();
+    this->free_slots.pop_back();
+
+    return slot_id;
+  }
+
+  // Releases a slot, which was allocated by this allocator, so that it can be reused, handing its memory back to the OS.
+  forceinline void release(const size_t slot_id)
+  {
+    // Slot is still owned by the caller, so it can be decommitted without holding the lock.
+    const size_t slab_idx = slot_id / this->slots_per_slab;
+    uint8_t* slab = nullptr;
+    {
+      std::scoped_lock lock(this->lock);
+      slab = this->slabs[slab_idx];
+    }
+
+    this->decommit(slab, slab_idx, (slot_id % this->slots_per_slab) * this->slot_stride, this->slot_byte_len);
+
+    std::scoped_lock lock(this->lock);
+    this->free_slots.push_back(slot_id);
+  }
+
+  // Releases all slots, keeping the slabs around, for reuse, but handing their memory back to the OS.
+  forceinline void clear()
+  {
+    std::scoped_lock lock(this->lock);
+
+    for (size_t slab_idx = 0; slab_idx < this->slabs.size(); slab_idx++) {
+      this->decommit(this->slabs[slab_idx], slab_idx, 0, this->slab_byte_len);
+    }
+
+    const size_t num_slots = this->num_slots();
+    this->free_slots.resize(num_slots);
+
+    for (size_t slot_idx = 0; slot_idx < num_slots; slot_idx++) {
+      this->free_slots[slot_idx] = num_slots - 1 - slot_idx;
+    }
+  }
+
+  // Returns memory of an allocated slot.
+  forceinline std::span<uint8_t> slot(const size_t slot_id)
+  {
+    uint8_t* slab = nullptr;
+    {
+      std::scoped_lock lock(this->lock);
+      slab = this->slabs[slot_id / this->slots_per_slab];
+    }
+
+    return std::span<uint8_t>(slab + (slot_id % this->slots_per_slab) * this->slot_stride, this->slot_byte_len);
+  }
+
+  // Returns number of currently allocated slots.
+  forceinline size_t num_allocated_slots() const
+  {
+    std::scoped_lock lock(this->lock);
+    return this->num_slots() - this->free_slots.size();
+  }
+
+  // Returns number of slots, which can be allocated at max.
+  forceinline size_t max_num_allocatable_slots() const { return this->max_num_slots; }
+
+  // Returns truth value, denoting whether slabs live in a memory-mapped file, instead of heap.
+  forceinline bool is_file_backed() const { return this->fd >= 0; }
+
+private:
+  size_t slot_byte_len = 0;
+  size_t slot_stride = 0;
+  size_t slots_per_slab = 0;
+  size_t slab_byte_len = 0;
+  size_t max_num_slots = 0;
+  size_t os_page_byte_len = PAGE_BYTE_LEN;
+  std::optional<std::filesystem::path> spill_directory{};
+  int fd = -1;
+
+  mutable std::mutex lock{};
+  std::vector<uint8_t*> slabs{};
+  std::vector<std::unique_ptr<uint8_t[]>> heap_slabs{};
+  std::vector<size_t> free_slots{};
+
+  slab_allocator_t(const size_t slot_byte_len,
+                   const size_t slots_per_slab,
+                   const size_t max_num_slots,
+                   std::optional<std::filesystem::path> spill_directory,
+                   const int fd)
+    : slot_byte_len(slot_byte_len)
+    , slot_stride(((slot_byte_len + (SLOT_ALIGNMENT - 1)) / SLOT_ALIGNMENT) * SLOT_ALIGNMENT)
+    , slots_per_slab(slots_per_slab)
+    , slab_byte_len(((slot_stride * slots_per_slab + (PAGE_BYTE_LEN - 1)) / PAGE_BYTE_LEN) * PAGE_BYTE_LEN)
+    , max_num_slots(max_num_slots)
+    , spill_directory(std::move(spill_directory))
+    , fd(fd)
+  {
+#if defined(FRODOPIR_HAS_MMAP)
+    if (const long page_byte_len = ::sysconf(_SC_PAGESIZE); page_byte_len > 0) {
+      this->os_page_byte_len = static_cast<size_t>(page_byte_len);
+    }
+#endif
+  }
+
+  // Given a slab, its index and a byte range inside it, this routine hands whole OS pages, lying in that range, back to the OS, leaving partial
+  // pages at its ends, which may be shared with neighbouring slots, untouched. File backed pages are punched out of the spill file, dropping
+  // them from page cache and disk, while heap backed pages are dropped, to be faulted in again, zero-filled, when touched. Best-effort: pages
+  // are kept as they are, where this is not supported.
+  forceinline void decommit([[maybe_unused]] uint8_t* const slab,
+                            [[maybe_unused]] const size_t slab_idx,
+                            [[maybe_unused]] const size_t region_offset,
+                            [[maybe_unused]] const size_t region_byte_len) const
+  {
+#if defined(FRODOPIR_HAS_MMAP)
+    const auto region_begin = reinterpret_cast<uintptr_t>(slab + region_offset);
+    const auto pages_begin = ((region_begin + (this->os_page_byte_len - 1)) / this->os_page_byte_len) * this->os_page_byte_len;
+    const auto pages_end = ((region_begin + region_byte_len) / this->os_page_byte_len) * this->os_page_byte_len;
+
+    if (pages_begin >= pages_end) {
+      return;
+    }
+
+    auto* const pages = reinterpret_cast<void*>(pages_begin);
+    const size_t pages_byte_len = pages_end - pages_begin;
+
+    if (this->fd >= 0) {
+#if defined(FALLOC_FL_PUNCH_HOLE) && defined(FALLOC_FL_KEEP_SIZE)
+      const auto file_offset = static_cast<off_t>(slab_idx * this->slab_byte_len + (pages_begin - reinterpret_cast<uintptr_t>(slab)));
+
+      if (::fallocate(this->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, file_offset, static_cast<off_t>(pages_byte_len)) == 0) {
+        return;
+      }
+#endif
+#if defined(MADV_REMOVE)
+      (void)::madvise(pages, pages_byte_len, MADV_REMOVE);
+#endif
+    } else {
+#if defined(MADV_DONTNEED)
+      (void)::madvise(pages, pages_byte_len, MADV_DONTNEED);
+#endif
+    }
+#endif
+  }
+
+  // Number of slots in allocated slabs, capped by the budget. Must be called with lock held.
+  forceinline size_t num_slots() const { return std::min(this->slabs.size() * this->slots_per_slab, this->max_num_slots); }
+
+  // Allocates one more slab, adding its slots to the free list. Returns false, if budget is exhausted or slab can't be allocated. Must be
+  // called with lock held.
+  forceinline bool grow()
+  {
+    const size_t num_slots_before = this->num_slots();
+    if (num_slots_before >= this->max_num_slots) {
+      return false;
+    }
+
+    uint8_t* slab = nullptr;
+
+    if (this->fd >= 0) {
+#if defined(FRODOPIR_HAS_MMAP)
+      const auto file_offset = static_cast<off_t>(this->slabs.size() * this->slab_byte_len);
+      if (::ftruncate(this->fd, file_offset + static_cast<off_t>(this->slab_byte_len)) != 0) {
+        return false;
+      }
+
+      void* addr = ::mmap(nullptr, this->slab_byte_len, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, file_offset);
+      if (addr == MAP_FAILED) {
+        return false;
+      }
+
+      slab = static_cast<uint8_t*>(addr);
+#endif
+    } else {
+      auto heap_slab = std::make_unique_for_overwrite<uint8_t[]>(this->slab_byte_len + SLOT_ALIGNMENT);
+      const auto addr = reinterpret_cast<uintptr_t>(heap_slab.get());
+
+      slab = heap_slab.get() + (((addr + (SLOT_ALIGNMENT - 1)) & ~(SLOT_ALIGNMENT - 1)) - addr);
+      this->heap_slabs.push_back(std::move(heap_slab));
+    }
+
+    this->slabs.push_back(slab);
+
+    // Lower slot identifiers get handed out first.
+    const size_t num_slots_after = this->num_slots();
+    for (size_t slot_id = num_slots_after; slot_id > num_slots_before; slot_id--) {
+      this->free_slots.push_back(slot_id - 1);
+    }
+
+    return true;
+  }
+};
+
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace frodoPIR_thread_pool {
+
+// Persistent pool of worker threads, which can be shared by all parallel routines of this library, instead of each of them spawning and joining
+// `std::thread::hardware_concurrency()` -many fresh threads per call. Work is distributed using work-stealing i.e. each participating thread
+// begins with an equal share of chunks and once it's done with them, it steals half of the remaining chunks of some other participant.
+//
+// Only one parallel job runs on a pool at a time, while concurrent callers wait for their turn. A parallel job, issued from a thread, which is
+// already participating in a job of this pool, gets executed sequentially by that thread itself. Issuing a parallel job doesn't allocate.
+// If processing a chunk throws, on any participating thread, remaining chunks are skipped and first exception is rethrown on the calling
+// thread, once all participants are done with the job.
+class thread_pool_t
+{
+public:
+  // Sets up a pool s.t. `num_threads` -many threads participate in each parallel job, counting the calling thread, which also does its share of
+  // work. So `num_threads - 1` -many workers are spawned. If CPU ids are provided, i-th worker gets pinned to `cpu_ids[i % cpu_ids.size()]`,
+  // while the calling thread is never pinned. Pinning is only supported on Linux, elsewhere CPU ids are ignored.
+  explicit thread_pool_t(const size_t num_threads = std::thread::hardware_concurrency(), std::span<const size_t> cpu_ids = {})
+    : num_participants(std::clamp<size_t>(num_threads, 1, std::numeric_limits<uint32_t>::max()))
+    , slots(std::make_unique<slot_t[]>(num_participants))
+  {
+    this->workers.reserve(this->num_participants - 1);
+
+    for (size_t w_idx = 0; w_idx < this->num_participants - 1; w_idx++) {
+      auto worker = std::thread([this, w_idx]() { this->worker_loop(w_idx + 1); });
+
+      if (!cpu_ids.empty()) {
+        pin_to_cpu(worker, cpu_ids[w_idx % cpu_ids.size()]);
+      }
+
+      this->workers.push_back(std::move(worker));
+    }
+  }
+
+  thread_pool_t(const thread_pool_t&) = delete;
+  thread_pool_t(thread_pool_t&&) = delete;
+  thread_pool_t& operator=(const thread_pool_t&) = delete;
+  thread_pool_t& operator=(thread_pool_t&&) = delete;
+
+  ~thread_pool_t()
+  {
+    {
+      std::scoped_lock lock(this->state_mutex);
+      this->is_stopping = true;
+    }
+
+    this->job_posted.notify_all();
+    std::ranges::for_each(this->workers, [](auto& handle) { handle.join(); });
+  }
+
+  // Process-wide default pool, using all hardware threads, which is lazily set up on first use.
+  static forceinline thread_pool_t& global()
+  {
+    static thread_pool_t pool{};
+    return pool;
+  }
+
+  // Number of threads participating in each parallel job, including the calling thread.
+  forceinline size_t size() const { return this->num_participants; }
+
+  // Given `num_items` -many work items, this routine splits them into chunks of `grain` -many consecutive items, calling `fn(begin, end)`
+  // on each of those chunks, s.t. all items in [0, num_items) are covered exactly once, using all threads of the pool, and returns only after
+  // all of them are done. If `grain` is zero, chunk size is chosen s.t. there are a few chunks per participating thread. If `fn` throws, some
+  // items may not be processed and first exception is rethrown, after all participating threads are done.
+  template<typename fn_t>
+  forceinline void parallel_for(const size_t num_items, fn_t&& fn, size_t grain = 0)
+  {
+    if (num_items == 0) {
+      return;
+    }
+    if (grain == 0) {
+      grain = std::max<size_t>(num_items / (this->num_participants * CHUNKS_PER_PARTICIPANT), 1);
+    }
+
+    const size_t num_chunks = (num_items + (grain - 1)) / grain;
+
+    // Nested job or nothing to parallelize, let's do it sequentially.
+    if ((current_pool == this) || (this->num_participants == 1) || (num_chunks == 1) || (num_chunks > std::numeric_limits<uint32_t>::max())) {
+      fn(size_t{ 0 }, num_items);
+      return;
+    }
+
+    job_t job{
+      .ctx = static_cast<void*>(&fn),
+      .invoke = [](void* ctx, const size_t begin, const size_t end) { (*static_cast<std::remove_reference_t<fn_t>*>(ctx))(begin, end); },
+      .num_items = num_items,
+      .grain = grain,
+    };
+
+    std::scoped_lock job_lock(this->job_mutex);
+
+    // Distribute chunks equally among participating threads, before any of them begins working.
+    for (size_t p_idx = 0; p_idx < this->num_participants; p_idx++) {
+      const auto chunk_begin = static_cast<uint32_t>((num_chunks * p_idx) / this->num_participants);
+      const auto chunk_end = static_cast<uint32_t>((num_chunks * (p_idx + 1)) / this->num_participants);
+
+      this->slots[p_idx].range.store(pack_range(chunk_begin, chunk_end), std::memory_order_relaxed);
+    }
+
+    {
+      std::scoped_lock lock(this->state_mutex);
+
+      this->current_job = &job;
+      this->num_busy_workers = this->workers.size();
+      this->job_generation++;
+    }
+
+    this->job_posted.notify_all();
+
+    {
+      const current_pool_scope_t pool_scope(this);
+      this->participate(job, 0);
+    }
+
+    // Job lives on this stack frame, so wait until all workers are done with it.
+    {
+      std::unique_lock lock(this->state_mutex);
+      this->job_finished.wait(lock, [this]() { return this->num_busy_workers == 0; });
+      this->current_job = nullptr;
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+private:
+  static constexpr size_t CHUNKS_PER_PARTICIPANT = 4;
+
+  // Type erased parallel job, which lives on the stack of thread issuing it. First exception, thrown while processing any of its chunks, is
+  // kept, to be rethrown on the thread issuing it.
+  struct job_t
+  {
+    void* ctx;
+    void (*invoke)(void*, size_t, size_t);
+    size_t num_items;
+    size_t grain;
+    std::atomic<bool> has_failed{ false };
+    std::exception_ptr error{};
+  };
+
+  // Marks the current thread as participating in a job of given pool, for the lifetime of this handle, even if the job throws.
+  struct current_pool_scope_t
+  {
+    thread_pool_t* const prev_pool;
+
+    explicit current_pool_scope_t(thread_pool_t* const pool)
+      : prev_pool(std::exchange(current_pool, pool))
+    {
+    }
+
+    current_pool_scope_t(const current_pool_scope_t&) = delete;
+    current_pool_scope_t& operator=(const current_pool_scope_t&) = delete;
+
+    ~current_pool_scope_t() { current_pool = this->prev_pool; }
+  };
+
+  // Range of chunk indices [begin, end), yet to be processed by a participating thread, packed in a single 64 -bit word, so that it can be
+  // popped from front by its owner and split in half by thieves, using compare-and-swap.
+  struct alignas(64) slot_t
+  {
+    std::atomic<uint64_t> range{ 0 };
+  };
+
+  size_t num_participants;
+  std::unique_ptr<slot_t[]> slots;
+  std::vector<std::thread> workers;
+
+  std::mutex job_mutex;
+
+  std::mutex state_mutex;
+  std::condition_variable job_posted;
+  std::condition_variable job_finished;
+  job_t* current_job = nullptr;
+  size_t num_busy_workers = 0;
+  uint64_t job_generation = 0;
+  bool is_stopping = false;
+
+  // Pool, in whose job the current thread is participating, if any.
+  static inline thread_local thread_pool_t* current_pool = nullptr;
+
+  static forceinline constexpr uint64_t pack_range(const uint32_t begin, const uint32_t end) { return (static_cast<uint64_t>(begin) << 32) | end; }
+  static forceinline constexpr uint32_t range_begin(const uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+  static forceinline constexpr uint32_t range_end(const uint64_t range) { return static_cast<uint32_t>(range); }
+
+  static forceinline void pin_to_cpu([[maybe_unused]] std::thread& thread, [[maybe_unused]] const size_t cpu_id)
+  {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_id, &cpu_set);
+
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
+  }
+
+  // Pops a chunk from front of own range, returning false if own range is exhausted.
+  forceinline bool pop_chunk(const size_t p_idx, uint32_t& chunk_idx)
+  {
+    auto& range = this->slots[p_idx].range;
+    uint64_t cur = range.load(std::memory_order_relaxed);
+
+    while (range_begin(cur) < range_end(cur)) {
+      if (range.compare_exchange_weak(cur, pack_range(range_begin(cur) + 1, range_end(cur)), std::memory_order_acq_rel)) {
+        chunk_idx = range_begin(cur);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Steals back half of remaining chunks of some other participant, placing them in own (exhausted) range, returning false if there's
+  // nothing left to steal.
+  forceinline bool steal_chunks(const size_t p_idx)
+  {
+    for (size_t offset = 1; offset < this->num_participants; offset++) {
+      auto& victim_range = this->slots[(p_idx + offset) % this->num_participants].range;
+      uint64_t cur = victim_range.load(std::memory_order_relaxed);
+
+      while (range_begin(cur) < range_end(cur)) {
+        const uint32_t begin = range_begin(cur);
+        const uint32_t end = range_end(cur);
+        const uint32_t mid = begin + (end - begin) / 2;
+
+        if (victim_range.compare_exchange_weak(cur, pack_range(begin, mid), std::memory_order_acq_rel)) {
+          this->slots[p_idx].range.store(pack_range(mid, end), std::memory_order_release);
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // Processes chunks of the job, until there are no more chunks left to process or steal. Once the job has failed, remaining chunks are only
+  // drained, without being processed. Never throws, as exceptions are kept in the job.
+  forceinline void participate(job_t& job, const size_t p_idx)
+  {
+    uint32_t chunk_idx = 0;
+
+    do {
+      while (this->pop_chunk(p_idx, chunk_idx)) {
+        if (job.has_failed.load(std::memory_order_relaxed)) {
+          continue;
+        }
+
+        const size_t begin = static_cast<size_t>(chunk_idx) * job.grain;
+        const size_t end = std::min(begin + job.grain, job.num_items);
+
+        try {
+          job.invoke(job.ctx, begin, end);
+        } catch (...) {
+          // Only the first failing participant gets to keep its exception, which is read after all participants are done.
+          if (!job.has_failed.exchange(true, std::memory_order_acq_rel)) {
+            job.error = std::current_exception();
+          }
+        }
+      }
+    } while (this->steal_chunks(p_idx));
+  }
+
+  void worker_loop(const size_t p_idx)
+  {
+    uint64_t seen_job_generation = 0;
+
+    while (true) {
+      job_t* job = nullptr;
+
+      {
+        std::unique_lock lock(this->state_mutex);
+        this->job_posted.wait(lock, [&]() { return this->is_stopping || (this->job_generation != seen_job_generation); });
+
+        if (this->is_stopping) {
+          return;
+        }
+
+        seen_job_generation = this->job_generation;
+        job = this->current_job;
+      }
+
+      {
+        const current_pool_scope_t pool_scope(this);
+        this->participate(*job, p_idx);
+      }
+
+      bool is_last_worker = false;
+      {
+        std::scoped_lock lock(this->state_mutex);
+        is_last_worker = (--this->num_busy_workers == 0);
+      }
+
+      if (is_last_worker) {
+        this->job_finished.notify_one();
+      }
+    }
+  }
+};
+
+}
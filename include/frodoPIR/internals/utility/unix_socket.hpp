@@ -0,0 +1,200 @@
+#pragma once
+#include "frodoPIR/internals/utility/force_inline.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRODOPIR_HAS_UNIX_SOCKETS 1
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace frodoPIR_unix_socket {
+
+// Owning handle of a blocking, stream oriented Unix domain socket. It's closed, when the handle is destroyed. On platforms without Unix domain
+// sockets, every socket is invalid.
+class socket_t
+{
+public:
+  socket_t() = default;
+  explicit socket_t(const int fd)
+    : fd(fd)
+  {
+  }
+
+  socket_t(const socket_t&) = delete;
+  socket_t& operator=(const socket_t&) = delete;
+
+  socket_t(socket_t&& other) noexcept
+    : fd(std::exchange(other.fd, -1))
+  {
+  }
+  socket_t& operator=(socket_t&& other) noexcept
+  {
+    if (this != &other) {
+      this->close();
+      this->fd = std::exchange(other.fd, -1);
+    }
+    return *this;
+  }
+
+  ~socket_t() { this->close(); }
+
+  // Given a filesystem path, this routine creates a socket, listening for connections on it. Stale socket file, if any, is removed first.
+  // Returned socket is invalid, if path is too long for a socket address or the socket can't be bound.
+  static forceinline socket_t listen([[maybe_unused]] const std::filesystem::path& path, [[maybe_unused]] const int backlog = 16)
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+    sockaddr_un addr{};
+    if (!to_socket_address(path, addr)) {
+      return socket_t{};
+    }
+
+    socket_t sock(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (!sock.is_valid()) {
+      return socket_t{};
+    }
+
+    ::unlink(addr.sun_path);
+    if ((::bind(sock.fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) || (::listen(sock.fd, backlog) != 0)) {
+      return socket_t{};
+    }
+
+    return sock;
+#else
+    return socket_t{};
+#endif
+  }
+
+  // Given a filesystem path, on which some socket is listening, this routine connects to it. Returned socket is invalid, if it can't connect.
+  static forceinline socket_t connect([[maybe_unused]] const std::filesystem::path& path)
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+    sockaddr_un addr{};
+    if (!to_socket_address(path, addr)) {
+      return socket_t{};
+    }
+
+    socket_t sock(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (!sock.is_valid()) {
+      return socket_t{};
+    }
+
+    int ret = 0;
+    do {
+      ret = ::connect(sock.fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    } while ((ret != 0) && (errno == EINTR));
+
+    return (ret == 0) ? std::move(sock) : socket_t{};
+#else
+    return socket_t{};
+#endif
+  }
+
+  // Waits for a connection on this listening socket, returning socket of the accepted connection, or an invalid socket, on failure.
+  forceinline socket_t accept() const
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+    int conn_fd = -1;
+    do {
+      conn_fd = ::accept(this->fd, nullptr, nullptr);
+    } while ((conn_fd < 0) && (errno == EINTR));
+
+    return socket_t(conn_fd);
+#else
+    return socket_t{};
+#endif
+  }
+
+  // Writes all of `bytes`, returning false, if connection is closed by peer or on any other failure.
+  [[nodiscard("Must use status of writing to socket")]] forceinline bool write_all([[maybe_unused]] std::span<const uint8_t> bytes) const
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+#if defined(MSG_NOSIGNAL)
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif
+
+    while (!bytes.empty()) {
+      const auto num_written = ::send(this->fd, bytes.data(), bytes.size(), flags);
+      if (num_written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+
+      bytes = bytes.subspan(static_cast<size_t>(num_written));
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Reads exactly `bytes.size()` -many bytes, returning false, if connection is closed by peer before that or on any other failure.
+  [[nodiscard("Must use status of reading from socket")]] forceinline bool read_all([[maybe_unused]] std::span<uint8_t> bytes) const
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+    while (!bytes.empty()) {
+      const auto num_read = ::recv(this->fd, bytes.data(), bytes.size(), 0);
+      if (num_read < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      if (num_read == 0) {
+        return false;
+      }
+
+      bytes = bytes.subspan(static_cast<size_t>(num_read));
+    }
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  forceinline bool is_valid() const { return this->fd >= 0; }
+
+private:
+  int fd = -1;
+
+  forceinline void close()
+  {
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+    if (this->fd >= 0) {
+      ::close(this->fd);
+    }
+#endif
+    this->fd = -1;
+  }
+
+#if defined(FRODOPIR_HAS_UNIX_SOCKETS)
+  // Fills Unix domain socket address, returning false, if path doesn't fit in it.
+  static forceinline bool to_socket_address(const std::filesystem::path& path, sockaddr_un& addr)
+  {
+    const auto& native_path = path.native();
+    if (native_path.empty() || (native_path.size() >= sizeof(addr.sun_path))) {
+      return false;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, native_path.c_str(), native_path.size() + 1);
+
+    return true;
+  }
+#endif
+};
+
+}
@@ -1,19 +1,24 @@
 #pragma once
 #include "frodoPIR/internals/utility/force_inline.hpp"
+#include <algorithm>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <new>
 #include <span>
+#include <type_traits>
 
 namespace frodoPIR_utils {
 
 // Given a byte array of length n (>=0), this routine copies input bytes into destination word, of unsigned type T,
-// while placing bytes following little-endian ordering.
+// while placing bytes following little-endian ordering. Bytes are placed one by one, so it works on any native byte order.
 template<typename T>
 forceinline constexpr T
 from_le_bytes(std::span<const uint8_t> bytes)
-  requires(std::is_unsigned_v<T> && (std::endian::native == std::endian::little))
+  requires(std::is_unsigned_v<T>)
 {
   T res{};
 
@@ -26,10 +31,9 @@ from_le_bytes(std::span<const uint8_t> bytes)
 }
 
 // Given an unsigned integer as input, this routine copies source bytes, following little-endian order, into destination
-// byte array of length n (>=0).
+// byte array of length n (>=0). Bytes are placed one by one, so it works on any native byte order.
 forceinline constexpr void
 to_le_bytes(const std::unsigned_integral auto v, std::span<uint8_t> bytes)
-  requires(std::endian::native == std::endian::little)
 {
   const size_t copyable = std::min(sizeof(v), bytes.size());
   for (size_t i = 0; i < copyable; i++) {
@@ -37,4 +41,107 @@ to_le_bytes(const std::unsigned_integral auto v, std::span<uint8_t> bytes)
   }
 }
 
+// Given pointer to suitably aligned storage, holding value representation of `n` -many objects of type T, this routine starts their lifetime,
+// without touching the value representation, returning pointer to the first of them, same as C++23 `std::start_lifetime_as_array` does. Until
+// that's available, moving storage onto itself implicitly creates objects in it ( see [cstring.syn] ), which compilers elide.
+template<typename T>
+  requires(std::is_trivially_copyable_v<T>)
+forceinline T*
+start_lifetime_as_array(void* const ptr, const size_t n)
+{
+#if defined(__cpp_lib_start_lifetime_as)
+  return std::start_lifetime_as_array<T>(ptr, n);
+#else
+  return std::launder(static_cast<T*>(std::memmove(ptr, ptr, n * sizeof(T))));
+#endif
+}
+
+// Same as above, but for storage, which is only read through returned pointer and may not be writable at all e.g. a read-only mapping or a
+// buffer read by many threads at once. So it never writes to the storage. Until `std::start_lifetime_as_array` is available, storage is
+// reinterpreted as an array of T, same as a memory-mapped parsed database matrix is, by the server.
+template<typename T>
+  requires(std::is_trivially_copyable_v<T>)
+forceinline const T*
+start_lifetime_as_array(const void* const ptr, [[maybe_unused]] const size_t n)
+{
+#if defined(__cpp_lib_start_lifetime_as)
+  return std::start_lifetime_as_array<T>(ptr, n);
+#else
+  return std::launder(reinterpret_cast<const T*>(ptr));
+#endif
+}
+
+// View of a byte serialized array of unsigned integers of type T, each in little-endian byte order, as an array of T, for the lifetime of
+// the view. When native byte order is little-endian and bytes are aligned to T, array is viewed right where it is, without any copy.
+// Otherwise it's staged through a heap allocated copy, which is, unless T is const-qualified, serialized back into the bytes, when the
+// view is destroyed. So serialized queries and responses can be worked on in place, whenever possible, on any native byte order. Note, a
+// staged copy is only loaded from the bytes, when T is const-qualified, so a writable view, which is staged, starts out uninitialized,
+// rather than holding the current content of the bytes. It's meant for outputs, which are fully overwritten, before being read.
+template<typename T>
+  requires(std::is_unsigned_v<std::remove_const_t<T>>)
+struct le_span_view_t
+{
+public:
+  using elem_t = std::remove_const_t<T>;
+  using byte_t = std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>;
+
+  // Given byte serialized array, of byte length multiple of `sizeof(T)`, this routine views it as an array of T.
+  explicit le_span_view_t(std::span<byte_t> bytes)
+    : bytes(bytes)
+    , len(bytes.size() / sizeof(elem_t))
+  {
+    const bool is_aligned = (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(elem_t)) == 0;
+
+    if ((std::endian::native == std::endian::little) && is_aligned) {
+      this->elements = start_lifetime_as_array<elem_t>(bytes.data(), this->len);
+      return;
+    }
+
+    this->copy = std::make_unique_for_overwrite<elem_t[]>(this->len);
+    this->elements = this->copy.get();
+
+    if constexpr (std::is_const_v<T>) {
+      if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(this->copy.get(), bytes.data(), this->len * sizeof(elem_t));
+      } else {
+        for (size_t i = 0; i < this->len; i++) {
+          this->copy[i] = from_le_bytes<elem_t>(bytes.subspan(i * sizeof(elem_t), sizeof(elem_t)));
+        }
+      }
+    }
+  }
+
+  le_span_view_t(const le_span_view_t&) = delete;
+  le_span_view_t& operator=(const le_span_view_t&) = delete;
+
+  ~le_span_view_t()
+  {
+    if constexpr (!std::is_const_v<T>) {
+      if (!this->copy) {
+        return;
+      }
+
+      if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(this->bytes.data(), this->copy.get(), this->len * sizeof(elem_t));
+      } else {
+        for (size_t i = 0; i < this->len; i++) {
+          to_le_bytes(this->copy[i], this->bytes.subspan(i * sizeof(elem_t), sizeof(elem_t)));
+        }
+      }
+    }
+  }
+
+  // Returns pointer to the first element of viewed array.
+  forceinline T* data() const { return this->elements; }
+
+  // Returns number of elements in viewed array.
+  forceinline size_t size() const { return this->len; }
+
+private:
+  std::span<byte_t> bytes;
+  size_t len = 0;
+  std::unique_ptr<elem_t[]> copy{};
+  T* elements = nullptr;
+};
+
 }
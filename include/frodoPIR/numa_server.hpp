@@ -0,0 +1,160 @@
+#pragma once
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/utility/numa.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/server.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace frodoPIR_numa_server {
+
+// FrodoPIR server, which places rows of the transposed parsed database matrix across NUMA nodes of the machine. Each node owns a contiguous
+// slice of rows of transposed D, i.e. a contiguous range of columns of response c̃, proportional to its number of CPUs. Slice is placed on the
+// node by threads pinned to it, which are also the ones responding from it. So each socket streams its slice from local DRAM, instead of half
+// of the cores reading all of D over the interconnect, from whichever node happened to first touch it.
+//
+// Every node has a thread pool of its own, with workers pinned to CPUs of that node. Another small pool, with one thread per node, dispatches
+// a response to all of node pools at once. On a single node machine, this reduces to a single, unpinned thread pool.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+struct numa_server_t
+{
+public:
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using parsed_db_elem_t = typename server_t::parsed_db_elem_t;
+
+  static constexpr auto NUM_COLUMNS_IN_PARSED_DB = server_t::NUM_COLUMNS_IN_PARSED_DB;
+  static constexpr auto QUERY_BYTE_LEN = server_t::QUERY_BYTE_LEN;
+  static constexpr auto RESPONSE_BYTE_LEN = server_t::RESPONSE_BYTE_LEN;
+
+  numa_server_t() = default;
+
+  // Given a set up server and NUMA nodes, this routine copies transposed parsed database matrix of the server into node local slices, returning
+  // a server handle, which responds from those slices. Given server handle can be dropped afterwards. Returns nothing, if a slice can't be
+  // allocated or no node is given.
+  static forceinline std::optional<numa_server_t> distribute(const server_t& server,
+                                                             std::span<const frodoPIR_numa::node_t> nodes = frodoPIR_numa::get_nodes())
+  {
+    if (nodes.empty()) {
+      return std::nullopt;
+    }
+
+    numa_server_t numa_server;
+    numa_server.slices.resize(nodes.size());
+
+    // Rows of transposed D are split among nodes, in proportion to their number of CPUs.
+    size_t total_num_cpus = 0;
+    for (const auto& node : nodes) {
+      total_num_cpus += std::max<size_t>(node.cpu_ids.size(), 1);
+    }
+
+    std::vector<size_t> dispatcher_cpu_ids;
+
+    size_t num_cpus_so_far = 0;
+    for (size_t n_idx = 0; n_idx < nodes.size(); n_idx++) {
+      const auto& node = nodes[n_idx];
+      auto& slice = numa_server.slices[n_idx];
+
+      slice.row_begin = (NUM_COLUMNS_IN_PARSED_DB * num_cpus_so_far) / total_num_cpus;
+      num_cpus_so_far += std::max<size_t>(node.cpu_ids.size(), 1);
+      slice.row_end = (NUM_COLUMNS_IN_PARSED_DB * num_cpus_so_far) / total_num_cpus;
+
+      const size_t slice_byte_len = (slice.row_end - slice.row_begin) * db_entry_count * sizeof(parsed_db_elem_t);
+      slice.D = frodoPIR_numa::node_buffer_t::allocate(node.id, slice_byte_len);
+      if ((slice_byte_len > 0) && (slice.D.data() == nullptr)) {
+        return std::nullopt;
+      }
+
+      // Dispatcher of a node runs on its first CPU, while workers of its pool run on rest of them. Dispatcher of first node is the thread
+      // calling `respond`, which can't be pinned.
+      if (node.cpu_ids.empty()) {
+        slice.pool = std::make_unique<frodoPIR_thread_pool::thread_pool_t>();
+      } else {
+        slice.pool = std::make_unique<frodoPIR_thread_pool::thread_pool_t>(node.cpu_ids.size(), std::span(node.cpu_ids).subspan(1));
+      }
+      if (n_idx > 0) {
+        dispatcher_cpu_ids.push_back(node.cpu_ids.empty() ? 0 : node.cpu_ids.front());
+      }
+    }
+
+    numa_server.dispatch_pool = std::make_unique<frodoPIR_thread_pool::thread_pool_t>(nodes.size(), dispatcher_cpu_ids);
+
+    // Each slice is first touched by threads of its own node.
+    const auto db = server.db_view();
+    numa_server.for_each_node([&](const slice_t& slice) {
+      auto* const D_slice = reinterpret_cast<parsed_db_elem_t*>(slice.D.data());
+
+      slice.pool->parallel_for(slice.row_end - slice.row_begin, [&](const size_t r_idx_begin, const size_t r_idx_end) {
+        for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
+          const auto db_row = db.row(slice.row_begin + r_idx);
+          std::memcpy(D_slice + r_idx * db_entry_count, db_row.data(), db_entry_count * sizeof(parsed_db_elem_t));
+        }
+      });
+    });
+
+    return numa_server;
+  }
+
+  // Returns number of NUMA nodes, transposed parsed database matrix is placed across.
+  forceinline size_t num_nodes() const { return this->slices.size(); }
+
+  // Returns byte length of slice of transposed parsed database matrix, placed on node at `node_idx`, which is streamed once per response.
+  forceinline size_t node_slice_byte_len(const size_t node_idx) const { return this->slices[node_idx].D.size(); }
+
+  // Same as `server_t::respond`. Each node computes its own range of columns of response, from its slice of transposed parsed database matrix,
+  // using its own pool. Query and response are worked on right where they are, whenever possible.
+  void respond(std::span<const uint8_t, QUERY_BYTE_LEN> query_bytes, std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
+  {
+    const frodoPIR_matrix::zq_const_view_t b_tilda(query_bytes);
+    const frodoPIR_matrix::zq_view_t c_tilda(response_bytes);
+
+    std::fill_n(c_tilda.data(), NUM_COLUMNS_IN_PARSED_DB, frodoPIR_matrix::zq_t{});
+    this->for_each_node([&](const slice_t& slice) {
+      frodoPIR_matrix::row_vector_x_transposed_column_block(b_tilda.data(),
+                                                            reinterpret_cast<const parsed_db_elem_t*>(slice.D.data()),
+                                                            db_entry_count,
+                                                            slice.row_end - slice.row_begin,
+                                                            db_entry_count,
+                                                            c_tilda.data() + slice.row_begin,
+                                                            *slice.pool);
+    });
+  }
+
+private:
+  // Slice of transposed parsed database matrix, holding its rows [row_begin, row_end), placed on a NUMA node, along with pool of threads,
+  // pinned to that node.
+  struct slice_t
+  {
+    size_t row_begin = 0;
+    size_t row_end = 0;
+    frodoPIR_numa::node_buffer_t D{};
+    std::unique_ptr<frodoPIR_thread_pool::thread_pool_t> pool{};
+  };
+
+  std::vector<slice_t> slices{};
+  std::unique_ptr<frodoPIR_thread_pool::thread_pool_t> dispatch_pool{};
+
+  // Calls `fn(slice)` for every slice at once, each from dispatcher thread of its own node, returning after all of them are done.
+  template<typename fn_t>
+  forceinline void for_each_node(fn_t&& fn) const
+  {
+    // One chunk per node, so that each dispatcher starts off with the slice of its own node.
+    this->dispatch_pool->parallel_for(
+      this->slices.size(),
+      [&](const size_t n_idx_begin, const size_t n_idx_end) {
+        for (size_t n_idx = n_idx_begin; n_idx < n_idx_end; n_idx++) {
+          fn(this->slices[n_idx]);
+        }
+      },
+      1);
+  }
+};
+
+}
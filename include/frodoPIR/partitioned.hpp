@@ -0,0 +1,392 @@
+#pragma once
+#include "frodoPIR/client.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include "frodoPIR/internals/utility/params.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/server.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace frodoPIR_partitioned {
+
+// Compile-time check, if a database with `db_entry_count` -many rows can be split into partitions of `partition_entry_count` -many rows, each
+// being a database, for which FrodoPIR is instantiated using one of recommended parameters.
+consteval bool
+check_partitioning_params(const size_t db_entry_count, const size_t partition_entry_count)
+{
+  return (db_entry_count > 0) &&
+         frodoPIR_params::check_frodoPIR_params(partition_entry_count, frodoPIR_params::get_recommended_mat_element_bitlen(partition_entry_count));
+}
+
+// Partitioned FrodoPIR Server, for databases having any number of rows, even more than 2^20. Database is split into partitions, each holding
+// `partition_entry_count` -many consecutive rows, with the last one padded with zeroed rows. Each partition is served by a FrodoPIR server,
+// using recommended parameters, while all of them share same seed, so that public matrix A is same for all partitions.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t partition_entry_count = 1ul << 20>
+  requires(check_partitioning_params(db_entry_count, partition_entry_count))
+struct partitioned_server_t
+{
+public:
+  // Compile-time computable values.
+  static constexpr size_t MAT_ELEMENT_BITLEN = frodoPIR_params::get_recommended_mat_element_bitlen(partition_entry_count);
+  static constexpr size_t NUM_PARTITIONS = (db_entry_count + (partition_entry_count - 1)) / partition_entry_count;
+  static constexpr size_t ORIGINAL_DB_BYTE_LEN = db_entry_count * db_entry_byte_len;
+
+  // Type aliases.
+  using partition_server_t = frodoPIR_server::server_t<partition_entry_count, db_entry_byte_len, MAT_ELEMENT_BITLEN>;
+  using pub_mat_M_t = typename partition_server_t::pub_mat_M_t;
+
+  // Each query and response concerns a single partition.
+  static constexpr size_t QUERY_BYTE_LEN = partition_server_t::QUERY_BYTE_LEN;
+  static constexpr size_t RESPONSE_BYTE_LEN = partition_server_t::RESPONSE_BYTE_LEN;
+
+  // Given a `λ` -bit seed and a byte serialized database which has `db_entry_count` -many entries s.t. each entry is of `db_entry_byte_len`
+  // -bytes, this routine sets up servers of all partitions, returning partitioned server handle and public matrix M of each partition, in
+  // order. Public matrices M are meant to be handed to clients lazily, one partition at a time, as they are about to enquire it. Partitions
+  // are set up one after another, each using `server_t::setup_streaming`, so that public matrix A is never materialized. All partitions expand
+  // A as per `A_expansion_mode`, which clients must be set up with.
+  static std::pair<partitioned_server_t, std::vector<pub_mat_M_t>> setup(
+    std::span<const uint8_t, frodoPIR_server::SEED_BYTE_LEN> seed_μ,
+    std::span<const uint8_t, ORIGINAL_DB_BYTE_LEN> db_bytes,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    constexpr size_t partition_byte_len = partition_entry_count * db_entry_byte_len;
+
+    partitioned_server_t server{};
+    std::vector<pub_mat_M_t> Ms{};
+
+    server.partitions.reserve(NUM_PARTITIONS);
+    Ms.reserve(NUM_PARTITIONS);
+
+    std::vector<uint8_t> padded_partition_bytes{};
+
+    for (size_t p_idx = 0; p_idx < NUM_PARTITIONS; p_idx++) {
+      const auto partition_bytes = db_bytes.subspan(p_idx * partition_byte_len);
+      const uint8_t* full_partition_bytes = partition_bytes.data();
+
+      // Last partition gets padded with zeroed rows.
+      if (partition_bytes.size() < partition_byte_len) {
+        padded_partition_bytes.resize(partition_byte_len, 0);
+        std::ranges::copy(partition_bytes, padded_partition_bytes.begin());
+
+        full_partition_bytes = padded_partition_bytes.data();
+      }
+
+      auto [partition_server, M] = partition_server_t::setup_streaming(
+        seed_μ, std::span<const uint8_t, partition_byte_len>(full_partition_bytes, partition_byte_len), pool, A_expansion_mode);
+
+      server.partitions.push_back(std::move(partition_server));
+      Ms.push_back(std::move(M));
+    }
+
+    server.set_thread_pool(pool);
+    return { std::move(server), std::move(Ms) };
+  }
+
+  // Given a database row index, this routine returns index of the partition, holding it.
+  static forceinline constexpr size_t get_partition_index(const size_t db_row_index) { return db_row_index / partition_entry_count; }
+
+  // Sets the thread pool, which is used for responding to client queries. It must outlive this server handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    this->pool = &pool;
+    for (auto& partition : this->partitions) {
+      partition.set_thread_pool(pool);
+    }
+  }
+
+  // Given index of a partition and byte serialized client query, for that partition, this routine responds back to it, producing byte
+  // serialized server response. Server learns which partition is being enquired, but not which row of it. Returns false, if partition
+  // index is out of range.
+  [[nodiscard("Must use status of partition response")]] bool respond(const size_t partition_idx,
+                                                                      std::span<const uint8_t, QUERY_BYTE_LEN> query_bytes,
+                                                                      std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
+  {
+    if (partition_idx >= NUM_PARTITIONS) {
+      return false;
+    }
+
+    this->partitions[partition_idx].respond(query_bytes, response_bytes);
+    return true;
+  }
+
+  // Given `NUM_PARTITIONS` -many byte serialized client queries, one per partition, in order, concatenated, this routine responds to all of
+  // them, writing `NUM_PARTITIONS` -many byte serialized server responses, concatenated in same order. When there are at least as many
+  // partitions as threads in the pool, each thread responds to queries of whole partitions, one after another, so that each pass over
+  // a partition is done by a single core. Otherwise partitions are responded to one after another, each using all threads of the pool.
+  // Returns false, without touching `responses_bytes`, if byte length of either buffer doesn't match.
+  [[nodiscard("Must use status of partitioned response")]] bool respond_all(std::span<const uint8_t> queries_bytes,
+                                                                           std::span<uint8_t> responses_bytes) const
+  {
+    if ((queries_bytes.size() != NUM_PARTITIONS * QUERY_BYTE_LEN) || (responses_bytes.size() != NUM_PARTITIONS * RESPONSE_BYTE_LEN)) {
+      return false;
+    }
+
+    auto respond_to_partitions = [&](const size_t p_idx_begin, const size_t p_idx_end) {
+      for (size_t p_idx = p_idx_begin; p_idx < p_idx_end; p_idx++) {
+        this->partitions[p_idx].respond(queries_bytes.subspan(p_idx * QUERY_BYTE_LEN).template first<QUERY_BYTE_LEN>(),
+                                        responses_bytes.subspan(p_idx * RESPONSE_BYTE_LEN).template first<RESPONSE_BYTE_LEN>());
+      }
+    };
+
+    if (NUM_PARTITIONS >= this->pool->size()) {
+      // Responding to a partition, from within a job of the same pool, runs sequentially on the calling thread.
+      this->pool->parallel_for(NUM_PARTITIONS, respond_to_partitions, 1);
+    } else {
+      respond_to_partitions(0, NUM_PARTITIONS);
+    }
+
+    return true;
+  }
+
+private:
+  std::vector<partition_server_t> partitions{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+};
+
+// Partitioned FrodoPIR Client, talking to a `partitioned_server_t`. It keeps a low-memory FrodoPIR client for each partition, whose public
+// matrix M has been handed to it, which expands public matrix A from the shared seed, while preparing queries. So public matrices M can be
+// fetched lazily, as partitions are being enquired, without ever materializing public matrix A, which takes ~7.4 GB for 2^20 rows.
+//
+// Expanding A is the dominant cost of preparing queries, as it means squeezing ~7.4 GB out of the XOF, for 2^20 rows. All partitions share
+// same A, so queries for many partitions are better prepared together, using batched `prepare_query`, which expands A only once.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t partition_entry_count = 1ul << 20>
+  requires(check_partitioning_params(db_entry_count, partition_entry_count))
+struct partitioned_client_t
+{
+public:
+  // Compile-time computable values.
+  static constexpr size_t MAT_ELEMENT_BITLEN = frodoPIR_params::get_recommended_mat_element_bitlen(partition_entry_count);
+  static constexpr size_t NUM_PARTITIONS = (db_entry_count + (partition_entry_count - 1)) / partition_entry_count;
+
+  // Type aliases.
+  using partition_client_t = frodoPIR_client::client_t<partition_entry_count, db_entry_byte_len, MAT_ELEMENT_BITLEN>;
+
+  // Each query and response concerns a single partition.
+  static constexpr size_t PUBLIC_MATRIX_M_BYTE_LEN = partition_client_t::PUBLIC_MATRIX_M_BYTE_LEN;
+  static constexpr size_t QUERY_BYTE_LEN = partition_client_t::QUERY_BYTE_LEN;
+  static constexpr size_t RESPONSE_BYTE_LEN = partition_client_t::RESPONSE_BYTE_LEN;
+
+  // Given a `λ` -bit seed, shared by all partitions, this routine sets up partitioned FrodoPIR client, which can't enquire any partition yet,
+  // until its public matrix M is handed to it, using `set_partition_pub_mat_M`. Public matrix A is expanded as per `A_expansion_mode`, which
+  // must be the one server was set up with.
+  static forceinline partitioned_client_t setup(
+    std::span<const uint8_t, frodoPIR_client::SEED_BYTE_LEN> seed_μ,
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    partitioned_client_t client{};
+
+    std::ranges::copy(seed_μ, client.seed_μ.begin());
+    client.A_expansion_mode = A_expansion_mode;
+    client.partitions.resize(NUM_PARTITIONS);
+
+    return client;
+  }
+
+  // Given a database row index, this routine returns index of the partition, holding it, along with index of the row within the partition.
+  static forceinline constexpr std::pair<size_t, size_t> locate(const size_t db_row_index)
+  {
+    return { db_row_index / partition_entry_count, db_row_index % partition_entry_count };
+  }
+
+  // Given index of a partition and its byte serialized public matrix M, computed by partitioned FrodoPIR server, this routine sets up FrodoPIR
+  // client for that partition, so that rows held by it can be enquired. Handing public matrix M of a partition again drops all pending queries
+  // for that partition. Returns false, if partition index is out of range.
+  [[nodiscard("Must use status of setting public matrix M of partition")]] bool set_partition_pub_mat_M(
+    const size_t partition_idx,
+    std::span<const uint8_t, PUBLIC_MATRIX_M_BYTE_LEN> pub_matM_bytes)
+  {
+    if (partition_idx >= NUM_PARTITIONS) {
+      return false;
+    }
+
+    this->partitions[partition_idx] =
+      partition_client_t::setup_lowmem(this->seed_μ, pub_matM_bytes, partition_client_t::DEFAULT_A_ROW_BLOCK_LEN, this->A_expansion_mode);
+    this->partitions[partition_idx]->set_thread_pool(*this->pool);
+
+    return true;
+  }
+
+  // Returns truth value, denoting whether public matrix M of the partition has been handed to this client.
+  forceinline bool has_partition_pub_mat_M(const size_t partition_idx) const
+  {
+    return (partition_idx < NUM_PARTITIONS) && this->partitions[partition_idx].has_value();
+  }
+
+  // Sets the thread pool, which is used for preparing queries. It must outlive this client handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    this->pool = &pool;
+    for (auto& partition : this->partitions) {
+      if (partition.has_value()) {
+        partition->set_thread_pool(pool);
+      }
+    }
+  }
+
+  // Given a database row index, this routine prepares a query for it, using FrodoPIR client of the partition holding it. Returns false, if
+  // row index is out of range, public matrix M of its partition is not yet known or `client_t::prepare_query` fails.
+  [[nodiscard("Must use status of query preparation")]] bool prepare_query(const size_t db_row_index, csprng::csprng_t& csprng)
+  {
+    auto* const partition = this->partition_of(db_row_index);
+    return (partition != nullptr) && partition->prepare_query(locate(db_row_index).second, csprng);
+  }
+
+  // Given `n` -many database row indices, this routine prepares queries for all of them, using FrodoPIR clients of partitions holding them.
+  // Secret vectors of queries for all partitions are stacked s.t. their products with public matrix A, which is shared by all partitions,
+  // are computed in a single pass, expanding A from seed only once, instead of once per enquired partition. Returns status of query
+  // preparation, for each row index, in order, which is false, if row index is out of range, public matrix M of its partition is not yet
+  // known or `client_t::prepare_query` fails.
+  [[nodiscard("Must use status of query preparation for DB row indices")]] std::vector<bool> prepare_query(std::span<const size_t> db_row_indices,
+                                                                                                           csprng::csprng_t& csprng)
+  {
+    using secret_vec_t = typename partition_client_t::secret_vec_t;
+    using error_vec_t = typename partition_client_t::error_vec_t;
+
+    std::vector<bool> query_prep_status(db_row_indices.size(), false);
+
+    // Positions of row indices in `db_row_indices`, grouped by partition, holding them.
+    std::vector<std::vector<size_t>> partition_q_indices(NUM_PARTITIONS);
+    size_t num_queries = 0;
+
+    for (size_t q_idx = 0; q_idx < db_row_indices.size(); q_idx++) {
+      if (this->partition_of(db_row_indices[q_idx]) != nullptr) {
+        partition_q_indices[locate(db_row_indices[q_idx]).first].push_back(q_idx);
+        num_queries++;
+      }
+    }
+
+    if (num_queries == 0) {
+      return query_prep_status;
+    }
+
+    std::vector<secret_vec_t> S;
+    std::vector<error_vec_t> B;
+
+    S.reserve(num_queries);
+    B.reserve(num_queries);
+
+    for (size_t b_idx = 0; b_idx < num_queries; b_idx++) {
+      S.push_back(secret_vec_t::sample_from_uniform_ternary_distribution(csprng)); // secret vector
+      B.push_back(error_vec_t::sample_from_uniform_ternary_distribution(csprng));  // error vector
+    }
+
+    // B = S * A + E, where B is initialized with E
+    frodoPIR_client::accumulate_secrets_x_expanded_pub_mat_A<partition_entry_count>(
+      this->seed_μ, S, B, partition_client_t::DEFAULT_A_ROW_BLOCK_LEN, *this->pool, this->A_expansion_mode);
+
+    // Secret and row vectors are handed to clients of partitions, in order, each computing only S * M, using its own public matrix M.
+    size_t b_offset = 0;
+
+    for (size_t p_idx = 0; p_idx < NUM_PARTITIONS; p_idx++) {
+      const auto& q_indices = partition_q_indices[p_idx];
+      if (q_indices.empty()) {
+        continue;
+      }
+
+      std::vector<size_t> partition_row_indices(q_indices.size());
+      for (size_t i = 0; i < q_indices.size(); i++) {
+        partition_row_indices[i] = locate(db_row_indices[q_indices[i]]).second;
+      }
+
+      const auto partition_query_prep_status = this->partitions[p_idx]->prepare_query(partition_row_indices,
+                                                                                      std::span<const secret_vec_t>(S).subspan(b_offset, q_indices.size()),
+                                                                                      std::span<const error_vec_t>(B).subspan(b_offset, q_indices.size()));
+      for (size_t i = 0; i < q_indices.size(); i++) {
+        query_prep_status[q_indices[i]] = partition_query_prep_status[i];
+      }
+
+      b_offset += q_indices.size();
+    }
+
+    return query_prep_status;
+  }
+
+  // Given a database row index, for which query has already been prepared, this routine finalizes the query, for the partition holding it,
+  // which is to be responded to, using `partitioned_server_t::respond`, along with index of the partition, as returned by `locate`. So the
+  // server learns which partition is being enquired. Returns false, in same cases as `client_t::query`.
+  [[nodiscard("Must use status of query finalization")]] bool query(const size_t db_row_index, std::span<uint8_t, QUERY_BYTE_LEN> query_bytes)
+  {
+    auto* const partition = this->partition_of(db_row_index);
+    return (partition != nullptr) && partition->query(locate(db_row_index).second, query_bytes);
+  }
+
+  // Same as `query`, but writes `NUM_PARTITIONS` -many queries, one per partition, in order, concatenated, to be responded to, using
+  // `partitioned_server_t::respond_all`, so that the server doesn't even learn which partition is being enquired. Queries for all other
+  // partitions are dummies, sampled uniformly at random, which are indistinguishable from a real query, as vector `b` of a real query is
+  // itself pseudo-random, under LWE assumption. So dummies cost neither public matrix M of their partition nor expanding public matrix A.
+  // Returns false, without touching `queries_bytes`, if its byte length doesn't match or `query` fails.
+  [[nodiscard("Must use status of query finalization")]] bool query_all(const size_t db_row_index,
+                                                                        std::span<uint8_t> queries_bytes,
+                                                                        csprng::csprng_t& csprng)
+  {
+    if (queries_bytes.size() != NUM_PARTITIONS * QUERY_BYTE_LEN) {
+      return false;
+    }
+
+    const size_t partition_idx = locate(db_row_index).first;
+    if (!this->query(db_row_index, queries_bytes.subspan(partition_idx * QUERY_BYTE_LEN).template first<QUERY_BYTE_LEN>())) {
+      return false;
+    }
+
+    for (size_t p_idx = 0; p_idx < NUM_PARTITIONS; p_idx++) {
+      if (p_idx != partition_idx) {
+        csprng.generate(queries_bytes.subspan(p_idx * QUERY_BYTE_LEN, QUERY_BYTE_LEN));
+      }
+    }
+
+    return true;
+  }
+
+  // Given a database row index, for which query has already been sent to server, and server response for the partition holding it, this
+  // routine decodes the response, returning byte serialized content of queried row. Returns false, in same cases as `client_t::process_response`.
+  [[nodiscard("Must use status of response decoding")]] bool process_response(const size_t db_row_index,
+                                                                              std::span<const uint8_t, RESPONSE_BYTE_LEN> response_bytes,
+                                                                              std::span<uint8_t, db_entry_byte_len> db_row_bytes)
+  {
+    auto* const partition = this->partition_of(db_row_index);
+    return (partition != nullptr) && partition->process_response(locate(db_row_index).second, response_bytes, db_row_bytes);
+  }
+
+  // Same as `process_response`, but given `NUM_PARTITIONS` -many server responses, one per partition, as returned by
+  // `partitioned_server_t::respond_all`, it decodes the one for the partition holding the row, ignoring others.
+  [[nodiscard("Must use status of response decoding")]] bool process_response_all(const size_t db_row_index,
+                                                                                  std::span<const uint8_t> responses_bytes,
+                                                                                  std::span<uint8_t, db_entry_byte_len> db_row_bytes)
+  {
+    if (responses_bytes.size() != NUM_PARTITIONS * RESPONSE_BYTE_LEN) {
+      return false;
+    }
+
+    const size_t partition_idx = locate(db_row_index).first;
+    return this->process_response(
+      db_row_index, responses_bytes.subspan(partition_idx * RESPONSE_BYTE_LEN).template first<RESPONSE_BYTE_LEN>(), db_row_bytes);
+  }
+
+private:
+  std::array<uint8_t, frodoPIR_client::SEED_BYTE_LEN> seed_μ{};
+  frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential;
+  std::vector<std::optional<partition_client_t>> partitions{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+
+  // Returns FrodoPIR client of the partition holding given database row, or nullptr, if row index is out of range or public matrix M of its
+  // partition is not yet known.
+  forceinline partition_client_t* partition_of(const size_t db_row_index)
+  {
+    if (db_row_index >= db_entry_count) {
+      return nullptr;
+    }
+
+    auto& partition = this->partitions[locate(db_row_index).first];
+    return partition.has_value() ? &*partition : nullptr;
+  }
+};
+
+}
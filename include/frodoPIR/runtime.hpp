@@ -0,0 +1,567 @@
+#pragma once
+#include "frodoPIR/client.hpp"
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/matrix/serialization.hpp"
+#include "frodoPIR/internals/matrix/simd.hpp"
+#include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/csprng.hpp"
+#include "frodoPIR/internals/utility/params.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/internals/utility/utils.hpp"
+#include "frodoPIR/server.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace frodoPIR_runtime {
+
+static constexpr size_t λ = frodoPIR_server::λ;
+static constexpr size_t LWE_DIMENSION = frodoPIR_server::LWE_DIMENSION;
+static constexpr size_t SEED_BYTE_LEN = frodoPIR_server::SEED_BYTE_LEN;
+static constexpr size_t DEFAULT_A_ROW_BLOCK_LEN = 16;
+
+// For all recommended parameter sets, each element of parsed database matrix fits in 16 bits.
+using parsed_db_elem_t = uint16_t;
+
+// FrodoPIR parameters, only known at runtime. Database can have entries of any byte length, while number of entries and bit length of each
+// parsed database matrix element must be one of the recommended parameter sets, accepted by `frodoPIR_params::check_frodoPIR_params`. Public
+// matrix A is expanded from seed as per `A_expansion_mode`, on both server and clients.
+struct params_t
+{
+  size_t db_entry_count = 0;
+  size_t db_entry_byte_len = 0;
+  size_t mat_element_bitlen = 0;
+  frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential;
+
+  // Returns truth value, denoting whether these parameters are usable for instantiating FrodoPIR.
+  forceinline constexpr bool is_valid() const
+  {
+    return (this->db_entry_byte_len > 0) && frodoPIR_params::check_frodoPIR_params(this->db_entry_count, this->mat_element_bitlen) &&
+           frodoPIR_matrix::is_valid_expansion_mode(static_cast<uint32_t>(this->A_expansion_mode));
+  }
+
+  forceinline constexpr size_t num_columns_in_parsed_db() const
+  {
+    return frodoPIR_matrix::get_required_num_columns(this->db_entry_byte_len, this->mat_element_bitlen);
+  }
+  forceinline constexpr size_t original_db_byte_len() const { return this->db_entry_count * this->db_entry_byte_len; }
+  forceinline constexpr size_t public_matrix_M_byte_len() const { return LWE_DIMENSION * this->num_columns_in_parsed_db() * sizeof(frodoPIR_matrix::zq_t); }
+  forceinline constexpr size_t query_byte_len() const { return this->db_entry_count * sizeof(frodoPIR_matrix::zq_t); }
+  forceinline constexpr size_t response_byte_len() const { return this->num_columns_in_parsed_db() * sizeof(frodoPIR_matrix::zq_t); }
+};
+
+// Kernels, specialized for one of the recommended parameter sets, which fixes number of database entries and bit length of each parsed
+// database matrix element, leaving only byte length of database entries to be known at runtime.
+struct kernels_t
+{
+  // Parses byte serialized database into transposed parsed database matrix, of dimension `num_columns_in_parsed_db x db_entry_count`.
+  void (*parse_db_bytes_transposed)(std::span<const uint8_t> db_bytes,
+                                    size_t db_entry_byte_len,
+                                    parsed_db_elem_t* D_transposed,
+                                    frodoPIR_thread_pool::thread_pool_t& pool);
+
+  // Computes public matrix M = A * D, of dimension `LWE_DIMENSION x num_columns_in_parsed_db`, expanding A from seed, a block of rows at a time.
+  void (*compute_pub_mat_M)(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                            frodoPIR_matrix::expansion_mode_t A_expansion_mode,
+                            const parsed_db_elem_t* D_transposed,
+                            size_t num_columns_in_parsed_db,
+                            std::span<frodoPIR_matrix::zq_t> M,
+                            frodoPIR_thread_pool::thread_pool_t& pool);
+
+  // Given k -many secret vectors S_i, samples k -many error vectors E_i, writing B_i = S_i * A + E_i, each of `db_entry_count` -many elements,
+  // to `B`, one after another, expanding A from seed, `A_row_block_len` -many rows at a time.
+  void (*compute_secrets_x_pub_mat_A)(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                      frodoPIR_matrix::expansion_mode_t A_expansion_mode,
+                                      std::span<const frodoPIR_vector::row_vector_t<LWE_DIMENSION>> S,
+                                      std::span<frodoPIR_matrix::zq_t> B,
+                                      size_t A_row_block_len,
+                                      csprng::csprng_t& csprng,
+                                      frodoPIR_thread_pool::thread_pool_t& pool);
+
+  // Serializes a decoded row of parsed database matrix into a database entry.
+  void (*serialize_db_row)(std::span<const frodoPIR_matrix::zq_t> db_row, std::span<uint8_t> db_row_bytes);
+};
+
+// Kernels for a recommended parameter set, instantiated at compile-time.
+template<size_t db_entry_count, size_t mat_element_bitlen>
+  requires(frodoPIR_params::check_frodoPIR_params(db_entry_count, mat_element_bitlen) &&
+           std::same_as<frodoPIR_serialization::parsed_db_elem_t<mat_element_bitlen>, parsed_db_elem_t>)
+struct param_set_kernels_t
+{
+  static void parse_db_bytes_transposed(std::span<const uint8_t> db_bytes,
+                                        const size_t db_entry_byte_len,
+                                        parsed_db_elem_t* const D_transposed,
+                                        frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    frodoPIR_serialization::parse_db_rows_transposed<mat_element_bitlen>(db_bytes, db_entry_byte_len, D_transposed, db_entry_count, pool);
+  }
+
+  static void compute_pub_mat_M(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                const frodoPIR_matrix::expansion_mode_t A_expansion_mode,
+                                const parsed_db_elem_t* const D_transposed,
+                                const size_t num_columns_in_parsed_db,
+                                std::span<frodoPIR_matrix::zq_t> M,
+                                frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    constexpr size_t A_row_block_len = 64;
+    using A_row_t = frodoPIR_vector::row_vector_t<db_entry_count>;
+
+    frodoPIR_matrix::matrix_row_stream_t<db_entry_count, λ> A_row_stream(seed_μ, A_expansion_mode);
+
+    std::vector<A_row_t> A_row_block(A_row_block_len);
+    std::array<const frodoPIR_matrix::zq_t*, A_row_block_len> A_rows{};
+    std::array<frodoPIR_matrix::zq_t*, A_row_block_len> M_rows{};
+
+    std::ranges::fill(M, frodoPIR_matrix::zq_t{});
+
+    for (size_t r_idx_begin = 0; r_idx_begin < LWE_DIMENSION; r_idx_begin += A_row_block_len) {
+      const size_t num_rows_in_block = std::min(A_row_block_len, LWE_DIMENSION - r_idx_begin);
+
+      A_row_stream.next_rows(num_rows_in_block, [&](const size_t r_idx) { return A_row_block[r_idx].row(0); }, pool);
+      for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+        A_rows[r_idx] = A_row_block[r_idx].row(0).data();
+        M_rows[r_idx] = M.data() + (r_idx_begin + r_idx) * num_columns_in_parsed_db;
+      }
+
+      // Row i of M = (row i of A) x D = (row i of A) x (transposed D)^T
+      frodoPIR_matrix::row_vectors_x_transposed_rows(std::span<const frodoPIR_matrix::zq_t* const>(A_rows).first(num_rows_in_block),
+                                                     D_transposed,
+                                                     num_columns_in_parsed_db,
+                                                     db_entry_count,
+                                                     std::span<frodoPIR_matrix::zq_t* const>(M_rows).first(num_rows_in_block),
+                                                     pool);
+    }
+  }
+
+  static void compute_secrets_x_pub_mat_A(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                          const frodoPIR_matrix::expansion_mode_t A_expansion_mode,
+                                          std::span<const frodoPIR_vector::row_vector_t<LWE_DIMENSION>> S,
+                                          std::span<frodoPIR_matrix::zq_t> B,
+                                          const size_t A_row_block_len,
+                                          csprng::csprng_t& csprng,
+                                          frodoPIR_thread_pool::thread_pool_t& pool)
+  {
+    using error_vec_t = frodoPIR_vector::row_vector_t<db_entry_count>;
+
+    std::vector<error_vec_t> E;
+    E.reserve(S.size());
+
+    for (size_t b_idx = 0; b_idx < S.size(); b_idx++) {
+      E.push_back(error_vec_t::sample_from_uniform_ternary_distribution(csprng));
+    }
+
+    // B = S * A + E, where B is initialized with E
+    frodoPIR_client::accumulate_secrets_x_expanded_pub_mat_A<db_entry_count>(seed_μ, S, std::span(E), A_row_block_len, pool, A_expansion_mode);
+
+    for (size_t b_idx = 0; b_idx < S.size(); b_idx++) {
+      std::ranges::copy(E[b_idx].row(0), B.begin() + static_cast<ptrdiff_t>(b_idx * db_entry_count));
+    }
+  }
+
+  static void serialize_db_row(std::span<const frodoPIR_matrix::zq_t> db_row, std::span<uint8_t> db_row_bytes)
+  {
+    frodoPIR_serialization::serialize_db_row<mat_element_bitlen, frodoPIR_matrix::zq_t>(db_row, db_row_bytes);
+  }
+
+  static constexpr kernels_t kernels{
+    .parse_db_bytes_transposed = parse_db_bytes_transposed,
+    .compute_pub_mat_M = compute_pub_mat_M,
+    .compute_secrets_x_pub_mat_A = compute_secrets_x_pub_mat_A,
+    .serialize_db_row = serialize_db_row,
+  };
+};
+
+// Given FrodoPIR parameters, this routine returns kernels specialized for them, or nullptr, if parameters are not valid.
+forceinline const kernels_t*
+get_kernels(const params_t& params)
+{
+  if (!params.is_valid()) {
+    return nullptr;
+  }
+
+  switch (params.db_entry_count) {
+    case 1ul << 16:
+      return &param_set_kernels_t<1ul << 16, 10>::kernels;
+    case 1ul << 17:
+      return &param_set_kernels_t<1ul << 17, 10>::kernels;
+    case 1ul << 18:
+      return &param_set_kernels_t<1ul << 18, 10>::kernels;
+    case 1ul << 19:
+      return &param_set_kernels_t<1ul << 19, 9>::kernels;
+    case 1ul << 20:
+      return &param_set_kernels_t<1ul << 20, 9>::kernels;
+    default:
+      return nullptr;
+  }
+}
+
+// Frodo *P*rivate *I*nformation *R*etrieval Server, whose parameters are only known at runtime. Same as `frodoPIR_server::server_t`, it keeps
+// transposed parsed database matrix, responding to queries using the fastest vector kernel, supported by the CPU, while setup is dispatched
+// to kernels specialized for the parameter set. So a single binary can serve databases of many shapes, without instantiating `server_t` for
+// each of them. Byte serialized public matrix M, query and response are same as those of `server_t`, for same parameters.
+class server_t
+{
+public:
+  server_t() = default;
+
+  // Given FrodoPIR parameters, a `λ` -bit seed and a byte serialized database, this routine sets up FrodoPIR server, returning its handle
+  // and byte serialized public matrix M. Public matrix A is expanded from seed a block of rows at a time, never materializing it in full.
+  // Returns nothing, if parameters are not valid or byte length of database doesn't match them.
+  static std::optional<std::pair<server_t, std::vector<uint8_t>>> setup(
+    const params_t& params,
+    std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+    std::span<const uint8_t> db_bytes,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+  {
+    const auto* kernels = get_kernels(params);
+    if ((kernels == nullptr) || (db_bytes.size() != params.original_db_byte_len())) {
+      return std::nullopt;
+    }
+
+    const size_t num_columns = params.num_columns_in_parsed_db();
+
+    server_t server{};
+    server.params = params;
+    server.D = std::vector<parsed_db_elem_t>(num_columns * params.db_entry_count);
+    server.set_thread_pool(pool);
+
+    kernels->parse_db_bytes_transposed(db_bytes, params.db_entry_byte_len, server.D.data(), pool);
+
+    std::vector<frodoPIR_matrix::zq_t> M(LWE_DIMENSION * num_columns);
+    kernels->compute_pub_mat_M(seed_μ, params.A_expansion_mode, server.D.data(), num_columns, M, pool);
+
+    std::vector<uint8_t> M_bytes(params.public_matrix_M_byte_len());
+    for (size_t e_idx = 0; e_idx < M.size(); e_idx++) {
+      frodoPIR_utils::to_le_bytes(M[e_idx], std::span(M_bytes).subspan(e_idx * sizeof(frodoPIR_matrix::zq_t), sizeof(frodoPIR_matrix::zq_t)));
+    }
+
+    return std::make_pair(std::move(server), std::move(M_bytes));
+  }
+
+  // Returns parameters, this server is set up with.
+  forceinline const params_t& get_params() const { return this->params; }
+
+  // Sets the thread pool, which is used for responding to client queries. It must outlive this server handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool) { this->pool = &pool; }
+
+  // Given byte serialized client query, this routine responds back to it, producing byte serialized server response. Same as
+  // `frodoPIR_server::server_t::respond`, query is read and response is accumulated right where they are, as long as both buffers are aligned
+  // to `zq_t`. Returns false, without touching `response_bytes`, if byte length of either buffer doesn't match parameters of this server.
+  [[nodiscard("Must use status of query response")]] bool respond(std::span<const uint8_t> query_bytes, std::span<uint8_t> response_bytes) const
+  {
+    if ((query_bytes.size() != this->params.query_byte_len()) || (response_bytes.size() != this->params.response_byte_len())) {
+      return false;
+    }
+
+    const size_t num_columns = this->params.num_columns_in_parsed_db();
+
+    const frodoPIR_matrix::zq_const_view_t b_tilda(query_bytes);
+    const frodoPIR_matrix::zq_view_t c_tilda(response_bytes);
+
+    const std::array<const frodoPIR_matrix::zq_t*, 1> b_tilda_rows{ b_tilda.data() };
+    const std::array<frodoPIR_matrix::zq_t*, 1> c_tilda_rows{ c_tilda.data() };
+
+    std::fill_n(c_tilda.data(), num_columns, frodoPIR_matrix::zq_t{});
+    frodoPIR_matrix::row_vectors_x_transposed_rows(std::span<const frodoPIR_matrix::zq_t* const>(b_tilda_rows),
+                                                   this->D.data(),
+                                                   num_columns,
+                                                   this->params.db_entry_count,
+                                                   std::span<frodoPIR_matrix::zq_t* const>(c_tilda_rows),
+                                                   *this->pool);
+
+    return true;
+  }
+
+  // Given k -many byte serialized client queries, concatenated, this routine responds to all of them in a single pass over the processed
+  // database, writing k -many byte serialized server responses, concatenated in same order. Returns false, without touching `responses_bytes`,
+  // if input and output buffers don't hold same number of queries and responses, respectively.
+  [[nodiscard("Must use status of batched query response")]] bool respond_batch(std::span<const uint8_t> queries_bytes,
+                                                                                std::span<uint8_t> responses_bytes) const
+  {
+    const size_t query_byte_len = this->params.query_byte_len();
+    const size_t response_byte_len = this->params.response_byte_len();
+
+    if ((query_byte_len == 0) || ((queries_bytes.size() % query_byte_len) != 0) || ((responses_bytes.size() % response_byte_len) != 0)) {
+      return false;
+    }
+
+    const size_t batch_size = queries_bytes.size() / query_byte_len;
+    if (batch_size != (responses_bytes.size() / response_byte_len)) {
+      return false;
+    }
+
+    const size_t db_entry_count = this->params.db_entry_count;
+    const size_t num_columns = this->params.num_columns_in_parsed_db();
+
+    const frodoPIR_matrix::zq_const_view_t b_tildas_view(queries_bytes);
+    const frodoPIR_matrix::zq_view_t c_tildas_view(responses_bytes);
+
+    const auto* b_tildas = b_tildas_view.data();
+    auto* c_tildas = c_tildas_view.data();
+
+    std::vector<const frodoPIR_matrix::zq_t*> b_tilda_rows(batch_size);
+    std::vector<frodoPIR_matrix::zq_t*> c_tilda_rows(batch_size);
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      b_tilda_rows[b_idx] = b_tildas + b_idx * db_entry_count;
+      c_tilda_rows[b_idx] = c_tildas + b_idx * num_columns;
+    }
+
+    std::fill_n(c_tildas, batch_size * num_columns, frodoPIR_matrix::zq_t{});
+    frodoPIR_matrix::row_vectors_x_transposed_rows(std::span<const frodoPIR_matrix::zq_t* const>(b_tilda_rows),
+                                                   this->D.data(),
+                                                   num_columns,
+                                                   db_entry_count,
+                                                   std::span<frodoPIR_matrix::zq_t* const>(c_tilda_rows),
+                                                   *this->pool);
+
+    return true;
+  }
+
+private:
+  params_t params{};
+
+  // Transposed parsed database matrix, of dimension `num_columns_in_parsed_db x db_entry_count`, in row-major order.
+  std::vector<parsed_db_elem_t> D{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+};
+
+// Frodo *P*rivate *I*nformation *R*etrieval Client, whose parameters are only known at runtime, talking to a FrodoPIR server, set up with same
+// parameters, be it `server_t` of this namespace or `frodoPIR_server::server_t`. Same as low-memory `frodoPIR_client::client_t`, it only keeps
+// the seed and public matrix M, expanding rows of public matrix A from the seed, using kernels specialized for the parameter set, while
+// preparing queries.
+class client_t
+{
+public:
+  client_t() = default;
+
+  // Given FrodoPIR parameters, a `λ` -bit seed and a byte serialized public matrix M, computed by FrodoPIR server, this routine sets up FrodoPIR
+  // client. Returns nothing, if parameters are not valid or byte length of public matrix M doesn't match them.
+  static std::optional<client_t> setup(const params_t& params,
+                                       std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                       std::span<const uint8_t> pub_matM_bytes,
+                                       const size_t A_row_block_len = DEFAULT_A_ROW_BLOCK_LEN)
+  {
+    const auto* kernels = get_kernels(params);
+    if ((kernels == nullptr) || (pub_matM_bytes.size() != params.public_matrix_M_byte_len()) || (A_row_block_len == 0)) {
+      return std::nullopt;
+    }
+
+    client_t client{};
+    client.params = params;
+    client.kernels = kernels;
+    client.A_row_block_len = A_row_block_len;
+    std::ranges::copy(seed_μ, client.seed_μ.begin());
+
+    client.M.resize(LWE_DIMENSION * params.num_columns_in_parsed_db());
+    for (size_t e_idx = 0; e_idx < client.M.size(); e_idx++) {
+      client.M[e_idx] = frodoPIR_utils::from_le_bytes<frodoPIR_matrix::zq_t>(pub_matM_bytes.subspan(e_idx * sizeof(frodoPIR_matrix::zq_t)));
+    }
+
+    return client;
+  }
+
+  // Returns parameters, this client is set up with.
+  forceinline const params_t& get_params() const { return this->params; }
+
+  // Sets the thread pool, which is used for preparing queries. It must outlive this client handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool) { this->pool = &pool; }
+
+  // Given `n` -many database row indices, this routine prepares `n` -many queries, for enquiring their values, returning status of query
+  // preparation for each of them, in order. A query can't be prepared for an index, which is out of range or for which a query has already
+  // been prepared. Public matrix A is expanded only once per batch.
+  [[nodiscard("Must use status of query preparation for DB row indices")]] std::vector<bool> prepare_query(std::span<const size_t> db_row_indices,
+                                                                                                           csprng::csprng_t& csprng)
+  {
+    using secret_vec_t = frodoPIR_vector::row_vector_t<LWE_DIMENSION>;
+
+    std::vector<bool> query_prep_status;
+    query_prep_status.reserve(db_row_indices.size());
+
+    std::vector<size_t> preparable_db_row_indices;
+    std::unordered_set<size_t> seen_db_row_indices;
+
+    for (const auto db_row_index : db_row_indices) {
+      const bool is_preparable = (db_row_index < this->params.db_entry_count) && !this->queries.contains(db_row_index) &&
+                                 seen_db_row_indices.insert(db_row_index).second;
+
+      query_prep_status.push_back(is_preparable);
+      if (is_preparable) {
+        preparable_db_row_indices.push_back(db_row_index);
+      }
+    }
+
+    const size_t batch_size = preparable_db_row_indices.size();
+    if (batch_size == 0) {
+      return query_prep_status;
+    }
+
+    const size_t db_entry_count = this->params.db_entry_count;
+    const size_t num_columns = this->params.num_columns_in_parsed_db();
+
+    std::vector<secret_vec_t> S;
+    S.reserve(batch_size);
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      S.push_back(secret_vec_t::sample_from_uniform_ternary_distribution(csprng));
+    }
+
+    // B = S * A + E
+    std::vector<frodoPIR_matrix::zq_t> B(batch_size * db_entry_count);
+    this->kernels->compute_secrets_x_pub_mat_A(this->seed_μ, this->params.A_expansion_mode, S, B, this->A_row_block_len, csprng, *this->pool);
+
+    // C = S * M, where S is ternary
+    std::vector<std::vector<frodoPIR_matrix::zq_t>> C(batch_size, std::vector<frodoPIR_matrix::zq_t>(num_columns));
+    this->accumulate_secrets_x_pub_mat_M(S, C);
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      const auto b_begin = B.begin() + static_cast<ptrdiff_t>(b_idx * db_entry_count);
+
+      this->queries[preparable_db_row_indices[b_idx]] = query_t{
+        .status = frodoPIR_client::query_status_t::prepared,
+        .b = std::vector<frodoPIR_matrix::zq_t>(b_begin, b_begin + static_cast<ptrdiff_t>(db_entry_count)),
+        .c = std::move(C[b_idx]),
+      };
+    }
+
+    return query_prep_status;
+  }
+
+  // Given a database row index, this routine prepares a query for it. Returns false, if row index is out of range or a query has already been
+  // prepared for it.
+  [[nodiscard("Must use status of query preparation")]] bool prepare_query(const size_t db_row_index, csprng::csprng_t& csprng)
+  {
+    const auto query_prep_status = this->prepare_query(std::span(&db_row_index, 1), csprng);
+    return query_prep_status[0];
+  }
+
+  // Given a database row index, for which query has already been prepared, this routine finalizes the query, writing byte serialized query,
+  // to be sent to server. Returns false, if query is not yet prepared or is already sent or byte length of `query_bytes` doesn't match.
+  [[nodiscard("Must use status of query finalization")]] bool query(const size_t db_row_index, std::span<uint8_t> query_bytes)
+  {
+    const auto it = this->queries.find(db_row_index);
+    if ((it == this->queries.end()) || (it->second.status != frodoPIR_client::query_status_t::prepared) ||
+        (query_bytes.size() != this->params.query_byte_len())) {
+      return false;
+    }
+
+    const auto rho = 1ul << this->params.mat_element_bitlen;
+    const auto query_indicator_value = static_cast<frodoPIR_matrix::zq_t>(frodoPIR_matrix::Q / rho);
+
+    auto& query = it->second;
+    query.b[db_row_index] += query_indicator_value;
+
+    for (size_t e_idx = 0; e_idx < query.b.size(); e_idx++) {
+      frodoPIR_utils::to_le_bytes(query.b[e_idx], query_bytes.subspan(e_idx * sizeof(frodoPIR_matrix::zq_t), sizeof(frodoPIR_matrix::zq_t)));
+    }
+
+    // b is not needed anymore, only c is, for decoding the response.
+    query.b = {};
+    query.status = frodoPIR_client::query_status_t::sent;
+
+    return true;
+  }
+
+  // Given a database row index, for which query has already been sent to server, and server response, this routine decodes the response,
+  // writing byte serialized content of queried row. Returns false, if query is not yet sent or byte length of either buffer doesn't match.
+  [[nodiscard("Must use status of response decoding")]] bool process_response(const size_t db_row_index,
+                                                                              std::span<const uint8_t> response_bytes,
+                                                                              std::span<uint8_t> db_row_bytes)
+  {
+    const auto it = this->queries.find(db_row_index);
+    if ((it == this->queries.end()) || (it->second.status != frodoPIR_client::query_status_t::sent) ||
+        (response_bytes.size() != this->params.response_byte_len()) || (db_row_bytes.size() != this->params.db_entry_byte_len)) {
+      return false;
+    }
+
+    // Rounding factor Q / ρ is a power of 2, so rounding to nearest multiple of it, with ties rounded down, is an addition and a shift.
+    const auto rounding_shift = static_cast<uint32_t>(std::numeric_limits<frodoPIR_matrix::zq_t>::digits - this->params.mat_element_bitlen);
+    const auto rounding_offset = (frodoPIR_matrix::zq_t(1) << (rounding_shift - 1)) - 1;
+
+    const size_t num_columns = this->params.num_columns_in_parsed_db();
+    std::vector<frodoPIR_matrix::zq_t> db_matrix_row(num_columns);
+
+    frodoPIR_simd::get_decode_response_kernel<frodoPIR_matrix::zq_t>()(
+      response_bytes.data(), it->second.c.data(), num_columns, rounding_offset, rounding_shift, db_matrix_row.data());
+
+    this->kernels->serialize_db_row(db_matrix_row, db_row_bytes);
+    this->queries.erase(it);
+
+    return true;
+  }
+
+private:
+  struct query_t
+  {
+    frodoPIR_client::query_status_t status = frodoPIR_client::query_status_t::prepared;
+    std::vector<frodoPIR_matrix::zq_t> b{};
+    std::vector<frodoPIR_matrix::zq_t> c{};
+  };
+
+  params_t params{};
+  const kernels_t* kernels = nullptr;
+  std::array<uint8_t, SEED_BYTE_LEN> seed_μ{};
+  std::vector<frodoPIR_matrix::zq_t> M{};
+  size_t A_row_block_len = DEFAULT_A_ROW_BLOCK_LEN;
+  std::unordered_map<size_t, query_t> queries{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+
+  // Given k -many secret vectors S_i, this routine computes S_i * M, accumulating them into corresponding vectors of `C`. Same as
+  // `frodoPIR_matrix::matrix_t::ternary_row_vectors_x_matrix`, columns of M are walked in tiles, distributed among threads of the pool, s.t.
+  // each row of a tile gets added to (or subtracted from) tiles of those vectors of `C`, for which matching coefficient is +1 (or -1).
+  void accumulate_secrets_x_pub_mat_M(std::span<const frodoPIR_vector::row_vector_t<LWE_DIMENSION>> S, std::span<std::vector<frodoPIR_matrix::zq_t>> C) const
+  {
+    constexpr size_t tile_width = 512;
+
+    const size_t num_columns = this->params.num_columns_in_parsed_db();
+    const size_t batch_size = std::min(S.size(), C.size());
+
+    if (batch_size == 0) {
+      return;
+    }
+
+    const frodoPIR_matrix::ternary_index_t<LWE_DIMENSION> S_index(S.first(batch_size));
+    const auto kernel = frodoPIR_simd::get_ternary_accumulate_row_kernel<frodoPIR_matrix::zq_t>();
+
+    std::vector<frodoPIR_matrix::zq_t*> C_rows(batch_size);
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      C_rows[b_idx] = C[b_idx].data();
+    }
+
+    this->pool->parallel_for(
+      num_columns,
+      [&](const size_t c_idx_begin, const size_t c_idx_end) {
+        for (size_t tile_begin = c_idx_begin; tile_begin < c_idx_end; tile_begin += tile_width) {
+          const size_t tile_end = std::min(tile_begin + tile_width, c_idx_end);
+
+          for (size_t r_idx = 0; r_idx < LWE_DIMENSION; r_idx++) {
+            const auto positives = S_index.positives(r_idx);
+            const auto negatives = S_index.negatives(r_idx);
+
+            kernel(this->M.data() + r_idx * num_columns + tile_begin,
+                   tile_end - tile_begin,
+                   C_rows.data(),
+                   tile_begin,
+                   positives.data(),
+                   positives.size(),
+                   negatives.data(),
+                   negatives.size());
+          }
+        }
+      },
+      tile_width);
+  }
+};
+
+}
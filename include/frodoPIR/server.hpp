@@ -2,11 +2,26 @@
 #include "frodoPIR/internals/matrix/matrix.hpp"
 #include "frodoPIR/internals/matrix/serialization.hpp"
 #include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/mmap.hpp"
 #include "frodoPIR/internals/utility/params.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/internals/utility/utils.hpp"
+#include "sha3/turboshake128.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
 #include <span>
+#include <string_view>
+#include <system_error>
 #include <utility>
+#include <vector>
 
 namespace frodoPIR_server {
 
@@ -14,6 +29,39 @@ static constexpr size_t λ = 128;
 static constexpr size_t LWE_DIMENSION = 1774;
 static constexpr size_t SEED_BYTE_LEN = λ / std::numeric_limits<uint8_t>::digits;
 
+// On-disk format of FrodoPIR server state, written by `server_t::save`, is as follows, with all integers in little-endian.
+//
+// - Header, padded with zeros to a page
+//   - Magic bytes "FRODOPIR"                                         : 8 bytes
+//   - Format version                                                 : 4 bytes
+//   - Expansion mode of public matrix A, see `expansion_mode_t`      : 4 bytes
+//   - Number of database entries                                     : 8 bytes
+//   - Byte length of each database entry                             : 8 bytes
+//   - Bit length of each parsed database matrix element              : 8 bytes
+//   - LWE dimension                                                  : 8 bytes
+//   - Byte length of each parsed database matrix element             : 8 bytes
+//   - Offset and byte length of transposed parsed database matrix    : 8 + 8 bytes
+//   - Offset and byte length of public matrix M                      : 8 + 8 bytes
+//   - Seed of public matrix A                                        : 16 bytes
+//   - TurboSHAKE128 digest of all of above, D and M                  : 32 bytes
+// - Transposed parsed database matrix D, page aligned, in row-major order
+// - Public matrix M, page aligned, in row-major order
+//
+// As D is written as it's held in memory and is mapped right back into memory, to respond from, without any conversion, saving and opening
+// server state is only supported on little-endian hosts, so that a file is never misread due to byte order mismatch.
+static constexpr std::string_view SERVER_FILE_MAGIC = "FRODOPIR";
+static constexpr uint32_t SERVER_FILE_VERSION = 1;
+static constexpr size_t SERVER_FILE_PAGE_BYTE_LEN = 4096;
+static constexpr size_t SERVER_FILE_CHECKSUM_BYTE_LEN = 32;
+
+// Options for opening FrodoPIR server state file, using `server_t::open_mmap`.
+struct mmap_options_t
+{
+  bool populate = false;       // Read whole file into page cache, while mapping it, instead of taking page faults while responding.
+  bool huge_pages = false;     // Advise kernel to back the mapping using transparent huge pages, reducing TLB misses.
+  bool verify_checksum = true; // Verify checksum of the file, which requires reading all of it once.
+};
+
 // Frodo *P*rivate *I*nformation *R*etrieval Server
 template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
   requires(frodoPIR_params::check_frodoPIR_params(db_entry_count, mat_element_bitlen))
@@ -29,10 +77,24 @@ public:
   // Type aliases.
   using pub_mat_A_t = frodoPIR_matrix::matrix_t<LWE_DIMENSION, db_entry_count>;
   using pub_mat_M_t = frodoPIR_matrix::matrix_t<LWE_DIMENSION, NUM_COLUMNS_IN_PARSED_DB>;
-  using parsed_db_transposed_mat_t = frodoPIR_matrix::matrix_t<NUM_COLUMNS_IN_PARSED_DB, db_entry_count>;
+  using pub_mat_M_delta_t = frodoPIR_matrix::low_rank_delta_t<LWE_DIMENSION, NUM_COLUMNS_IN_PARSED_DB>;
+  using parsed_db_transposed_mat_t = frodoPIR_serialization::parsed_db_transposed_mat_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
   using query_t = frodoPIR_vector::row_vector_t<db_entry_count>;
+  using response_t = frodoPIR_vector::row_vector_t<NUM_COLUMNS_IN_PARSED_DB>;
+  using parsed_db_elem_t = frodoPIR_serialization::parsed_db_elem_t<mat_element_bitlen>;
+  using parsed_db_transposed_view_t = frodoPIR_matrix::matrix_view_t<NUM_COLUMNS_IN_PARSED_DB, db_entry_count, parsed_db_elem_t>;
 
-  // Constructor(s)
+  // Layout of server state file.
+  static constexpr size_t FILE_CHECKSUM_OFFSET = 104;
+  static constexpr size_t FILE_D_OFFSET = SERVER_FILE_PAGE_BYTE_LEN;
+  static constexpr size_t FILE_D_BYTE_LEN = parsed_db_transposed_mat_t::get_byte_len();
+  static constexpr size_t FILE_M_OFFSET =
+    ((FILE_D_OFFSET + FILE_D_BYTE_LEN + (SERVER_FILE_PAGE_BYTE_LEN - 1)) / SERVER_FILE_PAGE_BYTE_LEN) * SERVER_FILE_PAGE_BYTE_LEN;
+  static constexpr size_t FILE_M_BYTE_LEN = pub_mat_M_t::get_byte_len();
+  static constexpr size_t FILE_BYTE_LEN = FILE_M_OFFSET + FILE_M_BYTE_LEN;
+
+  // Constructor(s). Server, constructed from a transposed parsed database matrix, doesn't know seed of public matrix A, so it can neither
+  // update rows nor be saved.
   explicit constexpr server_t(auto db)
     : D(std::move(db))
   {
@@ -47,28 +109,480 @@ public:
   // Given a `λ` -bit seed and a byte serialized database which has `db_entry_count` -many entries s.t.
   // each entry is of `db_entry_byte_len` -bytes, this routine can be used for setting up FrodoPIR server,
   // returning initialized server (ready to respond to client queries) handle and public matrix M, which will
-  // be used by clients for preprocessing queries.
-  static forceinline constexpr std::pair<server_t, pub_mat_M_t> setup(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
-                                                                      std::span<const uint8_t, ORIGINAL_DB_BYTE_LEN> db_bytes)
+  // be used by clients for preprocessing queries. Returned server handle uses `pool` for responding to queries. Public matrix A is expanded
+  // from seed as per `A_expansion_mode`, which is a public parameter, clients must be set up with. Database is parsed right into transposed
+  // form, which is multiplied with A as is, so parsed database matrix is neither materialized untransposed nor transposed afterwards.
+  static forceinline constexpr std::pair<server_t, pub_mat_M_t> setup(
+    std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+    std::span<const uint8_t, ORIGINAL_DB_BYTE_LEN> db_bytes,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    const auto A = pub_mat_A_t::template generate<λ>(seed_μ, A_expansion_mode, pool);
+    auto D_transposed = frodoPIR_serialization::parse_db_bytes_transposed<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes, pool);
+    const auto M = A.multiply_by_transposed(D_transposed, pool);
+
+    server_t server(std::move(D_transposed));
+    server.set_thread_pool(pool);
+    server.seed_μ.emplace();
+    std::ranges::copy(seed_μ, server.seed_μ->begin());
+    server.A_expansion_mode = A_expansion_mode;
+
+    return { std::move(server), M };
+  }
+
+  // Same as `setup`, but public matrix A is never materialized in full. Rather, `A_row_block_len` -many rows of A are expanded from seed at a
+  // time and fused with multiplication by parsed database matrix, producing corresponding rows of M. So peak memory usage is dominated by the
+  // parsed database matrix, instead of A, which is ~4x larger, while each cache resident tile of transposed D is reused for a whole block of A.
+  // Database is parsed right into transposed form, so parsed database matrix is materialized only once.
+  template<size_t A_row_block_len = 64>
+    requires(A_row_block_len > 0)
+  static forceinline std::pair<server_t, pub_mat_M_t> setup_streaming(
+    std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+    std::span<const uint8_t, ORIGINAL_DB_BYTE_LEN> db_bytes,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    using A_row_t = frodoPIR_vector::row_vector_t<db_entry_count>;
+    using M_row_t = frodoPIR_vector::row_vector_t<NUM_COLUMNS_IN_PARSED_DB>;
+
+    auto D_transposed = frodoPIR_serialization::parse_db_bytes_transposed<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes, pool);
+
+    frodoPIR_matrix::matrix_row_stream_t<db_entry_count, λ> A_row_stream(seed_μ, A_expansion_mode);
+    pub_mat_M_t M{};
+
+    std::vector<A_row_t> A_row_block(A_row_block_len);
+    std::vector<M_row_t> M_row_block(A_row_block_len);
+
+    for (size_t r_idx_begin = 0; r_idx_begin < LWE_DIMENSION; r_idx_begin += A_row_block_len) {
+      const size_t num_rows_in_block = std::min(A_row_block_len, LWE_DIMENSION - r_idx_begin);
+
+      A_row_stream.next_rows(num_rows_in_block, [&](const size_t r_idx) { return A_row_block[r_idx].row(0); }, pool);
+      for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+        std::ranges::fill(M_row_block[r_idx].row(0), frodoPIR_matrix::zq_t{});
+      }
+
+      // Row i of M = (row i of A) x D = (row i of A) x (transposed D)^T
+      A_row_t::row_vectors_x_transposed_matrix(std::span<const A_row_t>(A_row_block).first(num_rows_in_block),
+                                               D_transposed,
+                                               std::span(M_row_block).first(num_rows_in_block),
+                                               pool);
+
+      for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+        std::ranges::copy(M_row_block[r_idx].row(0), M.row(r_idx_begin + r_idx).begin());
+      }
+    }
+
+    server_t server(std::move(D_transposed));
+    server.set_thread_pool(pool);
+    server.seed_μ.emplace();
+    std::ranges::copy(seed_μ, server.seed_μ->begin());
+    server.A_expansion_mode = A_expansion_mode;
+
+    return { std::move(server), M };
+  }
+
+  // Given `n` -many database row indices and `n` -many new database rows, each of `db_entry_byte_len` -bytes, concatenated in same order, this
+  // routine replaces those rows of the database, patching transposed parsed database matrix in place, while returning delta of public matrix M,
+  // s.t. M_new = M_old + ΔM, which is to be applied by clients, using `client_t::apply_pub_mat_M_delta`. If same index appears more than once,
+  // last row wins. As M = A * D, only changed rows of D contribute to ΔM i.e. ΔM = A[:, indices] * ΔD[indices, :], which is returned in this
+  // factored form, taking (LWE_DIMENSION + NUM_COLUMNS_IN_PARSED_DB) x n elements, instead of a dense M.
+  //
+  // Note, columns of public matrix A can only be reached by expanding it from seed, so every call expands whole of A, once, no matter how many
+  // rows are updated, though without ever materializing it. That's as costly as setting up a client e.g. for 2^20 database rows, it squeezes
+  // ~7.4 GB out of the XOF, which is single-threaded, if A is expanded sequentially. So updates are better batched into as few calls as possible.
+  //
+  // Returns nothing, if any index is out of range, byte length of new rows doesn't match, server responds from a read-only memory-mapped file or
+  // seed of public matrix A isn't known, as server was constructed right from a parsed database matrix.
+  [[nodiscard("Must use delta of public matrix M, which is to be applied by clients")]] std::optional<pub_mat_M_delta_t> update_rows(
+    std::span<const size_t> db_row_indices,
+    std::span<const uint8_t> db_rows_bytes)
+  {
+    using parsed_db_row_t = std::array<parsed_db_elem_t, NUM_COLUMNS_IN_PARSED_DB>;
+    using A_row_t = frodoPIR_vector::row_vector_t<db_entry_count>;
+
+    const size_t num_updates = db_row_indices.size();
+
+    if (this->is_memory_mapped() || !this->seed_μ.has_value()) {
+      return std::nullopt;
+    }
+    if (db_rows_bytes.size() != num_updates * db_entry_byte_len) {
+      return std::nullopt;
+    }
+    if (std::ranges::any_of(db_row_indices, [](const size_t db_row_index) { return db_row_index >= db_entry_count; })) {
+      return std::nullopt;
+    }
+
+    auto M_delta = pub_mat_M_delta_t::zeros(num_updates);
+    if (num_updates == 0) {
+      return M_delta;
+    }
+
+    // Parse new rows and patch column `db_row_index` of transposed D, in order, recording ΔD over Zq, one row per update.
+    auto& D_delta = M_delta.V;
+    parsed_db_row_t parsed_db_row{};
+
+    for (size_t u_idx = 0; u_idx < num_updates; u_idx++) {
+      const size_t db_row_index = db_row_indices[u_idx];
+      const auto db_row_bytes = db_rows_bytes.subspan(u_idx * db_entry_byte_len).template first<db_entry_byte_len>();
+
+      frodoPIR_serialization::parse_db_row<db_entry_byte_len, mat_element_bitlen>(db_row_bytes, parsed_db_row);
+
+      for (size_t c_idx = 0; c_idx < NUM_COLUMNS_IN_PARSED_DB; c_idx++) {
+        auto& elem = (*this->D)[{ c_idx, db_row_index }];
+
+        D_delta[u_idx * NUM_COLUMNS_IN_PARSED_DB + c_idx] =
+          static_cast<frodoPIR_matrix::zq_t>(parsed_db_row[c_idx]) - static_cast<frodoPIR_matrix::zq_t>(elem);
+        elem = parsed_db_row[c_idx];
+      }
+    }
+
+    // Gather columns of A, at updated indices, expanding A from seed, one row at a time. Unless A is expanded sequentially, each thread expands
+    // its own range of rows.
+    auto& A_columns = M_delta.U;
+    const auto gather_A_columns = [&](const size_t r_idx, const A_row_t& A_row) {
+      for (size_t u_idx = 0; u_idx < num_updates; u_idx++) {
+        A_columns[r_idx * num_updates + u_idx] = A_row[db_row_indices[u_idx]];
+      }
+    };
+
+    if (this->A_expansion_mode == frodoPIR_matrix::expansion_mode_t::sequential) {
+      frodoPIR_matrix::matrix_row_stream_t<db_entry_count, λ> A_row_stream(*this->seed_μ);
+      A_row_t A_row{};
+
+      for (size_t r_idx = 0; r_idx < LWE_DIMENSION; r_idx++) {
+        A_row_stream.next(A_row.row(0));
+        gather_A_columns(r_idx, A_row);
+      }
+    } else {
+      this->pool->parallel_for(LWE_DIMENSION, [&](const size_t r_idx_begin, const size_t r_idx_end) {
+        A_row_t A_row{};
+
+        for (size_t r_idx = r_idx_begin; r_idx < r_idx_end; r_idx++) {
+          frodoPIR_matrix::matrix_row_stream_t<db_entry_count, λ>::expand_row(*this->seed_μ, r_idx, A_row.row(0));
+          gather_A_columns(r_idx, A_row);
+        }
+      });
+    }
+
+    return M_delta;
+  }
+
+  // Given a file path and public matrix M, returned by setup, this routine persists state of this server along with M, so that it can later
+  // be opened using `open_mmap`, without setting up the server again. File is first written next to `path` and then renamed, so that other
+  // processes never map a partially written file. Returns false, if the file can't be written or seed of public matrix A isn't known, as
+  // server was constructed right from a parsed database matrix.
+  [[nodiscard("Must use status of saving server state")]] bool save(const std::filesystem::path& path, const pub_mat_M_t& M) const
+    requires(std::endian::native == std::endian::little)
   {
-    const auto A = pub_mat_A_t::template generate<λ>(seed_μ);
-    const auto D = frodoPIR_serialization::parse_db_bytes<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes);
-    const auto M = A * D;
+    if (!this->seed_μ.has_value()) {
+      return false;
+    }
+
+    std::vector<uint8_t> M_bytes(FILE_M_BYTE_LEN, 0);
+    M.to_le_bytes(std::span<uint8_t, FILE_M_BYTE_LEN>(M_bytes));
+
+    const auto D_bytes = this->db_bytes();
+
+    auto header = encode_file_header(*this->seed_μ, this->A_expansion_mode);
+    const auto checksum = compute_file_checksum(std::span(header).template first<FILE_CHECKSUM_OFFSET>(), D_bytes, M_bytes);
+    std::ranges::copy(checksum, header.begin() + FILE_CHECKSUM_OFFSET);
 
-    return { server_t(D.transpose()), M };
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+      std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+      const std::vector<uint8_t> padding(FILE_M_OFFSET - (FILE_D_OFFSET + FILE_D_BYTE_LEN), 0);
+
+      file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+      file.write(reinterpret_cast<const char*>(D_bytes.data()), static_cast<std::streamsize>(D_bytes.size()));
+      file.write(reinterpret_cast<const char*>(padding.data()), static_cast<std::streamsize>(padding.size()));
+      file.write(reinterpret_cast<const char*>(M_bytes.data()), static_cast<std::streamsize>(M_bytes.size()));
+      file.flush();
+
+      if (!file.good()) {
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+      }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    return !ec;
+  }
+
+  // Given path to a file, written by `save`, this routine memory-maps it, returning server handle, which responds to queries right from the
+  // mapping (zero-copy), along with public matrix M. Many processes can open same file, sharing one copy of parsed database in page cache.
+  // Returns nothing, if file can't be mapped, doesn't belong to this parameter set or, when asked to verify, fails checksum verification.
+  static forceinline std::optional<std::pair<server_t, pub_mat_M_t>> open_mmap(
+    const std::filesystem::path& path,
+    const mmap_options_t options = {},
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global())
+    requires(std::endian::native == std::endian::little)
+  {
+    auto mapping = frodoPIR_mmap::mapped_file_t::open(path, options.populate, options.huge_pages);
+    if (!mapping) {
+      return std::nullopt;
+    }
+
+    const auto bytes = mapping->bytes();
+    if (bytes.size() != FILE_BYTE_LEN) {
+      return std::nullopt;
+    }
+
+    std::array<uint8_t, SEED_BYTE_LEN> seed_μ{};
+    std::ranges::copy(bytes.subspan(FILE_CHECKSUM_OFFSET - SEED_BYTE_LEN, SEED_BYTE_LEN), seed_μ.begin());
+
+    const auto A_expansion_mode_word = frodoPIR_utils::from_le_bytes<uint32_t>(bytes.subspan(12, 4));
+    if (!frodoPIR_matrix::is_valid_expansion_mode(A_expansion_mode_word)) {
+      return std::nullopt;
+    }
+    const auto A_expansion_mode = static_cast<frodoPIR_matrix::expansion_mode_t>(A_expansion_mode_word);
+
+    // All fields of header, but seed, expansion mode of A and checksum, are fixed for a parameter set.
+    const auto expected_header = encode_file_header(seed_μ, A_expansion_mode);
+    if (!std::ranges::equal(bytes.first(FILE_CHECKSUM_OFFSET), std::span(expected_header).first(FILE_CHECKSUM_OFFSET))) {
+      return std::nullopt;
+    }
+
+    const auto D_bytes = bytes.subspan(FILE_D_OFFSET, FILE_D_BYTE_LEN);
+    const auto M_bytes = bytes.subspan(FILE_M_OFFSET, FILE_M_BYTE_LEN);
+
+    if (options.verify_checksum) {
+      const auto checksum = compute_file_checksum(bytes.first(FILE_CHECKSUM_OFFSET), D_bytes, M_bytes);
+      if (!std::ranges::equal(checksum, bytes.subspan(FILE_CHECKSUM_OFFSET, SERVER_FILE_CHECKSUM_BYTE_LEN))) {
+        return std::nullopt;
+      }
+    }
+
+    server_t server(std::move(mapping), seed_μ);
+    server.set_thread_pool(pool);
+    server.A_expansion_mode = A_expansion_mode;
+
+    return std::make_pair(std::move(server), pub_mat_M_t::from_le_bytes(M_bytes.template first<FILE_M_BYTE_LEN>()));
+  }
+
+  // Returns mode, public matrix A is expanded from seed with, which clients must be set up with.
+  forceinline frodoPIR_matrix::expansion_mode_t get_expansion_mode() const { return this->A_expansion_mode; }
+
+  // Returns truth value, denoting whether this server responds to queries right from a memory-mapped file.
+  forceinline bool is_memory_mapped() const { return this->mapping != nullptr; }
+
+  // Sets the thread pool, which is used for responding to client queries. It must outlive this server handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool) { this->pool = &pool; }
+
+  // Returns read-only view of transposed parsed database matrix, wherever it lives. It's only valid as long as this server handle is.
+  forceinline parsed_db_transposed_view_t db_view() const
+  {
+    if (this->mapping) {
+      const auto D_bytes = this->mapping->bytes().subspan(FILE_D_OFFSET, FILE_D_BYTE_LEN);
+      const auto* D_elements = reinterpret_cast<const parsed_db_elem_t*>(D_bytes.data());
+
+      return parsed_db_transposed_view_t(std::span<const parsed_db_elem_t, NUM_COLUMNS_IN_PARSED_DB * db_entry_count>(
+        D_elements, NUM_COLUMNS_IN_PARSED_DB * db_entry_count));
+    }
+
+    return this->D->view();
   }
 
   // Given byte serialized client query, this routine can be used for responding back to it, producing byte serialized server response.
-  constexpr void respond(std::span<const uint8_t, QUERY_BYTE_LEN> query_bytes, std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
+  // When native byte order is little-endian, same as the serialized one, query is read and response is accumulated right where they are,
+  // without any heap allocation, as long as both buffers are aligned to `zq_t`. Otherwise they are staged through copies, see `le_span_view_t`.
+  void respond(std::span<const uint8_t, QUERY_BYTE_LEN> query_bytes, std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
   {
-    const auto b_tilda = query_t::from_le_bytes(query_bytes);
+    const frodoPIR_matrix::zq_const_view_t b_tilda(query_bytes);
+    const frodoPIR_matrix::zq_view_t c_tilda(response_bytes);
 
-    const auto c_tilda = b_tilda.row_vector_x_transposed_matrix(this->D);
-    c_tilda.to_le_bytes(response_bytes);
+    query_t::row_vector_x_transposed_matrix(std::span<const frodoPIR_matrix::zq_t, db_entry_count>(b_tilda.data(), db_entry_count),
+                                            this->db_view(),
+                                            std::span<frodoPIR_matrix::zq_t, NUM_COLUMNS_IN_PARSED_DB>(c_tilda.data(), NUM_COLUMNS_IN_PARSED_DB),
+                                            *this->pool);
+  }
+
+  // Given k -many byte serialized client queries, concatenated, this routine can be used for responding to all of them in a single pass over
+  // the processed database, writing k -many byte serialized server responses, concatenated in same order, to `responses_bytes`. It returns
+  // false, without touching `responses_bytes`, if input and output buffers don't hold same number of queries and responses, respectively.
+  // Same as `respond`, queries and responses are worked on right where they are, whenever possible.
+  [[nodiscard("Must use status of batched query response")]] bool respond_batch(std::span<const uint8_t> queries_bytes,
+                                                                                std::span<uint8_t> responses_bytes) const
+  {
+    if (((queries_bytes.size() % QUERY_BYTE_LEN) != 0) || ((responses_bytes.size() % RESPONSE_BYTE_LEN) != 0)) {
+      return false;
+    }
+
+    const size_t batch_size = queries_bytes.size() / QUERY_BYTE_LEN;
+    if (batch_size != (responses_bytes.size() / RESPONSE_BYTE_LEN)) {
+      return false;
+    }
+
+    const frodoPIR_matrix::zq_const_view_t b_tildas_view(queries_bytes);
+    const frodoPIR_matrix::zq_view_t c_tildas_view(responses_bytes);
+
+    const auto* b_tildas = b_tildas_view.data();
+    auto* c_tildas = c_tildas_view.data();
+
+    std::vector<const frodoPIR_matrix::zq_t*> b_tilda_rows(batch_size);
+    std::vector<frodoPIR_matrix::zq_t*> c_tilda_rows(batch_size);
+
+    for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+      b_tilda_rows[b_idx] = b_tildas + b_idx * db_entry_count;
+      c_tilda_rows[b_idx] = c_tildas + b_idx * NUM_COLUMNS_IN_PARSED_DB;
+    }
+
+    std::fill_n(c_tildas, batch_size * NUM_COLUMNS_IN_PARSED_DB, frodoPIR_matrix::zq_t{});
+    query_t::row_vectors_x_transposed_matrix(
+      std::span<const frodoPIR_matrix::zq_t* const>(b_tilda_rows), this->db_view(), std::span<frodoPIR_matrix::zq_t* const>(c_tilda_rows), *this->pool);
+
+    return true;
+  }
+
+  // Number of elements of query vector b̃, which are multiplied with transposed parsed database matrix at a time, by `response_stream_t`.
+  static constexpr size_t RESPONSE_STREAM_BLOCK_LEN = std::min<size_t>(db_entry_count, 1ul << 14);
+
+  // Response to a single client query, which is computed incrementally, while serialized query is still arriving, so that receiving the query
+  // overlaps with streaming parsed database through the CPU, instead of preceding it. Query bytes are fed in order, as they arrive, in chunks
+  // of any length. Each time a block of `RESPONSE_STREAM_BLOCK_LEN` -many elements of b̃ is complete, it's multiplied with matching column
+  // block of transposed D, accumulating into response c̃. Obtained using `server_t::begin`, it must not outlive the server handle.
+  struct response_stream_t
+  {
+  public:
+    // Given a chunk of serialized query, starting at byte offset `chunk_offset` of the query, this routine absorbs it, returning false, without
+    // absorbing anything, if the chunk doesn't start right where previously fed one ended or runs past end of the query.
+    [[nodiscard("Must use status of feeding query chunk")]] bool feed(const size_t chunk_offset, std::span<const uint8_t> chunk_bytes)
+    {
+      if ((chunk_offset != this->num_bytes_fed) || (chunk_bytes.size() > (QUERY_BYTE_LEN - this->num_bytes_fed))) {
+        return false;
+      }
+
+      while (!chunk_bytes.empty()) {
+        const size_t block_len = std::min(RESPONSE_STREAM_BLOCK_LEN, db_entry_count - this->block_begin);
+        const size_t block_byte_len = block_len * sizeof(frodoPIR_matrix::zq_t);
+        const size_t block_byte_off = this->num_bytes_fed - this->block_begin * sizeof(frodoPIR_matrix::zq_t);
+        const size_t num_bytes = std::min(chunk_bytes.size(), block_byte_len - block_byte_off);
+
+        std::memcpy(reinterpret_cast<uint8_t*>(this->b_tilda_block.get()) + block_byte_off, chunk_bytes.data(), num_bytes);
+        this->num_bytes_fed += num_bytes;
+        chunk_bytes = chunk_bytes.subspan(num_bytes);
+
+        if ((block_byte_off + num_bytes) == block_byte_len) {
+          const auto db = this->server->db_view();
+
+          frodoPIR_matrix::row_vector_x_transposed_column_block(this->b_tilda_block.get(),
+                                                                db.row(0).data() + this->block_begin,
+                                                                db_entry_count,
+                                                                NUM_COLUMNS_IN_PARSED_DB,
+                                                                block_len,
+                                                                this->c_tilda.get(),
+                                                                *this->server->pool);
+          this->block_begin += block_len;
+        }
+      }
+
+      return true;
+    }
+
+    // Returns truth value, denoting whether whole query has been fed.
+    forceinline bool is_complete() const { return this->num_bytes_fed == QUERY_BYTE_LEN; }
+
+    // Once whole query has been fed, this routine writes byte serialized server response, returning false, if the query is still incomplete.
+    [[nodiscard("Must use status of finishing streamed response")]] bool finish(std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
+    {
+      if (!this->is_complete()) {
+        return false;
+      }
+
+      std::memcpy(response_bytes.data(), this->c_tilda.get(), RESPONSE_BYTE_LEN);
+      return true;
+    }
+
+  private:
+    const server_t* server = nullptr;
+    std::unique_ptr<frodoPIR_matrix::zq_t[]> b_tilda_block{};
+    std::unique_ptr<frodoPIR_matrix::zq_t[]> c_tilda{};
+    size_t num_bytes_fed = 0;
+    size_t block_begin = 0;
+
+    explicit response_stream_t(const server_t* server)
+      : server(server)
+      , b_tilda_block(std::make_unique_for_overwrite<frodoPIR_matrix::zq_t[]>(RESPONSE_STREAM_BLOCK_LEN))
+      , c_tilda(std::make_unique<frodoPIR_matrix::zq_t[]>(NUM_COLUMNS_IN_PARSED_DB))
+    {
+    }
+
+    friend struct server_t;
+  };
+
+  // Begins responding to a client query, whose serialized bytes are to be fed to returned stream, as they arrive, before finishing it.
+  // Finished response is same as the one `respond` would produce for the same query. Many streams can be in progress at the same time.
+  forceinline response_stream_t begin() const
+    requires(std::endian::native == std::endian::little)
+  {
+    return response_stream_t(this);
   }
 
 private:
-  parsed_db_transposed_mat_t D{};
+  // Transposed parsed database matrix is either owned by the server or lives in a memory-mapped file.
+  std::optional<parsed_db_transposed_mat_t> D{ std::in_place };
+  std::shared_ptr<const frodoPIR_mmap::mapped_file_t> mapping{};
+  std::optional<std::array<uint8_t, SEED_BYTE_LEN>> seed_μ{};
+  frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential;
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+
+  server_t(std::shared_ptr<const frodoPIR_mmap::mapped_file_t> mapping, const std::array<uint8_t, SEED_BYTE_LEN>& seed_μ)
+    : D(std::nullopt)
+    , mapping(std::move(mapping))
+    , seed_μ(seed_μ)
+  {
+  }
+
+  // Returns transposed parsed database matrix, as bytes, in native byte order, which is little-endian, whenever it's saved to a file.
+  forceinline std::span<const uint8_t> db_bytes() const
+  {
+    return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(this->db_view().row(0).data()), FILE_D_BYTE_LEN);
+  }
+
+  // Given seed of public matrix A and its expansion mode, this routine encodes header of server state file, leaving checksum zeroed.
+  static forceinline std::array<uint8_t, SERVER_FILE_PAGE_BYTE_LEN> encode_file_header(std::span<const uint8_t, SEED_BYTE_LEN> seed_μ,
+                                                                                       const frodoPIR_matrix::expansion_mode_t A_expansion_mode)
+  {
+    std::array<uint8_t, SERVER_FILE_PAGE_BYTE_LEN> header{};
+    auto header_span = std::span(header);
+
+    std::ranges::copy(SERVER_FILE_MAGIC, header.begin());
+    frodoPIR_utils::to_le_bytes(SERVER_FILE_VERSION, header_span.subspan(8, 4));
+    frodoPIR_utils::to_le_bytes(static_cast<uint32_t>(A_expansion_mode), header_span.subspan(12, 4));
+    frodoPIR_utils::to_le_bytes(uint64_t{ db_entry_count }, header_span.subspan(16, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ db_entry_byte_len }, header_span.subspan(24, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ mat_element_bitlen }, header_span.subspan(32, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ LWE_DIMENSION }, header_span.subspan(40, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ sizeof(parsed_db_elem_t) }, header_span.subspan(48, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ FILE_D_OFFSET }, header_span.subspan(56, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ FILE_D_BYTE_LEN }, header_span.subspan(64, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ FILE_M_OFFSET }, header_span.subspan(72, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ FILE_M_BYTE_LEN }, header_span.subspan(80, 8));
+    std::ranges::copy(seed_μ, header.begin() + 88);
+
+    return header;
+  }
+
+  // Computes checksum of server state file, over its header (excluding checksum itself), transposed parsed database matrix and public matrix M.
+  static forceinline std::array<uint8_t, SERVER_FILE_CHECKSUM_BYTE_LEN> compute_file_checksum(std::span<const uint8_t> header,
+                                                                                            std::span<const uint8_t> D_bytes,
+                                                                                            std::span<const uint8_t> M_bytes)
+  {
+    std::array<uint8_t, SERVER_FILE_CHECKSUM_BYTE_LEN> checksum{};
+
+    turboshake128::turboshake128_t xof;
+    xof.absorb(header);
+    xof.absorb(D_bytes);
+    xof.absorb(M_bytes);
+    xof.finalize();
+    xof.squeeze(checksum);
+
+    return checksum;
+  }
 };
 
 }
@@ -0,0 +1,368 @@
+#pragma once
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/matrix/serialization.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include "frodoPIR/internals/utility/unix_socket.hpp"
+#include "frodoPIR/internals/utility/utils.hpp"
+#include "frodoPIR/server.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace frodoPIR_shard {
+
+// As server response c̃ = b̃ · Dᵀ is a sum over database entries, entries can be split into contiguous ranges, each served by a shard, holding
+// only its slice of the transposed parsed database matrix, s.t. partial responses of all shards add up to the response, over Zq = Z_(2^32).
+// Same holds for public matrix M = A * D, so each shard also computes its partial M, during setup.
+//
+// Shards talk to the aggregator over stream sockets, with all integers in little-endian, as follows.
+//
+// - On accepting a connection, shard sends a hello message
+//   - Magic bytes "FRODOPIR"                                         : 8 bytes
+//   - Protocol version                                               : 4 bytes
+//   - Expansion mode of public matrix A, see `expansion_mode_t`     : 4 bytes
+//   - Number of database entries                                     : 8 bytes
+//   - Byte length of each database entry                             : 8 bytes
+//   - Bit length of each parsed database matrix element              : 8 bytes
+//   - Range of database entries held by the shard, as [begin, end)   : 8 + 8 bytes
+// - Then, until aggregator closes the connection, it repeatedly
+//   - sends slice [begin, end) of a byte serialized client query     : (end - begin) * 4 bytes
+//   - receives byte serialized partial server response               : same as `server_t::RESPONSE_BYTE_LEN`
+static constexpr std::string_view SHARD_PROTOCOL_MAGIC = "FRODOPIR";
+static constexpr uint32_t SHARD_PROTOCOL_VERSION = 1;
+static constexpr size_t SHARD_HELLO_BYTE_LEN = 56;
+
+// FrodoPIR server, holding only a contiguous range of database entries.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+struct shard_server_t
+{
+public:
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using pub_mat_M_t = typename server_t::pub_mat_M_t;
+  using parsed_db_elem_t = typename server_t::parsed_db_elem_t;
+
+  static constexpr auto NUM_COLUMNS_IN_PARSED_DB = server_t::NUM_COLUMNS_IN_PARSED_DB;
+  static constexpr auto RESPONSE_BYTE_LEN = server_t::RESPONSE_BYTE_LEN;
+
+  shard_server_t() = default;
+
+  // Given a `λ` -bit seed, index of first database entry held by this shard and byte serialized database entries, concatenated, this routine
+  // sets up a shard, holding those entries, returning its handle and partial public matrix M. Summing partial public matrices M of all shards,
+  // which together cover the whole database, gives public matrix M, as returned by `server_t::setup`. As columns of public matrix A can only be
+  // reached by expanding it from seed, row by row, each shard expands all of A, but only keeps the columns it needs, a block of rows at a time.
+  // Unless A is expanded sequentially, as per `A_expansion_mode`, rows of a block are expanded in parallel. Returns nothing, if entries are
+  // empty, not a whole number of database entries or don't fit in the database.
+  template<size_t A_row_block_len = 64>
+    requires(A_row_block_len > 0)
+  static std::optional<std::pair<shard_server_t, pub_mat_M_t>> setup(
+    std::span<const uint8_t, frodoPIR_server::SEED_BYTE_LEN> seed_μ,
+    const size_t entry_begin,
+    std::span<const uint8_t> shard_db_bytes,
+    frodoPIR_thread_pool::thread_pool_t& pool = frodoPIR_thread_pool::thread_pool_t::global(),
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    using A_row_stream_t = frodoPIR_matrix::matrix_row_stream_t<db_entry_count, frodoPIR_server::λ>;
+
+    if (shard_db_bytes.empty() || ((shard_db_bytes.size() % db_entry_byte_len) != 0)) {
+      return std::nullopt;
+    }
+
+    const size_t num_entries = shard_db_bytes.size() / db_entry_byte_len;
+    if ((entry_begin >= db_entry_count) || (num_entries > (db_entry_count - entry_begin))) {
+      return std::nullopt;
+    }
+
+    shard_server_t shard(entry_begin, entry_begin + num_entries);
+    shard.A_expansion_mode = A_expansion_mode;
+    shard.set_thread_pool(pool);
+
+    frodoPIR_serialization::parse_db_rows_transposed<db_entry_byte_len, mat_element_bitlen>(shard_db_bytes, shard.D.data(), num_entries, pool);
+
+    A_row_stream_t A_row_stream(seed_μ, A_expansion_mode);
+    pub_mat_M_t M{};
+
+    std::vector<frodoPIR_matrix::zq_t> A_row(db_entry_count);
+    std::vector<frodoPIR_matrix::zq_t> A_slice_block(A_row_block_len * num_entries);
+    std::array<const frodoPIR_matrix::zq_t*, A_row_block_len> A_slice_rows{};
+    std::array<frodoPIR_matrix::zq_t*, A_row_block_len> M_rows{};
+
+    for (size_t r_idx_begin = 0; r_idx_begin < frodoPIR_server::LWE_DIMENSION; r_idx_begin += A_row_block_len) {
+      const size_t num_rows_in_block = std::min(A_row_block_len, frodoPIR_server::LWE_DIMENSION - r_idx_begin);
+
+      if (A_expansion_mode == frodoPIR_matrix::expansion_mode_t::sequential) {
+        for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+          A_row_stream.next(std::span<frodoPIR_matrix::zq_t, db_entry_count>(A_row));
+          std::copy_n(A_row.begin() + static_cast<ptrdiff_t>(entry_begin), num_entries, A_slice_block.begin() + static_cast<ptrdiff_t>(r_idx * num_entries));
+        }
+      } else {
+        pool.parallel_for(
+          num_rows_in_block,
+          [&](const size_t r_idx_begin_in_block, const size_t r_idx_end_in_block) {
+            std::vector<frodoPIR_matrix::zq_t> A_row_local(db_entry_count);
+
+            for (size_t r_idx = r_idx_begin_in_block; r_idx < r_idx_end_in_block; r_idx++) {
+              A_row_stream_t::expand_row(seed_μ, r_idx_begin + r_idx, std::span<frodoPIR_matrix::zq_t, db_entry_count>(A_row_local));
+              std::copy_n(A_row_local.begin() + static_cast<ptrdiff_t>(entry_begin),
+                          num_entries,
+                          A_slice_block.begin() + static_cast<ptrdiff_t>(r_idx * num_entries));
+            }
+          },
+          1);
+      }
+
+      for (size_t r_idx = 0; r_idx < num_rows_in_block; r_idx++) {
+        A_slice_rows[r_idx] = A_slice_block.data() + r_idx * num_entries;
+        M_rows[r_idx] = M.row(r_idx_begin + r_idx).data();
+      }
+
+      // Row i of partial M = (row i of A)[begin, end) x (transposed D)[:, begin, end)^T
+      frodoPIR_matrix::row_vectors_x_transposed_rows(std::span<const frodoPIR_matrix::zq_t* const>(A_slice_rows).first(num_rows_in_block),
+                                                     shard.D.data(),
+                                                     NUM_COLUMNS_IN_PARSED_DB,
+                                                     num_entries,
+                                                     std::span<frodoPIR_matrix::zq_t* const>(M_rows).first(num_rows_in_block),
+                                                     pool);
+    }
+
+    return std::make_pair(std::move(shard), M);
+  }
+
+  // Returns index of first database entry held by this shard.
+  forceinline size_t entry_begin() const { return this->begin; }
+
+  // Returns index of one past last database entry held by this shard.
+  forceinline size_t entry_end() const { return this->end; }
+
+  // Returns expansion mode of public matrix A, which this shard was set up with.
+  forceinline frodoPIR_matrix::expansion_mode_t get_expansion_mode() const { return this->A_expansion_mode; }
+
+  // Returns byte length of the slice of client query, which this shard responds to.
+  forceinline size_t query_slice_byte_len() const { return (this->end - this->begin) * sizeof(frodoPIR_matrix::zq_t); }
+
+  // Sets the thread pool, which is used for responding to query slices. It must outlive this shard handle.
+  forceinline void set_thread_pool(frodoPIR_thread_pool::thread_pool_t& pool) { this->pool = &pool; }
+
+  // Given slice [entry_begin, entry_end) of a byte serialized client query, this routine computes byte serialized partial server response.
+  // Same as `server_t::respond`, query slice is read and partial response is accumulated right where they are, whenever possible. Returns
+  // false, without touching `response_bytes`, if byte length of query slice doesn't match.
+  [[nodiscard("Must use status of partial response")]] bool respond(std::span<const uint8_t> query_slice_bytes,
+                                                                    std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes) const
+  {
+    if (query_slice_bytes.size() != this->query_slice_byte_len()) {
+      return false;
+    }
+
+    const size_t num_entries = this->end - this->begin;
+
+    const frodoPIR_matrix::zq_const_view_t b_tilda(query_slice_bytes);
+    const frodoPIR_matrix::zq_view_t c_tilda(response_bytes);
+
+    const std::array<const frodoPIR_matrix::zq_t*, 1> b_tilda_rows{ b_tilda.data() };
+    const std::array<frodoPIR_matrix::zq_t*, 1> c_tilda_rows{ c_tilda.data() };
+
+    std::fill_n(c_tilda.data(), NUM_COLUMNS_IN_PARSED_DB, frodoPIR_matrix::zq_t{});
+    frodoPIR_matrix::row_vectors_x_transposed_rows(std::span<const frodoPIR_matrix::zq_t* const>(b_tilda_rows),
+                                                   this->D.data(),
+                                                   NUM_COLUMNS_IN_PARSED_DB,
+                                                   num_entries,
+                                                   std::span<frodoPIR_matrix::zq_t* const>(c_tilda_rows),
+                                                   *this->pool);
+
+    return true;
+  }
+
+  // Given a listening socket, this routine accepts `num_connections` -many aggregator connections, one after another, serving each of them,
+  // until it's closed by the aggregator. Returns false, if a connection can't be accepted or hello message can't be sent.
+  [[nodiscard("Must use status of serving aggregator connections")]] bool serve(const frodoPIR_unix_socket::socket_t& listener,
+                                                                                const size_t num_connections = 1) const
+  {
+    const auto hello = encode_hello(this->begin, this->end, this->A_expansion_mode);
+
+    std::vector<frodoPIR_matrix::zq_t> query_slice(this->end - this->begin);
+    std::vector<frodoPIR_matrix::zq_t> response(NUM_COLUMNS_IN_PARSED_DB);
+
+    const auto query_slice_bytes = std::span<uint8_t>(reinterpret_cast<uint8_t*>(query_slice.data()), this->query_slice_byte_len());
+    const auto response_bytes = std::span<uint8_t, RESPONSE_BYTE_LEN>(reinterpret_cast<uint8_t*>(response.data()), RESPONSE_BYTE_LEN);
+
+    for (size_t conn_idx = 0; conn_idx < num_connections; conn_idx++) {
+      const auto conn = listener.accept();
+      if (!conn.is_valid() || !conn.write_all(hello)) {
+        return false;
+      }
+
+      // Aggregator closing the connection ends it.
+      while (conn.read_all(query_slice_bytes)) {
+        (void)this->respond(query_slice_bytes, response_bytes);
+
+        if (!conn.write_all(response_bytes)) {
+          break;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // Given range of database entries and expansion mode of public matrix A, this routine encodes hello message, sent by a shard, holding them.
+  static forceinline std::array<uint8_t, SHARD_HELLO_BYTE_LEN> encode_hello(const size_t entry_begin,
+                                                                            const size_t entry_end,
+                                                                            const frodoPIR_matrix::expansion_mode_t A_expansion_mode)
+  {
+    std::array<uint8_t, SHARD_HELLO_BYTE_LEN> hello{};
+    auto hello_span = std::span(hello);
+
+    std::ranges::copy(SHARD_PROTOCOL_MAGIC, hello.begin());
+    frodoPIR_utils::to_le_bytes(SHARD_PROTOCOL_VERSION, hello_span.subspan(8, 4));
+    frodoPIR_utils::to_le_bytes(static_cast<uint32_t>(A_expansion_mode), hello_span.subspan(12, 4));
+    frodoPIR_utils::to_le_bytes(uint64_t{ db_entry_count }, hello_span.subspan(16, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ db_entry_byte_len }, hello_span.subspan(24, 8));
+    frodoPIR_utils::to_le_bytes(uint64_t{ mat_element_bitlen }, hello_span.subspan(32, 8));
+    frodoPIR_utils::to_le_bytes(static_cast<uint64_t>(entry_begin), hello_span.subspan(40, 8));
+    frodoPIR_utils::to_le_bytes(static_cast<uint64_t>(entry_end), hello_span.subspan(48, 8));
+
+    return hello;
+  }
+
+private:
+  size_t begin = 0;
+  size_t end = 0;
+  frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential;
+
+  // Slice of transposed parsed database matrix, of dimension `NUM_COLUMNS_IN_PARSED_DB x (end - begin)`, in row-major order.
+  std::vector<parsed_db_elem_t> D{};
+  frodoPIR_thread_pool::thread_pool_t* pool = &frodoPIR_thread_pool::thread_pool_t::global();
+
+  shard_server_t(const size_t begin, const size_t end)
+    : begin(begin)
+    , end(end)
+    , D(NUM_COLUMNS_IN_PARSED_DB * (end - begin))
+  {
+  }
+};
+
+// Aggregator, connected to shards which together cover the whole database, responding to client queries on behalf of them, by fanning out
+// query slices to all shards and summing their partial responses. An aggregator handle works on one query at a time.
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+struct aggregator_t
+{
+public:
+  using shard_t = shard_server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using server_t = typename shard_t::server_t;
+
+  static constexpr auto NUM_COLUMNS_IN_PARSED_DB = server_t::NUM_COLUMNS_IN_PARSED_DB;
+  static constexpr auto QUERY_BYTE_LEN = server_t::QUERY_BYTE_LEN;
+  static constexpr auto RESPONSE_BYTE_LEN = server_t::RESPONSE_BYTE_LEN;
+
+  // Given paths of sockets, on which shards are listening, this routine connects to all of them, returning an aggregator handle. Returns
+  // nothing, if any shard can't be reached, belongs to a different parameter set, expands public matrix A other than `A_expansion_mode`,
+  // which clients are set up with, or ranges of database entries held by shards don't cover the whole database, without any overlap.
+  static std::optional<aggregator_t> connect(
+    std::span<const std::filesystem::path> shard_paths,
+    const frodoPIR_matrix::expansion_mode_t A_expansion_mode = frodoPIR_matrix::expansion_mode_t::sequential)
+  {
+    aggregator_t aggregator{};
+
+    for (const auto& shard_path : shard_paths) {
+      auto conn = frodoPIR_unix_socket::socket_t::connect(shard_path);
+      if (!conn.is_valid()) {
+        return std::nullopt;
+      }
+
+      std::array<uint8_t, SHARD_HELLO_BYTE_LEN> hello{};
+      if (!conn.read_all(hello)) {
+        return std::nullopt;
+      }
+
+      const auto hello_span = std::span<const uint8_t>(hello);
+      const size_t entry_begin = frodoPIR_utils::from_le_bytes<uint64_t>(hello_span.subspan(40, 8));
+      const size_t entry_end = frodoPIR_utils::from_le_bytes<uint64_t>(hello_span.subspan(48, 8));
+
+      // All fields of hello message, but range of database entries, are fixed for a parameter set and expansion mode of A.
+      const auto expected_hello = shard_t::encode_hello(entry_begin, entry_end, A_expansion_mode);
+      if (!std::ranges::equal(hello, expected_hello) || (entry_begin >= entry_end)) {
+        return std::nullopt;
+      }
+
+      aggregator.shards.push_back({ std::move(conn), entry_begin, entry_end });
+    }
+
+    std::ranges::sort(aggregator.shards, {}, &shard_conn_t::entry_begin);
+
+    size_t covered_till = 0;
+    for (const auto& shard : aggregator.shards) {
+      if (shard.entry_begin != covered_till) {
+        return std::nullopt;
+      }
+      covered_till = shard.entry_end;
+    }
+    if (covered_till != db_entry_count) {
+      return std::nullopt;
+    }
+
+    return aggregator;
+  }
+
+  // Returns number of shards, this aggregator is connected to.
+  forceinline size_t num_shards() const { return this->shards.size(); }
+
+  // Given byte serialized client query, this routine sends its slices to respective shards, all at once, so that shards work in parallel,
+  // and then sums their partial responses, producing byte serialized server response, same as `server_t::respond` does. Returns false, if
+  // any shard can't be reached, in which case `response_bytes` must not be used.
+  [[nodiscard("Must use status of aggregated response")]] bool respond(std::span<const uint8_t, QUERY_BYTE_LEN> query_bytes,
+                                                                       std::span<uint8_t, RESPONSE_BYTE_LEN> response_bytes)
+  {
+    constexpr size_t zq_byte_len = sizeof(frodoPIR_matrix::zq_t);
+
+    for (const auto& shard : this->shards) {
+      const auto query_slice_bytes = query_bytes.subspan(shard.entry_begin * zq_byte_len, (shard.entry_end - shard.entry_begin) * zq_byte_len);
+      if (!shard.conn.write_all(query_slice_bytes)) {
+        return false;
+      }
+    }
+
+    std::ranges::fill(this->response, frodoPIR_matrix::zq_t{});
+
+    for (const auto& shard : this->shards) {
+      if (!shard.conn.read_all(this->partial_response_bytes)) {
+        return false;
+      }
+
+      for (size_t c_idx = 0; c_idx < NUM_COLUMNS_IN_PARSED_DB; c_idx++) {
+        const auto partial_response_elem_bytes = std::span<const uint8_t>(this->partial_response_bytes).subspan(c_idx * zq_byte_len, zq_byte_len);
+        this->response[c_idx] += frodoPIR_utils::from_le_bytes<frodoPIR_matrix::zq_t>(partial_response_elem_bytes);
+      }
+    }
+
+    for (size_t c_idx = 0; c_idx < NUM_COLUMNS_IN_PARSED_DB; c_idx++) {
+      frodoPIR_utils::to_le_bytes(this->response[c_idx], response_bytes.subspan(c_idx * zq_byte_len, zq_byte_len));
+    }
+
+    return true;
+  }
+
+private:
+  struct shard_conn_t
+  {
+    frodoPIR_unix_socket::socket_t conn{};
+    size_t entry_begin = 0;
+    size_t entry_end = 0;
+  };
+
+  std::vector<shard_conn_t> shards{};
+  std::array<uint8_t, RESPONSE_BYTE_LEN> partial_response_bytes{};
+  std::array<frodoPIR_matrix::zq_t, NUM_COLUMNS_IN_PARSED_DB> response{};
+
+  aggregator_t() = default;
+};
+
+}
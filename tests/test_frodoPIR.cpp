@@ -1,11 +1,24 @@
 #include "frodoPIR/client.hpp"
 #include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/utility/numa.hpp"
+#include "frodoPIR/numa_server.hpp"
+#include "frodoPIR/partitioned.hpp"
+#include "frodoPIR/runtime.hpp"
 #include "frodoPIR/server.hpp"
+#include "frodoPIR/shard.hpp"
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <limits>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen, size_t lwe_dimension>
@@ -159,3 +172,1309 @@ TEST(FrodoPIR, ClientQueryCacheStateTransition)
   constexpr size_t db_second_row_bytes_begin_at = db_second_row_index * db_entry_byte_len;
   EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_second_row_bytes_begin_at, db_entry_byte_len)));
 }
+
+TEST(FrodoPIR, BatchedServerResponse)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t lwe_dimension = 1774;
+  constexpr size_t batch_size = 5;
+  constexpr size_t parsed_db_column_count = frodoPIR_matrix::get_required_num_columns(db_entry_byte_len, mat_element_bitlen);
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+  constexpr size_t pub_matM_byte_len = frodoPIR_matrix::matrix_t<lwe_dimension, parsed_db_column_count>::get_byte_len();
+  constexpr size_t query_byte_len = frodoPIR_vector::row_vector_t<db_entry_count>::get_byte_len();
+  constexpr size_t response_byte_len = frodoPIR_vector::row_vector_t<parsed_db_column_count>::get_byte_len();
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(pub_matM_byte_len, 0);
+  std::vector<uint8_t> queries_bytes(batch_size * query_byte_len, 0);
+  std::vector<uint8_t> responses_bytes(batch_size * response_byte_len, 0);
+  std::vector<uint8_t> response_bytes(response_byte_len, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, pub_matM_byte_len>(pub_matM_bytes);
+  auto queries_bytes_span = std::span(queries_bytes);
+  auto responses_bytes_span = std::span(responses_bytes);
+  auto response_bytes_span = std::span<uint8_t, response_byte_len>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>::setup(seed_μ, db_bytes_span);
+
+  M.to_le_bytes(pub_matM_bytes_span);
+  auto client = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>::setup(seed_μ, pub_matM_bytes_span);
+
+  std::array<size_t, batch_size> db_row_indices{};
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    db_row_indices[b_idx] = (b_idx * 7919) % db_entry_count;
+  }
+
+  const auto query_prep_status = client.prepare_query(db_row_indices, csprng);
+  EXPECT_TRUE(std::ranges::all_of(query_prep_status, [](const bool status) { return status; }));
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    auto query_bytes_span = queries_bytes_span.subspan(b_idx * query_byte_len).first<query_byte_len>();
+    EXPECT_TRUE(client.query(db_row_indices[b_idx], query_bytes_span));
+  }
+
+  // Mismatching number of queries and responses must be rejected.
+  EXPECT_FALSE(server.respond_batch(queries_bytes_span, responses_bytes_span.first(response_byte_len)));
+  EXPECT_FALSE(server.respond_batch(queries_bytes_span.first(query_byte_len + 1), responses_bytes_span.first(response_byte_len)));
+
+  EXPECT_TRUE(server.respond_batch(queries_bytes_span, responses_bytes_span));
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    auto query_bytes_span = queries_bytes_span.subspan(b_idx * query_byte_len).first<query_byte_len>();
+    auto batched_response_bytes_span = responses_bytes_span.subspan(b_idx * response_byte_len).first<response_byte_len>();
+
+    // Batched response must be same as the one computed for each query separately.
+    server.respond(query_bytes_span, response_bytes_span);
+    EXPECT_TRUE(std::ranges::equal(batched_response_bytes_span, response_bytes_span));
+
+    EXPECT_TRUE(client.process_response(db_row_indices[b_idx], batched_response_bytes_span, db_row_bytes_span));
+
+    const size_t db_row_begin_at = db_row_indices[b_idx] * db_entry_byte_len;
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_begin_at, db_entry_byte_len)));
+  }
+}
+
+TEST(FrodoPIR, ServerRespondOnMisalignedBuffers)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t batch_size = 3;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+
+  // One extra byte, so that buffers can be offset by one byte, making them misaligned w.r.t. `zq_t`.
+  std::vector<uint8_t> queries_bytes(batch_size * server_t::QUERY_BYTE_LEN + 1, 0);
+  std::vector<uint8_t> misaligned_queries_bytes(batch_size * server_t::QUERY_BYTE_LEN + 1, 0);
+  std::vector<uint8_t> responses_bytes(batch_size * server_t::RESPONSE_BYTE_LEN + 1, 0);
+  std::vector<uint8_t> misaligned_responses_bytes(batch_size * server_t::RESPONSE_BYTE_LEN + 1, 0);
+  std::vector<uint8_t> aligned_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto queries_bytes_span = std::span(queries_bytes).first(batch_size * server_t::QUERY_BYTE_LEN);
+  auto misaligned_queries_bytes_span = std::span(misaligned_queries_bytes).subspan(1);
+  auto responses_bytes_span = std::span(responses_bytes).first(batch_size * server_t::RESPONSE_BYTE_LEN);
+  auto misaligned_responses_bytes_span = std::span(misaligned_responses_bytes).subspan(1);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(queries_bytes_span);
+
+  std::ranges::copy(queries_bytes_span, misaligned_queries_bytes_span.begin());
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+
+  // Stale bytes in response buffers must not leak into responses.
+  csprng.generate(responses_bytes);
+  csprng.generate(misaligned_responses_bytes);
+
+  EXPECT_TRUE(server.respond_batch(queries_bytes_span, responses_bytes_span));
+  EXPECT_TRUE(server.respond_batch(misaligned_queries_bytes_span, misaligned_responses_bytes_span));
+  EXPECT_TRUE(std::ranges::equal(responses_bytes_span, misaligned_responses_bytes_span));
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    const auto query_bytes = queries_bytes_span.subspan(b_idx * server_t::QUERY_BYTE_LEN).first<server_t::QUERY_BYTE_LEN>();
+    const auto misaligned_query_bytes = misaligned_queries_bytes_span.subspan(b_idx * server_t::QUERY_BYTE_LEN).first<server_t::QUERY_BYTE_LEN>();
+    const auto batched_response_bytes = responses_bytes_span.subspan(b_idx * server_t::RESPONSE_BYTE_LEN).first<server_t::RESPONSE_BYTE_LEN>();
+    const auto response_bytes = misaligned_responses_bytes_span.subspan(0).first<server_t::RESPONSE_BYTE_LEN>();
+
+    // Aligned query, misaligned response.
+    server.respond(query_bytes, response_bytes);
+    EXPECT_TRUE(std::ranges::equal(batched_response_bytes, response_bytes));
+
+    // Misaligned query, aligned response.
+    csprng.generate(aligned_response_bytes);
+
+    server.respond(misaligned_query_bytes, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(aligned_response_bytes));
+    EXPECT_TRUE(std::ranges::equal(batched_response_bytes, aligned_response_bytes));
+  }
+}
+
+TEST(FrodoPIR, PipelinedStreamingServerResponse)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> streamed_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto streamed_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(streamed_response_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(query_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  server.respond(query_bytes_span, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes));
+
+  auto stream = server.begin();
+
+  // Chunks don't line up with elements of b̃ or with blocks, as bytes read off a socket wouldn't.
+  constexpr std::array<size_t, 6> chunk_byte_lens{ 1, 3, 4093, 65536, 7, 100003 };
+
+  size_t chunk_offset = 0;
+  for (size_t c_idx = 0; chunk_offset < server_t::QUERY_BYTE_LEN; c_idx++) {
+    const size_t chunk_byte_len = std::min(chunk_byte_lens[c_idx % chunk_byte_lens.size()], server_t::QUERY_BYTE_LEN - chunk_offset);
+    const auto chunk_bytes = query_bytes_span.subspan(chunk_offset, chunk_byte_len);
+
+    EXPECT_FALSE(stream.finish(streamed_response_bytes_span));
+    if (chunk_offset > 0) {
+      // Chunks must be fed in order, without gaps or overlaps.
+      EXPECT_FALSE(stream.feed(chunk_offset - 1, chunk_bytes));
+      EXPECT_FALSE(stream.feed(chunk_offset + 1, chunk_bytes.subspan(1)));
+    }
+
+    EXPECT_TRUE(stream.feed(chunk_offset, chunk_bytes));
+    chunk_offset += chunk_byte_len;
+  }
+
+  EXPECT_TRUE(stream.is_complete());
+  EXPECT_FALSE(stream.feed(chunk_offset, query_bytes_span.first(1)));
+  EXPECT_TRUE(stream.finish(streamed_response_bytes_span));
+  EXPECT_EQ(response_bytes, streamed_response_bytes);
+
+  // Query fed as a whole, in one chunk.
+  auto whole_query_stream = server.begin();
+  std::ranges::fill(streamed_response_bytes, 0);
+
+  EXPECT_TRUE(whole_query_stream.feed(0, query_bytes_span));
+  EXPECT_TRUE(whole_query_stream.finish(streamed_response_bytes_span));
+  EXPECT_EQ(response_bytes, streamed_response_bytes);
+}
+
+TEST(FrodoPIR, NumaAwareServer)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using numa_server_t = frodoPIR_numa_server::numa_server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  EXPECT_EQ(frodoPIR_numa::parse_cpu_list("0-3,8,10-11\n"), (std::vector<size_t>{ 0, 1, 2, 3, 8, 10, 11 }));
+  EXPECT_EQ(frodoPIR_numa::parse_cpu_list("5,x,1"), (std::vector<size_t>{ 1, 5 }));
+
+  // Whatever the topology of this machine, there's at least one node.
+  const auto nodes = frodoPIR_numa::get_nodes();
+  EXPECT_FALSE(nodes.empty());
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN + 1, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> numa_response_bytes(server_t::RESPONSE_BYTE_LEN + 1, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes.data(), server_t::QUERY_BYTE_LEN);
+  auto misaligned_query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes.data() + 1, server_t::QUERY_BYTE_LEN);
+  auto numa_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(numa_response_bytes.data(), server_t::RESPONSE_BYTE_LEN);
+  auto misaligned_numa_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(numa_response_bytes.data() + 1, server_t::RESPONSE_BYTE_LEN);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(query_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  server.respond(query_bytes_span, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes));
+
+  // Topology of this machine, along with made up ones, with more nodes than this machine may have, all sharing CPU 0, which is always there.
+  const std::vector<std::vector<frodoPIR_numa::node_t>> topologies{
+    nodes,
+    { frodoPIR_numa::node_t{ .id = 0, .cpu_ids = { 0 } }, frodoPIR_numa::node_t{ .id = 0, .cpu_ids = { 0, 0 } } },
+    std::vector<frodoPIR_numa::node_t>(server_t::NUM_COLUMNS_IN_PARSED_DB + 3, frodoPIR_numa::node_t{ .id = 0, .cpu_ids = { 0 } }),
+  };
+
+  for (const auto& topology : topologies) {
+    auto numa_server = numa_server_t::distribute(server, topology);
+    ASSERT_TRUE(numa_server.has_value());
+    EXPECT_EQ(numa_server->num_nodes(), topology.size());
+
+    size_t total_slice_byte_len = 0;
+    for (size_t n_idx = 0; n_idx < numa_server->num_nodes(); n_idx++) {
+      total_slice_byte_len += numa_server->node_slice_byte_len(n_idx);
+    }
+    EXPECT_EQ(total_slice_byte_len, server_t::FILE_D_BYTE_LEN);
+
+    csprng.generate(numa_response_bytes);
+    numa_server->respond(query_bytes_span, numa_response_bytes_span);
+    EXPECT_TRUE(std::ranges::equal(response_bytes, numa_response_bytes_span));
+
+    // Misaligned query and response.
+    csprng.generate(numa_response_bytes);
+    numa_server->respond(misaligned_query_bytes_span, misaligned_numa_response_bytes_span);
+
+    std::vector<uint8_t> misaligned_query_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+    server.respond(misaligned_query_bytes_span, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(misaligned_query_response_bytes));
+    EXPECT_TRUE(std::ranges::equal(misaligned_query_response_bytes, misaligned_numa_response_bytes_span));
+  }
+
+  EXPECT_FALSE(numa_server_t::distribute(server, std::span<const frodoPIR_numa::node_t>{}).has_value());
+}
+
+TEST(FrodoPIR, StreamingServerSetup)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> streamed_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto streamed_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(streamed_response_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(query_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  // Row block length, which doesn't divide LWE dimension, exercises the last partially filled block.
+  auto [streamed_server, streamed_M] = server_t::setup_streaming<100>(seed_μ, db_bytes_span);
+
+  EXPECT_EQ(M, streamed_M);
+
+  server.respond(query_bytes_span, response_bytes_span);
+  streamed_server.respond(query_bytes_span, streamed_response_bytes_span);
+
+  EXPECT_EQ(response_bytes, streamed_response_bytes);
+}
+
+// Returns all bytes of a file.
+static std::vector<uint8_t>
+read_file_bytes(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST(FrodoPIR, MemoryMappedServer)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> mapped_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto mapped_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(mapped_response_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(query_bytes);
+
+  const auto path = std::filesystem::temp_directory_path() / ("frodoPIR-test-" + std::to_string(::getpid()) + ".db");
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  EXPECT_TRUE(server.save(path, M));
+
+  {
+    auto opened = server_t::open_mmap(path, { .populate = true, .huge_pages = true, .verify_checksum = true });
+    EXPECT_TRUE(opened.has_value());
+
+    auto& [mapped_server, mapped_M] = *opened;
+    EXPECT_TRUE(mapped_server.is_memory_mapped());
+    EXPECT_EQ(M, mapped_M);
+
+    server.respond(query_bytes_span, response_bytes_span);
+    mapped_server.respond(query_bytes_span, mapped_response_bytes_span);
+
+    EXPECT_EQ(response_bytes, mapped_response_bytes);
+
+    // Memory-mapped file is read-only, so database rows can't be updated in place.
+    EXPECT_FALSE(mapped_server.update_rows(std::span<const size_t>{}, std::span<const uint8_t>{}).has_value());
+
+    // Server opened from a memory-mapped file can itself be saved, producing identical file.
+    const auto resaved_path = std::filesystem::path(path).concat(".resaved");
+    EXPECT_TRUE(mapped_server.save(resaved_path, mapped_M));
+    EXPECT_EQ(read_file_bytes(path), read_file_bytes(resaved_path));
+    std::filesystem::remove(resaved_path);
+  }
+
+  // Same file doesn't belong to a different parameter set.
+  EXPECT_FALSE((frodoPIR_server::server_t<db_entry_count, 2 * db_entry_byte_len, mat_element_bitlen>::open_mmap(path).has_value()));
+
+  // Flip a bit in the parsed database matrix.
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(static_cast<std::streamoff>(server_t::FILE_D_OFFSET));
+
+    char byte{};
+    file.read(&byte, 1);
+    byte ^= 1;
+
+    file.seekp(static_cast<std::streamoff>(server_t::FILE_D_OFFSET));
+    file.write(&byte, 1);
+  }
+
+  EXPECT_FALSE(server_t::open_mmap(path).has_value());
+  EXPECT_TRUE(server_t::open_mmap(path, { .verify_checksum = false }).has_value());
+
+  std::filesystem::remove(path);
+  EXPECT_FALSE(server_t::open_mmap(path).has_value());
+}
+
+TEST(FrodoPIR, IncrementalDatabaseRowUpdates)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+
+  M.to_le_bytes(pub_matM_bytes_span);
+  auto client = client_t::setup(seed_μ, pub_matM_bytes_span);
+  auto lowmem_client = client_t::setup_lowmem(seed_μ, pub_matM_bytes_span);
+
+  // Last and first rows, along with one row updated twice, where the last update wins.
+  const std::vector<size_t> db_row_indices{ db_entry_count - 1, 0, 1234, 1234 };
+  std::vector<uint8_t> db_rows_bytes(db_row_indices.size() * db_entry_byte_len, 0);
+  csprng.generate(db_rows_bytes);
+
+  // A query prepared before the update gets dropped, when the update is applied by the client.
+  EXPECT_TRUE(client.prepare_query(db_row_indices[0], csprng));
+
+  // Malformed updates don't touch the database.
+  EXPECT_FALSE(server.update_rows(std::vector<size_t>{ db_entry_count }, std::span(db_rows_bytes).first(db_entry_byte_len)).has_value());
+  EXPECT_FALSE(server.update_rows(db_row_indices, std::span(db_rows_bytes).first(db_entry_byte_len)).has_value());
+
+  const auto M_delta = server.update_rows(db_row_indices, db_rows_bytes);
+  EXPECT_TRUE(M_delta.has_value());
+
+  for (size_t u_idx = 0; u_idx < db_row_indices.size(); u_idx++) {
+    std::ranges::copy(std::span(db_rows_bytes).subspan(u_idx * db_entry_byte_len, db_entry_byte_len),
+                      db_bytes.begin() + static_cast<std::ptrdiff_t>(db_row_indices[u_idx] * db_entry_byte_len));
+  }
+
+  // Patched server state must be same as, if it were setup over updated database.
+  auto [updated_server, updated_M] = server_t::setup(seed_μ, db_bytes_span);
+
+  auto patched_M = M;
+  M_delta->apply_to(patched_M);
+  EXPECT_EQ(patched_M, updated_M);
+
+  // Delta is kept factored, so it's smaller than M itself, as long as only a few rows are updated.
+  std::vector<uint8_t> pub_matM_delta_bytes(M_delta->get_byte_len(), 0);
+  M_delta->to_le_bytes(pub_matM_delta_bytes);
+  EXPECT_LT(pub_matM_delta_bytes.size(), client_t::PUBLIC_MATRIX_M_BYTE_LEN);
+
+  // Malformed delta doesn't touch public matrix M, kept by the client, which can still answer the prepared query.
+  EXPECT_FALSE(client.apply_pub_mat_M_delta(std::span(pub_matM_delta_bytes).first(pub_matM_delta_bytes.size() - 1)));
+  EXPECT_TRUE(client.query(db_row_indices[0], query_bytes_span));
+
+  EXPECT_TRUE(client.apply_pub_mat_M_delta(pub_matM_delta_bytes));
+  EXPECT_TRUE(lowmem_client.apply_pub_mat_M_delta(pub_matM_delta_bytes));
+
+  EXPECT_FALSE(client.process_response(db_row_indices[0], response_bytes_span, db_row_bytes_span));
+
+  for (auto* cur_client : { &client, &lowmem_client }) {
+    for (const auto db_row_index : { db_row_indices[0], db_row_indices[1], db_row_indices[2], size_t{ 42 } }) {
+      EXPECT_TRUE(cur_client->prepare_query(db_row_index, csprng));
+      EXPECT_TRUE(cur_client->query(db_row_index, query_bytes_span));
+
+      server.respond(query_bytes_span, response_bytes_span);
+
+      EXPECT_TRUE(cur_client->process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+      EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+    }
+  }
+}
+
+TEST(FrodoPIR, ServerWithoutSeedCanOnlyRespond)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> expected_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto query_bytes_span = std::span<const uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+  csprng.generate(query_bytes);
+
+  auto [seeded_server, M] = server_t::setup(seed_μ, db_bytes_span);
+  server_t server(frodoPIR_serialization::parse_db_bytes_transposed<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes_span));
+
+  // Server, constructed right from a parsed database matrix, responds same as the one set up from seed.
+  seeded_server.respond(query_bytes_span, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(expected_response_bytes));
+  server.respond(query_bytes_span, std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes));
+  EXPECT_EQ(expected_response_bytes, response_bytes);
+
+  // But without knowing seed of public matrix A, it can neither compute delta of public matrix M nor persist its state.
+  const std::vector<size_t> db_row_indices{ 42 };
+  EXPECT_FALSE(server.update_rows(db_row_indices, std::span(db_bytes).first(db_entry_byte_len)).has_value());
+
+  const auto path = std::filesystem::temp_directory_path() / ("frodoPIR-test-" + std::to_string(::getpid()) + ".unseeded.db");
+  EXPECT_FALSE(server.save(path, M));
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  // Default constructed server doesn't know the seed either.
+  server_t default_server{};
+  EXPECT_FALSE(default_server.update_rows(db_row_indices, std::span(db_bytes).first(db_entry_byte_len)).has_value());
+  EXPECT_FALSE(default_server.save(path, M));
+}
+
+TEST(FrodoPIR, ShardedServerWithAggregator)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using shard_server_t = frodoPIR_shard::shard_server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using aggregator_t = frodoPIR_shard::aggregator_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> aggregated_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto aggregated_response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(aggregated_response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+
+  M.to_le_bytes(pub_matM_bytes_span);
+  auto client = client_t::setup(seed_μ, pub_matM_bytes_span);
+
+  // Shards of unequal length, together covering the whole database.
+  const std::vector<std::pair<size_t, size_t>> shard_ranges{ { 0, 10000 }, { 10000, 40007 }, { 40007, db_entry_count } };
+
+  // Shards must hold a non-empty, whole number of database entries, within the database.
+  EXPECT_FALSE(shard_server_t::setup(seed_μ, 0, db_bytes_span.first(0)).has_value());
+  EXPECT_FALSE(shard_server_t::setup(seed_μ, 0, db_bytes_span.first(db_entry_byte_len + 1)).has_value());
+  EXPECT_FALSE(shard_server_t::setup(seed_μ, db_entry_count - 1, db_bytes_span.first(2 * db_entry_byte_len)).has_value());
+
+  std::vector<shard_server_t> shards{};
+  server_t::pub_mat_M_t summed_M{};
+
+  for (const auto& [entry_begin, entry_end] : shard_ranges) {
+    const auto shard_bytes = db_bytes_span.subspan(entry_begin * db_entry_byte_len, (entry_end - entry_begin) * db_entry_byte_len);
+    auto shard = shard_server_t::setup(seed_μ, entry_begin, shard_bytes);
+    EXPECT_TRUE(shard.has_value());
+
+    summed_M = summed_M + shard->second;
+    shards.push_back(std::move(shard->first));
+  }
+
+  // Partial public matrices M add up to public matrix M.
+  EXPECT_EQ(summed_M, M);
+
+  // Each shard runs in its own process, listening on a Unix domain socket. First two shards also serve an aggregator, which doesn't cover
+  // the whole database, while first shard also serves one, which expects public matrix A to be expanded otherwise.
+  std::vector<std::filesystem::path> shard_paths{};
+  std::vector<pid_t> shard_pids{};
+
+  for (size_t s_idx = 0; s_idx < shards.size(); s_idx++) {
+    const auto path =
+      std::filesystem::temp_directory_path() / ("frodoPIR-shard-" + std::to_string(::getpid()) + "-" + std::to_string(s_idx) + ".sock");
+    const auto listener = frodoPIR_unix_socket::socket_t::listen(path);
+    EXPECT_TRUE(listener.is_valid());
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+      // Workers of the global thread pool don't survive fork.
+      frodoPIR_thread_pool::thread_pool_t pool(1);
+      shards[s_idx].set_thread_pool(pool);
+
+      const bool is_served = shards[s_idx].serve(listener, (s_idx == 0) ? 3 : (s_idx + 1 < shards.size()) ? 2 : 1);
+      ::_exit(is_served ? 0 : 1);
+    }
+
+    EXPECT_GT(pid, 0);
+    shard_paths.push_back(path);
+    shard_pids.push_back(pid);
+  }
+
+  EXPECT_FALSE(aggregator_t::connect(std::span(shard_paths).first(shard_paths.size() - 1)).has_value());
+  EXPECT_FALSE(aggregator_t::connect(shard_paths, frodoPIR_matrix::expansion_mode_t::row_indexed_v1).has_value());
+
+  {
+    // Order of shards doesn't matter.
+    std::ranges::reverse(shard_paths);
+
+    auto aggregator = aggregator_t::connect(shard_paths);
+    EXPECT_TRUE(aggregator.has_value());
+    EXPECT_EQ(aggregator->num_shards(), shards.size());
+
+    for (const auto db_row_index : { size_t{ 0 }, size_t{ 9999 }, size_t{ 10000 }, size_t{ 40007 }, db_entry_count - 1 }) {
+      EXPECT_TRUE(client.prepare_query(db_row_index, csprng));
+      EXPECT_TRUE(client.query(db_row_index, query_bytes_span));
+
+      server.respond(query_bytes_span, response_bytes_span);
+      EXPECT_TRUE(aggregator->respond(query_bytes_span, aggregated_response_bytes_span));
+      EXPECT_EQ(response_bytes, aggregated_response_bytes);
+
+      EXPECT_TRUE(client.process_response(db_row_index, aggregated_response_bytes_span, db_row_bytes_span));
+      EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+    }
+  }
+
+  // Closing aggregator connections lets shards exit.
+  for (const auto pid : shard_pids) {
+    int status = 0;
+    EXPECT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+  }
+
+  for (const auto& path : shard_paths) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(FrodoPIR, PartitionedPrivateInformationRetrieval)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t partition_entry_count = 1ul << 16;
+  constexpr size_t db_entry_count = 2 * partition_entry_count + 1000;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_partitioned::partitioned_server_t<db_entry_count, db_entry_byte_len, partition_entry_count>;
+  using client_t = frodoPIR_partitioned::partitioned_client_t<db_entry_count, db_entry_byte_len, partition_entry_count>;
+
+  static_assert(server_t::NUM_PARTITIONS == 3);
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> queries_bytes(server_t::NUM_PARTITIONS * server_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> responses_bytes(server_t::NUM_PARTITIONS * server_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, Ms] = server_t::setup(seed_μ, db_bytes_span);
+  EXPECT_EQ(Ms.size(), server_t::NUM_PARTITIONS);
+
+  auto client = client_t::setup(seed_μ);
+
+  // Rows of a partition can't be enquired, until its public matrix M is handed to the client.
+  EXPECT_FALSE(client.has_partition_pub_mat_M(1));
+  EXPECT_FALSE(client.prepare_query(partition_entry_count, csprng));
+
+  Ms[1].to_le_bytes(pub_matM_bytes_span);
+  EXPECT_TRUE(client.set_partition_pub_mat_M(1, pub_matM_bytes_span));
+  EXPECT_FALSE(client.set_partition_pub_mat_M(server_t::NUM_PARTITIONS, pub_matM_bytes_span));
+  EXPECT_TRUE(client.has_partition_pub_mat_M(1));
+
+  // Query routed to the partition holding the row.
+  for (const auto db_row_index : { partition_entry_count, 2 * partition_entry_count - 1 }) {
+    const auto [partition_idx, partition_row_index] = client_t::locate(db_row_index);
+    EXPECT_EQ(partition_idx, 1u);
+    EXPECT_EQ(server_t::get_partition_index(db_row_index), partition_idx);
+
+    EXPECT_TRUE(client.prepare_query(db_row_index, csprng));
+    EXPECT_TRUE(client.query(db_row_index, query_bytes_span));
+    EXPECT_TRUE(server.respond(partition_idx, query_bytes_span, response_bytes_span));
+
+    EXPECT_TRUE(client.process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+  }
+
+  EXPECT_FALSE(server.respond(server_t::NUM_PARTITIONS, query_bytes_span, response_bytes_span));
+
+  // Last partition is padded, but padding rows can't be enquired.
+  Ms[2].to_le_bytes(pub_matM_bytes_span);
+  EXPECT_TRUE(client.set_partition_pub_mat_M(2, pub_matM_bytes_span));
+  EXPECT_FALSE(client.prepare_query(db_entry_count, csprng));
+
+  // Query sent to all partitions, with dummies for the ones not holding the row.
+  for (const auto db_row_index : { 2 * partition_entry_count, db_entry_count - 1, partition_entry_count + 42 }) {
+    EXPECT_TRUE(client.prepare_query(db_row_index, csprng));
+    EXPECT_FALSE(client.query_all(db_row_index, std::span(queries_bytes).first(server_t::QUERY_BYTE_LEN), csprng));
+    EXPECT_TRUE(client.query_all(db_row_index, queries_bytes, csprng));
+    EXPECT_TRUE(server.respond_all(queries_bytes, responses_bytes));
+
+    EXPECT_TRUE(client.process_response_all(db_row_index, responses_bytes, db_row_bytes_span));
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+  }
+
+  // Queries for rows of many partitions prepared together, sharing a single pass over public matrix A. Rows of a partition, whose public
+  // matrix M is unknown, padding rows and repeated rows can't be enquired.
+  {
+    const std::vector<size_t> db_row_indices{
+      partition_entry_count + 7, 2 * partition_entry_count + 3, 5, partition_entry_count + 7, db_entry_count, db_entry_count - 2, partition_entry_count
+    };
+    const std::vector<bool> expected_query_prep_status{ true, true, false, false, false, true, true };
+
+    EXPECT_EQ(client.prepare_query(db_row_indices, csprng), expected_query_prep_status);
+
+    for (size_t q_idx = 0; q_idx < db_row_indices.size(); q_idx++) {
+      if (!expected_query_prep_status[q_idx]) {
+        continue;
+      }
+
+      const auto db_row_index = db_row_indices[q_idx];
+      const auto partition_idx = client_t::locate(db_row_index).first;
+
+      EXPECT_TRUE(client.query(db_row_index, query_bytes_span));
+      EXPECT_TRUE(server.respond(partition_idx, query_bytes_span, response_bytes_span));
+
+      EXPECT_TRUE(client.process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+      EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+    }
+  }
+
+  // Responses of all partitions match the ones produced one partition at a time.
+  csprng.generate(queries_bytes);
+  EXPECT_TRUE(server.respond_all(queries_bytes, responses_bytes));
+
+  for (size_t p_idx = 0; p_idx < server_t::NUM_PARTITIONS; p_idx++) {
+    std::ranges::copy(std::span(queries_bytes).subspan(p_idx * server_t::QUERY_BYTE_LEN, server_t::QUERY_BYTE_LEN), query_bytes.begin());
+    EXPECT_TRUE(server.respond(p_idx, query_bytes_span, response_bytes_span));
+    EXPECT_TRUE(std::ranges::equal(response_bytes, std::span(responses_bytes).subspan(p_idx * server_t::RESPONSE_BYTE_LEN, server_t::RESPONSE_BYTE_LEN)));
+  }
+}
+
+TEST(FrodoPIR, RuntimeParameterizedServerAndClient)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t mat_element_bitlen = 10;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  csprng::csprng_t csprng{};
+  csprng.generate(seed_μ);
+
+  // Parameters are validated at runtime.
+  EXPECT_FALSE((frodoPIR_runtime::params_t{ db_entry_count, 32, 9 }.is_valid()));
+  EXPECT_FALSE((frodoPIR_runtime::params_t{ db_entry_count + 1, 32, mat_element_bitlen }.is_valid()));
+  EXPECT_FALSE((frodoPIR_runtime::params_t{ db_entry_count, 0, mat_element_bitlen }.is_valid()));
+  EXPECT_FALSE(frodoPIR_runtime::server_t::setup({ db_entry_count, 32, 9 }, seed_μ, std::vector<uint8_t>(db_entry_count * 32)).has_value());
+  EXPECT_FALSE(frodoPIR_runtime::server_t::setup({ db_entry_count, 32, mat_element_bitlen }, seed_μ, std::vector<uint8_t>(32)).has_value());
+
+  // Same binary serves databases with entries of different byte lengths.
+  for (const size_t db_entry_byte_len : { size_t{ 32 }, size_t{ 47 } }) {
+    const frodoPIR_runtime::params_t params{ db_entry_count, db_entry_byte_len, mat_element_bitlen };
+    EXPECT_TRUE(params.is_valid());
+
+    std::vector<uint8_t> db_bytes(params.original_db_byte_len(), 0);
+    std::vector<uint8_t> query_bytes(params.query_byte_len(), 0);
+    std::vector<uint8_t> response_bytes(params.response_byte_len(), 0);
+    std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+    csprng.generate(db_bytes);
+
+    auto set_up = frodoPIR_runtime::server_t::setup(params, seed_μ, db_bytes);
+    EXPECT_TRUE(set_up.has_value());
+
+    auto& [server, pub_matM_bytes] = *set_up;
+    EXPECT_EQ(pub_matM_bytes.size(), params.public_matrix_M_byte_len());
+
+    EXPECT_FALSE(frodoPIR_runtime::client_t::setup(params, seed_μ, std::span(pub_matM_bytes).first(1)).has_value());
+
+    auto client = frodoPIR_runtime::client_t::setup(params, seed_μ, pub_matM_bytes);
+    EXPECT_TRUE(client.has_value());
+
+    EXPECT_FALSE(client->prepare_query(db_entry_count, csprng));
+    EXPECT_FALSE(server.respond(std::span(query_bytes).first(4), response_bytes));
+
+    const std::vector<size_t> db_row_indices{ 0, 12345, db_entry_count - 1 };
+    const auto query_prep_status = client->prepare_query(db_row_indices, csprng);
+    EXPECT_TRUE(std::ranges::all_of(query_prep_status, [](const bool status) { return status; }));
+
+    for (const auto db_row_index : db_row_indices) {
+      EXPECT_TRUE(client->query(db_row_index, query_bytes));
+      EXPECT_FALSE(client->query(db_row_index, query_bytes));
+      EXPECT_TRUE(server.respond(query_bytes, response_bytes));
+
+      EXPECT_TRUE(client->process_response(db_row_index, response_bytes, db_row_bytes));
+      EXPECT_TRUE(std::ranges::equal(db_row_bytes, std::span(db_bytes).subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+    }
+  }
+
+  // Runtime engine is interoperable with compile-time one, set up with same parameters.
+  {
+    constexpr size_t db_entry_byte_len = 32;
+    constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+    using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+    using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+    std::vector<uint8_t> db_bytes(db_byte_len, 0);
+    std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+    std::vector<uint8_t> query_bytes(server_t::QUERY_BYTE_LEN, 0);
+    std::vector<uint8_t> response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+    std::vector<uint8_t> runtime_response_bytes(server_t::RESPONSE_BYTE_LEN, 0);
+    std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+    auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+    auto query_bytes_span = std::span<uint8_t, server_t::QUERY_BYTE_LEN>(query_bytes);
+    auto response_bytes_span = std::span<uint8_t, server_t::RESPONSE_BYTE_LEN>(response_bytes);
+
+    csprng.generate(db_bytes);
+
+    auto [server, M] = server_t::setup(seed_μ, std::span<const uint8_t, db_byte_len>(db_bytes));
+    M.to_le_bytes(pub_matM_bytes_span);
+
+    const frodoPIR_runtime::params_t params{ db_entry_count, db_entry_byte_len, mat_element_bitlen };
+    auto runtime_set_up = frodoPIR_runtime::server_t::setup(params, seed_μ, db_bytes);
+    EXPECT_TRUE(runtime_set_up.has_value());
+
+    auto& [runtime_server, runtime_pub_matM_bytes] = *runtime_set_up;
+    EXPECT_EQ(runtime_pub_matM_bytes, pub_matM_bytes);
+
+    auto runtime_client = frodoPIR_runtime::client_t::setup(params, seed_μ, pub_matM_bytes);
+    EXPECT_TRUE(runtime_client.has_value());
+
+    const size_t db_row_index = 4242;
+    EXPECT_TRUE(runtime_client->prepare_query(db_row_index, csprng));
+    EXPECT_TRUE(runtime_client->query(db_row_index, query_bytes));
+
+    server.respond(query_bytes_span, response_bytes_span);
+    EXPECT_TRUE(runtime_server.respond(query_bytes, runtime_response_bytes));
+    EXPECT_EQ(response_bytes, runtime_response_bytes);
+
+    EXPECT_TRUE(runtime_client->process_response(db_row_index, response_bytes, db_row_bytes));
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes, std::span(db_bytes).subspan(db_row_index * db_entry_byte_len, db_entry_byte_len)));
+  }
+}
+
+TEST(FrodoPIR, ClientUnboundQueryPool)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(client_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, client_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+
+  M.to_le_bytes(pub_matM_bytes_span);
+  auto client = client_t::setup_lowmem(seed_μ, pub_matM_bytes_span);
+
+  auto retrieve = [&](client_t& client, const size_t db_row_index) {
+    if (!client.query(db_row_index, query_bytes_span)) {
+      return false;
+    }
+
+    server.respond(query_bytes_span, response_bytes_span);
+
+    return client.process_response(db_row_index, response_bytes_span, db_row_bytes_span) &&
+           std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len));
+  };
+
+  // Without any prepared query, finalizing a query fails.
+  EXPECT_FALSE(client.query(7, query_bytes_span));
+
+  // Unbound queries get claimed by whichever database row index is enquired first.
+  client.prepare_unbound_queries(2, csprng);
+  EXPECT_EQ(client.num_unbound_queries(), 2u);
+
+  EXPECT_TRUE(retrieve(client, 7));
+  EXPECT_TRUE(retrieve(client, db_entry_count - 1));
+  EXPECT_EQ(client.num_unbound_queries(), 0u);
+  EXPECT_FALSE(client.query(7, query_bytes_span));
+
+  // Query prepared for a specific database row index is preferred over the pool.
+  client.prepare_unbound_queries(1, csprng);
+  EXPECT_TRUE(client.prepare_query(11, csprng));
+  EXPECT_TRUE(retrieve(client, 11));
+  EXPECT_EQ(client.num_unbound_queries(), 1u);
+
+  auto wait_for_unbound_queries = [](const client_t& client, const size_t count) {
+    for (size_t attempt = 0; (attempt < 6000) && (client.num_unbound_queries() < count); attempt++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return client.num_unbound_queries();
+  };
+
+  // Background refill keeps the pool filled up to the watermark, also after the client handle is moved.
+  constexpr size_t watermark = 3;
+  client.start_background_refill(watermark);
+  EXPECT_EQ(wait_for_unbound_queries(client, watermark), watermark);
+
+  auto moved_client = std::move(client);
+
+  EXPECT_TRUE(retrieve(moved_client, 42));
+  EXPECT_TRUE(retrieve(moved_client, 43));
+  EXPECT_EQ(wait_for_unbound_queries(moved_client, watermark), watermark);
+
+  EXPECT_EQ(moved_client.stop_background_refill(), watermark);
+  EXPECT_EQ(moved_client.stop_background_refill(), 0u);
+
+  // Copy doesn't inherit unbound queries, as reusing them would reveal enquired rows to the server.
+  const auto copied_client = moved_client;
+  EXPECT_EQ(copied_client.num_unbound_queries(), 0u);
+  EXPECT_EQ(moved_client.num_unbound_queries(), watermark);
+}
+
+TEST(FrodoPIR, ClientQueryArena)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(client_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, client_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+
+  M.to_le_bytes(pub_matM_bytes_span);
+  auto client = client_t::setup_lowmem(seed_μ, pub_matM_bytes_span);
+
+  auto retrieve = [&](client_t& client, const size_t db_row_index) {
+    if (!client.query(db_row_index, query_bytes_span)) {
+      return false;
+    }
+
+    server.respond(query_bytes_span, response_bytes_span);
+
+    return client.process_response(db_row_index, response_bytes_span, db_row_bytes_span) &&
+           std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_index * db_entry_byte_len, db_entry_byte_len));
+  };
+
+  // Arena, spilling to disk, which can hold b vectors of only two prepared queries.
+  EXPECT_TRUE(client.set_query_arena(2, std::filesystem::temp_directory_path()));
+
+  const std::vector<size_t> db_row_indices{ 3, 5, 3, 8 };
+  EXPECT_EQ(client.prepare_query(db_row_indices, csprng), (std::vector<bool>{ true, true, false, false }));
+  EXPECT_EQ(client.num_prepared_queries(), 2u);
+  EXPECT_EQ(client.prepare_unbound_queries(1, csprng), 0u);
+
+  // Arena can't be replaced, while it holds prepared queries.
+  EXPECT_FALSE(client.set_query_arena(4));
+
+  // Sending a query frees up its slot, even before the response is processed.
+  EXPECT_TRUE(client.query(3, query_bytes_span));
+  EXPECT_EQ(client.num_prepared_queries(), 1u);
+  EXPECT_TRUE(client.prepare_query(8, csprng));
+
+  server.respond(query_bytes_span, response_bytes_span);
+  EXPECT_TRUE(client.process_response(3, response_bytes_span, db_row_bytes_span));
+  EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(3 * db_entry_byte_len, db_entry_byte_len)));
+
+  // Copy gets prepared queries, in an arena of its own.
+  auto copied_client = client;
+  EXPECT_EQ(copied_client.num_prepared_queries(), 2u);
+  EXPECT_TRUE(retrieve(copied_client, 5));
+  EXPECT_TRUE(retrieve(copied_client, 8));
+  EXPECT_EQ(copied_client.num_prepared_queries(), 0u);
+  EXPECT_EQ(client.num_prepared_queries(), 2u);
+
+  EXPECT_TRUE(retrieve(client, 5));
+  EXPECT_TRUE(retrieve(client, 8));
+  EXPECT_EQ(client.num_prepared_queries(), 0u);
+  EXPECT_TRUE(client.set_query_arena(4));
+}
+
+TEST(FrodoPIR, LowMemoryClient)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::array<uint8_t, csprng::csprng_t::seed_byte_len> csprng_seed{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> lowmem_query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(client_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(query_bytes);
+  auto lowmem_query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(lowmem_query_bytes);
+  auto response_bytes_span = std::span<uint8_t, client_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(csprng_seed);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  M.to_le_bytes(pub_matM_bytes_span);
+
+  auto client = client_t::setup(seed_μ, pub_matM_bytes_span);
+  // Row block length, which doesn't divide LWE dimension, exercises the last partially filled block.
+  auto lowmem_client = client_t::setup_lowmem(seed_μ, pub_matM_bytes_span, 100);
+
+  constexpr size_t db_row_index = 1ul << 10;
+
+  // When both clients use identically seeded CSPRNGs, they must produce exactly same query.
+  csprng::csprng_t client_csprng(csprng_seed);
+  csprng::csprng_t lowmem_client_csprng(csprng_seed);
+
+  EXPECT_TRUE(client.prepare_query(db_row_index, client_csprng));
+  EXPECT_TRUE(lowmem_client.prepare_query(db_row_index, lowmem_client_csprng));
+
+  EXPECT_TRUE(client.query(db_row_index, query_bytes_span));
+  EXPECT_TRUE(lowmem_client.query(db_row_index, lowmem_query_bytes_span));
+
+  EXPECT_EQ(query_bytes, lowmem_query_bytes);
+
+  server.respond(lowmem_query_bytes_span, response_bytes_span);
+  EXPECT_TRUE(lowmem_client.process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+
+  constexpr size_t db_row_begin_at = db_row_index * db_entry_byte_len;
+  EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_begin_at, db_entry_byte_len)));
+}
+
+template<bool is_lowmem>
+static void
+test_batched_query_preparation()
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::array<uint8_t, csprng::csprng_t::seed_byte_len> csprng_seed{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> batched_query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(client_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(query_bytes);
+  auto batched_query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(batched_query_bytes);
+  auto response_bytes_span = std::span<uint8_t, client_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(csprng_seed);
+  csprng.generate(db_bytes);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span);
+  M.to_le_bytes(pub_matM_bytes_span);
+
+  auto setup_client = [&]() { return is_lowmem ? client_t::setup_lowmem(seed_μ, pub_matM_bytes_span) : client_t::setup(seed_μ, pub_matM_bytes_span); };
+
+  auto client = setup_client();
+  auto batching_client = setup_client();
+
+  // Both a duplicate index and an index, for which query is already prepared, must be rejected by batched query preparation.
+  constexpr size_t already_prepared_db_row_index = 3;
+  const std::array<size_t, 6> db_row_indices{ 17, already_prepared_db_row_index, 1ul << 15, 17, 5, db_entry_count - 1 };
+  const std::array<size_t, 4> preparable_db_row_indices{ 17, 1ul << 15, 5, db_entry_count - 1 };
+
+  EXPECT_TRUE(batching_client.prepare_query(already_prepared_db_row_index, csprng));
+
+  // When both clients use identically seeded CSPRNGs, they must produce exactly same queries.
+  csprng::csprng_t client_csprng(csprng_seed);
+  csprng::csprng_t batching_client_csprng(csprng_seed);
+
+  for (const auto db_row_index : preparable_db_row_indices) {
+    EXPECT_TRUE(client.prepare_query(db_row_index, client_csprng));
+  }
+
+  const auto query_prep_status = batching_client.prepare_query(db_row_indices, batching_client_csprng);
+  EXPECT_EQ(query_prep_status, std::vector<bool>({ true, false, true, false, true, true }));
+
+  for (const auto db_row_index : preparable_db_row_indices) {
+    EXPECT_TRUE(client.query(db_row_index, query_bytes_span));
+    EXPECT_TRUE(batching_client.query(db_row_index, batched_query_bytes_span));
+
+    EXPECT_EQ(query_bytes, batched_query_bytes);
+
+    server.respond(batched_query_bytes_span, response_bytes_span);
+    EXPECT_TRUE(batching_client.process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+
+    const size_t db_row_begin_at = db_row_index * db_entry_byte_len;
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_begin_at, db_entry_byte_len)));
+  }
+}
+
+TEST(FrodoPIR, BatchedQueryPreparation)
+{
+  test_batched_query_preparation<false>();
+  test_batched_query_preparation<true>();
+}
+
+TEST(FrodoPIR, RowIndexedPublicMatrixExpansion)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t db_entry_count = 1ul << 16;
+  constexpr size_t db_entry_byte_len = 32;
+  constexpr size_t mat_element_bitlen = 10;
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+  constexpr auto mode = frodoPIR_matrix::expansion_mode_t::row_indexed_v1;
+
+  using server_t = frodoPIR_server::server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+  using client_t = frodoPIR_client::client_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> seed_μ{};
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  std::vector<uint8_t> pub_matM_bytes(client_t::PUBLIC_MATRIX_M_BYTE_LEN, 0);
+  std::vector<uint8_t> query_bytes(client_t::QUERY_BYTE_LEN, 0);
+  std::vector<uint8_t> response_bytes(client_t::RESPONSE_BYTE_LEN, 0);
+  std::vector<uint8_t> db_row_bytes(db_entry_byte_len, 0);
+
+  auto db_bytes_span = std::span<const uint8_t, db_byte_len>(db_bytes);
+  auto pub_matM_bytes_span = std::span<uint8_t, client_t::PUBLIC_MATRIX_M_BYTE_LEN>(pub_matM_bytes);
+  auto query_bytes_span = std::span<uint8_t, client_t::QUERY_BYTE_LEN>(query_bytes);
+  auto response_bytes_span = std::span<uint8_t, client_t::RESPONSE_BYTE_LEN>(response_bytes);
+  auto db_row_bytes_span = std::span<uint8_t, db_entry_byte_len>(db_row_bytes);
+
+  csprng::csprng_t csprng{};
+
+  csprng.generate(seed_μ);
+  csprng.generate(db_bytes);
+
+  frodoPIR_thread_pool::thread_pool_t pool(4);
+
+  auto [server, M] = server_t::setup(seed_μ, db_bytes_span, pool, mode);
+  // Row block length, which doesn't divide LWE dimension, exercises the last partially filled block.
+  const auto [streamed_server, streamed_M] = server_t::setup_streaming<100>(seed_μ, db_bytes_span, pool, mode);
+  const auto [sequential_server, sequential_M] = server_t::setup(seed_μ, db_bytes_span);
+
+  EXPECT_EQ(server.get_expansion_mode(), mode);
+  EXPECT_EQ(M, streamed_M);
+  EXPECT_NE(M, sequential_M);
+
+  // Partial public matrices M of shards add up to M, when they expand A in same mode.
+  {
+    using shard_server_t = frodoPIR_shard::shard_server_t<db_entry_count, db_entry_byte_len, mat_element_bitlen>;
+
+    constexpr size_t split_at = db_entry_count / 3;
+    const auto db_bytes_all = std::span<const uint8_t>(db_bytes);
+
+    const auto lo_shard = shard_server_t::setup(seed_μ, 0, db_bytes_all.first(split_at * db_entry_byte_len), pool, mode);
+    const auto hi_shard = shard_server_t::setup(seed_μ, split_at, db_bytes_all.subspan(split_at * db_entry_byte_len), pool, mode);
+
+    EXPECT_TRUE(lo_shard.has_value() && hi_shard.has_value());
+    EXPECT_EQ(lo_shard->first.get_expansion_mode(), mode);
+    EXPECT_EQ(lo_shard->second + hi_shard->second, M);
+  }
+
+  M.to_le_bytes(pub_matM_bytes_span);
+
+  auto client = client_t::setup(seed_μ, pub_matM_bytes_span, pool, mode);
+  auto lowmem_client = client_t::setup_lowmem(seed_μ, pub_matM_bytes_span, 100, mode);
+  lowmem_client.set_thread_pool(pool);
+
+  for (auto* const cur_client : { &client, &lowmem_client }) {
+    constexpr size_t db_row_index = 1ul << 10;
+
+    EXPECT_TRUE(cur_client->prepare_query(db_row_index, csprng));
+    EXPECT_TRUE(cur_client->query(db_row_index, query_bytes_span));
+
+    server.respond(query_bytes_span, response_bytes_span);
+    EXPECT_TRUE(cur_client->process_response(db_row_index, response_bytes_span, db_row_bytes_span));
+
+    constexpr size_t db_row_begin_at = db_row_index * db_entry_byte_len;
+    EXPECT_TRUE(std::ranges::equal(db_row_bytes_span, db_bytes_span.subspan(db_row_begin_at, db_entry_byte_len)));
+  }
+
+  // Updating rows expands needed columns of A in same mode.
+  {
+    const std::array<size_t, 2> db_row_indices{ 7, db_entry_count - 1 };
+    std::vector<uint8_t> new_db_rows_bytes(db_row_indices.size() * db_entry_byte_len);
+    csprng.generate(new_db_rows_bytes);
+
+    const auto M_delta = server.update_rows(db_row_indices, new_db_rows_bytes);
+    EXPECT_TRUE(M_delta.has_value());
+
+    for (size_t u_idx = 0; u_idx < db_row_indices.size(); u_idx++) {
+      std::ranges::copy(std::span(new_db_rows_bytes).subspan(u_idx * db_entry_byte_len, db_entry_byte_len),
+                        db_bytes.begin() + static_cast<ptrdiff_t>(db_row_indices[u_idx] * db_entry_byte_len));
+    }
+
+    const auto [updated_server, updated_M] = server_t::setup(seed_μ, db_bytes_span, pool, mode);
+    M_delta->apply_to(M);
+    EXPECT_EQ(M, updated_M);
+  }
+
+  // Expansion mode is kept in server state file.
+  const auto path = std::filesystem::temp_directory_path() / ("frodoPIR-test-" + std::to_string(::getpid()) + ".row-indexed.db");
+  EXPECT_TRUE(server.save(path, M));
+
+  {
+    const auto opened = server_t::open_mmap(path);
+    EXPECT_TRUE(opened.has_value());
+    EXPECT_EQ(opened->first.get_expansion_mode(), mode);
+    EXPECT_EQ(opened->second, M);
+  }
+
+  // Unknown expansion mode is rejected, even when checksum isn't verified.
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(12);
+
+    const char unknown_mode = static_cast<char>(static_cast<uint32_t>(mode) + 1);
+    file.write(&unknown_mode, 1);
+  }
+
+  EXPECT_FALSE(server_t::open_mmap(path, { .verify_checksum = false }).has_value());
+  std::filesystem::remove(path);
+}
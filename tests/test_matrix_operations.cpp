@@ -1,9 +1,15 @@
 #include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/matrix/simd.hpp"
 #include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/allocator.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <limits>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 TEST(FrodoPIR, MatrixMultiplicationWorks)
@@ -29,6 +35,141 @@ TEST(FrodoPIR, MatrixMultiplicationWorks)
   EXPECT_EQ(A, IA);
 }
 
+// Memory resource, counting allocations made from it, while forwarding them to the default one.
+struct counting_resource_t final : public std::pmr::memory_resource
+{
+  size_t num_allocations = 0;
+  size_t num_deallocations = 0;
+
+  void* do_allocate(const size_t byte_len, const size_t alignment) override
+  {
+    num_allocations++;
+    return std::pmr::new_delete_resource()->allocate(byte_len, alignment);
+  }
+  void do_deallocate(void* const ptr, const size_t byte_len, const size_t alignment) override
+  {
+    num_deallocations++;
+    std::pmr::new_delete_resource()->deallocate(ptr, byte_len, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(FrodoPIR, MatrixStorageAllocatorIsPluggable)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 1024;
+  constexpr size_t cols = rows + 1; // ~4MB, so that it is backed by huge pages, when allocated from a huge page resource.
+
+  using matrix_t = frodoPIR_matrix::matrix_t<rows, cols>;
+  using row_vector_t = frodoPIR_vector::row_vector_t<rows>;
+
+  const auto is_aligned = [](const auto* ptr, const size_t alignment) { return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0; };
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  const auto A = matrix_t::template generate<λ>(μ_span);
+  const auto v = row_vector_t::template generate<λ>(μ_span);
+  const auto vA = v * A;
+
+  EXPECT_TRUE(is_aligned(A.row(0).data(), frodoPIR_allocator::MATRIX_ALIGNMENT));
+  EXPECT_TRUE(is_aligned(v.row(0).data(), frodoPIR_allocator::MATRIX_ALIGNMENT));
+
+  for (auto* resource : std::array<std::pmr::memory_resource*, 2>{ &frodoPIR_allocator::huge_page_resource_t::huge_2mib(),
+                                                                    &frodoPIR_allocator::huge_page_resource_t::huge_1gib() }) {
+    auto* const prev_resource = frodoPIR_allocator::set_matrix_resource(resource);
+    EXPECT_EQ(prev_resource, frodoPIR_allocator::default_matrix_resource());
+
+    const auto A_huge = matrix_t::template generate<λ>(μ_span);
+    const auto v_huge = row_vector_t::template generate<λ>(μ_span);
+
+    // Large matrices begin at a huge page boundary, small ones still at a cache line boundary.
+#if defined(__linux__)
+    EXPECT_TRUE(is_aligned(A_huge.row(0).data(), frodoPIR_allocator::HUGE_PAGE_2MIB));
+#endif
+    EXPECT_TRUE(is_aligned(v_huge.row(0).data(), frodoPIR_allocator::MATRIX_ALIGNMENT));
+
+    frodoPIR_allocator::set_matrix_resource(prev_resource);
+
+    EXPECT_EQ(A, A_huge);
+    EXPECT_EQ(vA, v_huge * A_huge);
+
+    // Copy outlives change of resource and is released by the resource, it was allocated from.
+    auto A_copy = A_huge;
+    EXPECT_EQ(A_copy, A);
+
+    A_copy = A;
+    EXPECT_EQ(A_copy, A);
+  }
+
+  counting_resource_t counting_resource;
+  {
+    auto* const prev_resource = frodoPIR_allocator::set_matrix_resource(&counting_resource);
+
+    const auto A_counted = matrix_t::template generate<λ>(μ_span);
+    const auto A_counted_copy = A_counted;
+
+    frodoPIR_allocator::set_matrix_resource(prev_resource);
+
+    EXPECT_EQ(A_counted_copy, A);
+    EXPECT_EQ(counting_resource.num_allocations, 2u);
+  }
+  EXPECT_EQ(counting_resource.num_deallocations, 2u);
+}
+
+TEST(FrodoPIR, RowIndexedMatrixExpansion)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 97;
+  constexpr size_t cols = 1025;
+
+  using matrix_t = frodoPIR_matrix::matrix_t<rows, cols>;
+  using row_stream_t = frodoPIR_matrix::matrix_row_stream_t<cols, λ>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  frodoPIR_thread_pool::thread_pool_t single_thread_pool(1);
+  frodoPIR_thread_pool::thread_pool_t multi_thread_pool(4);
+
+  const auto A_seq = matrix_t::template generate<λ>(μ_span);
+  const auto A = matrix_t::template generate<λ>(μ_span, frodoPIR_matrix::expansion_mode_t::row_indexed_v1, single_thread_pool);
+  const auto A_parallel = matrix_t::template generate<λ>(μ_span, frodoPIR_matrix::expansion_mode_t::row_indexed_v1, multi_thread_pool);
+
+  // Expansion doesn't depend on number of threads, but on expansion mode.
+  EXPECT_EQ(A, A_parallel);
+  EXPECT_NE(A, A_seq);
+
+  // Any row can be expanded on its own.
+  std::vector<frodoPIR_matrix::zq_t> row(cols);
+  for (const size_t r_idx : { size_t{ 0 }, size_t{ 1 }, rows / 2, rows - 1 }) {
+    row_stream_t::expand_row(μ_span, r_idx, std::span<frodoPIR_matrix::zq_t, cols>(row));
+    EXPECT_TRUE(std::ranges::equal(row, A.row(r_idx)));
+  }
+
+  // Mixing single row and block expansion, with blocks not dividing number of rows, walks same rows.
+  std::vector<frodoPIR_matrix::zq_t> rows_block(rows * cols);
+  row_stream_t row_stream(μ_span, frodoPIR_matrix::expansion_mode_t::row_indexed_v1);
+
+  row_stream.next(std::span<frodoPIR_matrix::zq_t, cols>(rows_block.data(), cols));
+  for (size_t r_idx = 1; r_idx < rows; r_idx += 10) {
+    row_stream.next_rows(rows_block.data() + r_idx * cols, std::min<size_t>(10, rows - r_idx), multi_thread_pool);
+  }
+
+  for (size_t r_idx = 0; r_idx < rows; r_idx++) {
+    EXPECT_TRUE(std::ranges::equal(std::span(rows_block).subspan(r_idx * cols, cols), A.row(r_idx)));
+  }
+
+  EXPECT_TRUE(frodoPIR_matrix::is_valid_expansion_mode(static_cast<uint32_t>(frodoPIR_matrix::expansion_mode_t::row_indexed_v1)));
+  EXPECT_FALSE(frodoPIR_matrix::is_valid_expansion_mode(static_cast<uint32_t>(frodoPIR_matrix::expansion_mode_t::row_indexed_v1) + 1));
+}
+
 TEST(FrodoPIR, MatrixSerializationWorks)
 {
   constexpr size_t λ = 128;
@@ -88,4 +229,533 @@ TEST(FrodoPIR, MatrixTranspositionWorks)
   auto A_transposed_transposed = A_transposed.transpose();
 
   EXPECT_EQ(A, A_transposed_transposed);
+
+  // Multiplying with a matrix, given in transposed form, must be same as multiplying with the matrix itself.
+  auto B = frodoPIR_matrix::matrix_t<cols, 96>::template generate<λ>(μ_span);
+  EXPECT_EQ(A * B, A.multiply_by_transposed(B.transpose()));
+}
+
+TEST(FrodoPIR, NarrowMatrixTranspositionWorks)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 1031;
+  constexpr size_t cols = 23;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  const auto A = frodoPIR_matrix::matrix_t<rows, cols>::template generate<λ>(μ_span);
+  frodoPIR_matrix::matrix_t<rows, cols, uint16_t> A_narrow{};
+
+  for (size_t idx = 0; idx < rows * cols; idx++) {
+    A_narrow[idx] = static_cast<uint16_t>(A[idx]);
+  }
+
+  // Neither dimension is a multiple of micro-tile dimension, while multiple row blocks are transposed in parallel.
+  frodoPIR_thread_pool::thread_pool_t pool(4);
+  const auto A_narrow_transposed = A_narrow.transpose(pool);
+
+  for (size_t r_idx = 0; r_idx < rows; r_idx++) {
+    for (size_t c_idx = 0; c_idx < cols; c_idx++) {
+      EXPECT_EQ((A_narrow_transposed[{ c_idx, r_idx }]), (A_narrow[{ r_idx, c_idx }]));
+    }
+  }
+
+  EXPECT_EQ(A_narrow_transposed.transpose(pool), A_narrow);
+}
+
+TEST(FrodoPIR, BatchedRowVectorMatrixMultiplicationWorks)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 67;
+  constexpr size_t cols = 4099;
+  constexpr size_t batch_size = 3;
+
+  using row_vector_t = frodoPIR_vector::row_vector_t<cols>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  auto B = frodoPIR_matrix::matrix_t<rows, cols>::template generate<λ>(μ_span);
+
+  std::vector<row_vector_t> row_vectors;
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    csprng.generate(μ_span);
+    row_vectors.push_back(row_vector_t::template generate<λ>(μ_span));
+  }
+
+  std::vector<frodoPIR_vector::row_vector_t<rows>> products(batch_size);
+  row_vector_t::row_vectors_x_transposed_matrix(std::span<const row_vector_t>(row_vectors), B, std::span(products));
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    EXPECT_EQ(products[b_idx], row_vectors[b_idx].row_vector_x_transposed_matrix(B));
+  }
+}
+
+TEST(FrodoPIR, RowVectorNarrowMatrixMultiplicationWorks)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 67;
+  constexpr size_t cols = 4099;
+  constexpr frodoPIR_matrix::zq_t narrow_mask = (1u << 10) - 1u;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  auto B = frodoPIR_matrix::matrix_t<rows, cols>::template generate<λ>(μ_span);
+  frodoPIR_matrix::matrix_t<rows, cols, uint16_t> B_narrow{};
+
+  for (size_t idx = 0; idx < rows * cols; idx++) {
+    B[idx] &= narrow_mask;
+    B_narrow[idx] = static_cast<uint16_t>(B[idx]);
+  }
+
+  csprng.generate(μ_span);
+  auto row_vector = frodoPIR_vector::row_vector_t<cols>::template generate<λ>(μ_span);
+
+  // Multiplying with a matrix, having narrow elements, must widen them before multiply-accumulate.
+  EXPECT_EQ(row_vector.row_vector_x_transposed_matrix(B), row_vector.row_vector_x_transposed_matrix(B_narrow));
+}
+
+TEST(FrodoPIR, TernaryRowVectorMatrixMultiplicationWorks)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 1774;
+  constexpr size_t cols = 1031;
+  constexpr size_t batch_size = 3;
+
+  using row_vector_t = frodoPIR_vector::row_vector_t<rows>;
+  using product_t = frodoPIR_vector::row_vector_t<cols>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  auto B = frodoPIR_matrix::matrix_t<rows, cols>::template generate<λ>(μ_span);
+
+  std::vector<row_vector_t> ternary_row_vectors;
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    ternary_row_vectors.push_back(row_vector_t::sample_from_uniform_ternary_distribution(csprng));
+  }
+
+  std::vector<product_t> products(batch_size);
+  std::vector<product_t> ternary_products(batch_size);
+
+  row_vector_t::row_vectors_x_matrix(std::span<const row_vector_t>(ternary_row_vectors), B, std::span(products));
+  row_vector_t::ternary_row_vectors_x_matrix(std::span<const row_vector_t>(ternary_row_vectors), B, std::span(ternary_products));
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    // Ternary specialized vector-matrix multiplication must agree with generic ones.
+    EXPECT_EQ(products[b_idx], ternary_row_vectors[b_idx] * B);
+    EXPECT_EQ(ternary_products[b_idx], ternary_row_vectors[b_idx] * B);
+  }
+}
+
+// Given an element type of matrix B, this routine checks that vector kernels for all instruction set extensions, supported by this CPU, compute
+// same dot products as the scalar one, for rows and row lengths which aren't multiple of vector width or row block length.
+template<typename rhs_elem_t>
+static void
+test_row_dot_product_kernels()
+{
+  constexpr size_t λ = 128;
+  constexpr size_t num_rows = 23;
+  constexpr size_t rhs_stride = 1031;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  const auto lhs = frodoPIR_vector::row_vector_t<rhs_stride>::template generate<λ>(μ_span);
+  const auto rhs_wide = frodoPIR_matrix::matrix_t<num_rows, rhs_stride>::template generate<λ>(μ_span);
+
+  std::vector<rhs_elem_t> rhs(num_rows * rhs_stride);
+  for (size_t idx = 0; idx < rhs.size(); idx++) {
+    rhs[idx] = static_cast<rhs_elem_t>(rhs_wide[idx]);
+  }
+
+  const auto scalar_kernel = frodoPIR_simd::get_row_dot_products_kernel<rhs_elem_t>(frodoPIR_simd::isa_t::scalar);
+
+  for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+    if (!frodoPIR_simd::is_supported(isa)) {
+      continue;
+    }
+
+    const auto kernel = frodoPIR_simd::get_row_dot_products_kernel<rhs_elem_t>(isa);
+
+    for (const size_t len : { 0ul, 1ul, 15ul, 32ul, 33ul, 1000ul, rhs_stride }) {
+      for (const size_t rows_in_call : { 1ul, 3ul, 4ul, num_rows }) {
+        // Kernels accumulate into result vector, so let's start from same non-zero values.
+        std::vector<frodoPIR_matrix::zq_t> expected(rows_in_call, 7);
+        std::vector<frodoPIR_matrix::zq_t> computed(rows_in_call, 7);
+
+        scalar_kernel(lhs.row(0).data(), rhs.data(), rhs_stride, rows_in_call, len, expected.data());
+        kernel(lhs.row(0).data(), rhs.data(), rhs_stride, rows_in_call, len, computed.data());
+
+        EXPECT_EQ(expected, computed) << "isa = " << frodoPIR_simd::isa_name(isa) << ", len = " << len << ", rows = " << rows_in_call;
+      }
+    }
+  }
+}
+
+TEST(FrodoPIR, RowDotProductKernelsMatchScalarKernel)
+{
+  test_row_dot_product_kernels<uint16_t>();
+  test_row_dot_product_kernels<uint32_t>();
+}
+
+// Given an element type of matrix B, this routine checks that ternary accumulation kernels for all instruction set extensions, supported by
+// this CPU, add (or subtract) a row of B to (or from) same result rows as the scalar one, for row lengths and column offsets which aren't
+// multiple of vector width, with result rows getting repeated among the ones to be added to and the ones to be subtracted from.
+template<typename rhs_elem_t>
+static void
+test_ternary_accumulate_row_kernels()
+{
+  constexpr size_t λ = 128;
+  constexpr size_t num_res_rows = 5;
+  constexpr size_t row_len = 1031;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  const auto rhs_wide = frodoPIR_vector::row_vector_t<row_len>::template generate<λ>(μ_span);
+  const auto res_init = frodoPIR_matrix::matrix_t<num_res_rows, row_len>::template generate<λ>(μ_span);
+
+  std::vector<rhs_elem_t> rhs(row_len);
+  for (size_t idx = 0; idx < rhs.size(); idx++) {
+    rhs[idx] = static_cast<rhs_elem_t>(rhs_wide[idx]);
+  }
+
+  const std::array<uint32_t, 4> pos_indices{ 0, 3, 3, 4 };
+  const std::array<uint32_t, 3> neg_indices{ 1, 4, 2 };
+
+  // Result rows start from same non-zero values, while kernels accumulate into them.
+  const auto run_kernel = [&](const frodoPIR_simd::ternary_accumulate_row_fn_t<rhs_elem_t> kernel,
+                              const size_t len,
+                              const size_t res_offset,
+                              const size_t num_pos,
+                              const size_t num_neg) {
+    auto res = res_init;
+
+    std::array<frodoPIR_matrix::zq_t*, num_res_rows> res_rows{};
+    for (size_t r_idx = 0; r_idx < num_res_rows; r_idx++) {
+      res_rows[r_idx] = res.row(r_idx).data();
+    }
+
+    kernel(rhs.data() + res_offset, len, res_rows.data(), res_offset, pos_indices.data(), num_pos, neg_indices.data(), num_neg);
+    return res;
+  };
+
+  const auto scalar_kernel = frodoPIR_simd::get_ternary_accumulate_row_kernel<rhs_elem_t>(frodoPIR_simd::isa_t::scalar);
+
+  for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+    if (!frodoPIR_simd::is_supported(isa)) {
+      continue;
+    }
+
+    const auto kernel = frodoPIR_simd::get_ternary_accumulate_row_kernel<rhs_elem_t>(isa);
+
+    for (const size_t len : { 0ul, 1ul, 15ul, 32ul, 33ul, 512ul, 1000ul }) {
+      for (const size_t res_offset : { 0ul, 7ul, row_len - len }) {
+        for (const auto& [num_pos, num_neg] : { std::pair{ 0ul, 0ul }, std::pair{ 1ul, 0ul }, std::pair{ 0ul, 3ul }, std::pair{ 4ul, 3ul } }) {
+          EXPECT_EQ(run_kernel(scalar_kernel, len, res_offset, num_pos, num_neg), run_kernel(kernel, len, res_offset, num_pos, num_neg))
+            << "isa = " << frodoPIR_simd::isa_name(isa) << ", len = " << len << ", offset = " << res_offset;
+        }
+      }
+    }
+  }
+}
+
+TEST(FrodoPIR, TernaryAccumulateRowKernelsMatchScalarKernel)
+{
+  test_ternary_accumulate_row_kernels<uint16_t>();
+  test_ternary_accumulate_row_kernels<uint32_t>();
+}
+
+// Given an element type of matrix B, this routine checks that blocked matrix multiplication, using GEMM micro-kernels for all instruction set
+// extensions, supported by this CPU, computes same product as the naive one, for dimensions which aren't multiple of any blocking factor.
+// Same is checked, when B is given in transposed form.
+template<typename rhs_elem_t>
+static void
+test_gemm_kernels()
+{
+  constexpr size_t m = 37;
+  constexpr size_t k = frodoPIR_matrix::GEMM_KC + 45;
+  constexpr size_t n = frodoPIR_matrix::GEMM_NC + 77;
+
+  // Strides, which are larger than row lengths, so that matrices are sub-blocks of larger ones.
+  constexpr size_t lhs_stride = k + 3;
+  constexpr size_t rhs_stride = n + 5;
+  constexpr size_t res_stride = n + 7;
+
+  csprng::csprng_t csprng;
+
+  std::vector<frodoPIR_matrix::zq_t> lhs(m * lhs_stride);
+  std::vector<rhs_elem_t> rhs(k * rhs_stride);
+  std::vector<frodoPIR_matrix::zq_t> res_init(m * res_stride);
+
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(lhs.data()), lhs.size() * sizeof(frodoPIR_matrix::zq_t)));
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(rhs.data()), rhs.size() * sizeof(rhs_elem_t)));
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(res_init.data()), res_init.size() * sizeof(frodoPIR_matrix::zq_t)));
+
+  // Blocked multiplication accumulates into C, so let's start from same non-zero values, expecting padding of each row to stay untouched.
+  auto expected = res_init;
+  for (size_t r_idx = 0; r_idx < m; r_idx++) {
+    for (size_t kk = 0; kk < k; kk++) {
+      for (size_t c_idx = 0; c_idx < n; c_idx++) {
+        expected[r_idx * res_stride + c_idx] += lhs[r_idx * lhs_stride + kk] * static_cast<frodoPIR_matrix::zq_t>(rhs[kk * rhs_stride + c_idx]);
+      }
+    }
+  }
+
+  frodoPIR_thread_pool::thread_pool_t pool(3);
+
+  for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+    if (!frodoPIR_simd::is_supported(isa)) {
+      continue;
+    }
+
+    const auto kernel = frodoPIR_simd::get_gemm_kernel(isa);
+
+    auto computed = res_init;
+    frodoPIR_matrix::matrix_x_matrix(lhs.data(), lhs_stride, rhs.data(), rhs_stride, m, k, n, computed.data(), res_stride, pool, kernel);
+
+    EXPECT_EQ(expected, computed) << "isa = " << frodoPIR_simd::isa_name(isa);
+  }
+
+  constexpr size_t rhs_transposed_stride = k + 9;
+
+  std::vector<rhs_elem_t> rhs_transposed(n * rhs_transposed_stride);
+  for (size_t kk = 0; kk < k; kk++) {
+    for (size_t c_idx = 0; c_idx < n; c_idx++) {
+      rhs_transposed[c_idx * rhs_transposed_stride + kk] = rhs[kk * rhs_stride + c_idx];
+    }
+  }
+
+  for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+    if (!frodoPIR_simd::is_supported(isa)) {
+      continue;
+    }
+
+    const auto kernel = frodoPIR_simd::get_gemm_kernel(isa);
+
+    auto computed = res_init;
+    frodoPIR_matrix::matrix_x_matrix<true>(
+      lhs.data(), lhs_stride, rhs_transposed.data(), rhs_transposed_stride, m, k, n, computed.data(), res_stride, pool, kernel);
+
+    EXPECT_EQ(expected, computed) << "isa = " << frodoPIR_simd::isa_name(isa) << ", transposed B";
+  }
+}
+
+TEST(FrodoPIR, GemmKernelsMatchNaiveMultiplication)
+{
+  test_gemm_kernels<uint16_t>();
+  test_gemm_kernels<uint32_t>();
+}
+
+// Given bit length of elements of parsed database matrix, this routine checks that response decoding kernels, for all instruction set
+// extensions, supported by this CPU, round each element same as dividing it by the rounding factor and rounding the remainder does, including
+// at and around ties.
+template<typename res_elem_t, size_t mat_element_bitlen>
+static void
+test_decode_response_kernels()
+{
+  constexpr auto rho = 1ul << mat_element_bitlen;
+  constexpr auto rounding_factor = static_cast<frodoPIR_matrix::zq_t>(frodoPIR_matrix::Q / rho);
+  constexpr auto rounding_floor = rounding_factor / 2;
+
+  constexpr auto rounding_shift = static_cast<uint32_t>(std::numeric_limits<frodoPIR_matrix::zq_t>::digits - mat_element_bitlen);
+  constexpr auto rounding_offset = rounding_floor - 1;
+
+  csprng::csprng_t csprng;
+
+  for (const size_t len : { 1ul, 15ul, 16ul, 17ul, 820ul, 911ul }) {
+    std::vector<frodoPIR_matrix::zq_t> c_tilda(len);
+    std::vector<frodoPIR_matrix::zq_t> c(len);
+
+    csprng.generate(std::span(reinterpret_cast<uint8_t*>(c_tilda.data()), c_tilda.size() * sizeof(frodoPIR_matrix::zq_t)));
+    csprng.generate(std::span(reinterpret_cast<uint8_t*>(c.data()), c.size() * sizeof(frodoPIR_matrix::zq_t)));
+
+    // Remainders right below, at and right above half of the rounding factor, for every third element.
+    for (size_t idx = 0; idx < len; idx += 3) {
+      const auto remainder = rounding_floor - 1 + static_cast<frodoPIR_matrix::zq_t>((idx / 3) % 3);
+      c_tilda[idx] = c[idx] + (c_tilda[idx] & ~(rounding_factor - 1)) + remainder;
+    }
+
+    std::vector<uint8_t> c_tilda_bytes(len * sizeof(frodoPIR_matrix::zq_t));
+    for (size_t idx = 0; idx < len; idx++) {
+      frodoPIR_utils::to_le_bytes(c_tilda[idx], std::span(c_tilda_bytes).subspan(idx * sizeof(frodoPIR_matrix::zq_t), sizeof(frodoPIR_matrix::zq_t)));
+    }
+
+    std::vector<res_elem_t> expected(len);
+    for (size_t idx = 0; idx < len; idx++) {
+      const auto unscaled_res = c_tilda[idx] - c[idx];
+
+      auto rounded_res = unscaled_res / rounding_factor;
+      rounded_res += (((unscaled_res % rounding_factor) > rounding_floor) ? 1 : 0);
+      rounded_res %= static_cast<frodoPIR_matrix::zq_t>(rho);
+
+      expected[idx] = static_cast<res_elem_t>(rounded_res);
+    }
+
+    for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+      if (!frodoPIR_simd::is_supported(isa)) {
+        continue;
+      }
+
+      std::vector<res_elem_t> computed(len);
+      frodoPIR_simd::get_decode_response_kernel<res_elem_t>(isa)(c_tilda_bytes.data(), c.data(), len, rounding_offset, rounding_shift, computed.data());
+
+      EXPECT_EQ(expected, computed) << "isa = " << frodoPIR_simd::isa_name(isa) << ", len = " << len;
+    }
+  }
+}
+
+TEST(FrodoPIR, DecodeResponseKernelsMatchDivisionBasedRounding)
+{
+  test_decode_response_kernels<uint16_t, 9>();
+  test_decode_response_kernels<uint16_t, 10>();
+  test_decode_response_kernels<uint16_t, 16>();
+  test_decode_response_kernels<uint32_t, 10>();
+  test_decode_response_kernels<uint32_t, 20>();
+}
+
+// Ternary sampling kernels, for all instruction set extensions, supported by this CPU, must sample same values as the scalar kernel does,
+// including when some values are rejected and when sampling stops early, because requested number of values are sampled.
+TEST(FrodoPIR, TernarySamplingKernelsMatchScalarKernel)
+{
+  constexpr auto interval_size = static_cast<frodoPIR_matrix::zq_t>(frodoPIR_matrix::TERNARY_INTERVAL_SIZE);
+  constexpr std::array<frodoPIR_matrix::zq_t, 10> boundary_vals = {
+    0,
+    interval_size,
+    interval_size + 1,
+    2 * interval_size,
+    2 * interval_size + 1,
+    3 * interval_size,
+    3 * interval_size + 1,
+    3 * interval_size + 2,
+    std::numeric_limits<frodoPIR_matrix::zq_t>::max(),
+    1,
+  };
+
+  csprng::csprng_t csprng;
+
+  for (const size_t num_vals : { 0ul, 1ul, 7ul, 16ul, 33ul, 272ul }) {
+    std::vector<frodoPIR_matrix::zq_t> vals(num_vals);
+    csprng.generate(std::span(reinterpret_cast<uint8_t*>(vals.data()), vals.size() * sizeof(frodoPIR_matrix::zq_t)));
+
+    // Values at and around interval boundaries, a few of which are to be rejected, for every fifth value.
+    for (size_t idx = 0; idx < num_vals; idx += 5) {
+      vals[idx] = boundary_vals[(idx / 5) % boundary_vals.size()];
+    }
+
+    std::vector<uint8_t> bytes(num_vals * sizeof(frodoPIR_matrix::zq_t));
+    for (size_t idx = 0; idx < num_vals; idx++) {
+      frodoPIR_utils::to_le_bytes(vals[idx], std::span(bytes).subspan(idx * sizeof(frodoPIR_matrix::zq_t), sizeof(frodoPIR_matrix::zq_t)));
+    }
+
+    for (const size_t max_num_res : { num_vals, num_vals / 2, num_vals + 3 }) {
+      std::vector<frodoPIR_matrix::zq_t> expected(max_num_res);
+      const size_t expected_num_res =
+        frodoPIR_simd::get_sample_ternary_kernel(frodoPIR_simd::isa_t::scalar)(bytes.data(), num_vals, interval_size, expected.data(), max_num_res);
+
+      for (const auto isa : frodoPIR_simd::ALL_ISAS) {
+        if (!frodoPIR_simd::is_supported(isa)) {
+          continue;
+        }
+
+        std::vector<frodoPIR_matrix::zq_t> computed(max_num_res);
+        const size_t computed_num_res =
+          frodoPIR_simd::get_sample_ternary_kernel(isa)(bytes.data(), num_vals, interval_size, computed.data(), max_num_res);
+
+        EXPECT_EQ(expected_num_res, computed_num_res) << "isa = " << frodoPIR_simd::isa_name(isa) << ", num_vals = " << num_vals;
+        EXPECT_EQ(expected, computed) << "isa = " << frodoPIR_simd::isa_name(isa) << ", num_vals = " << num_vals;
+      }
+    }
+  }
+}
+
+// Rejection samples a vector from uniform ternary distribution, one value at a time, as it used to be done, before bulk sampling.
+template<size_t num_elements>
+static std::vector<frodoPIR_matrix::zq_t>
+sample_ternary_one_value_at_a_time(csprng::csprng_t& csprng)
+{
+  constexpr size_t buffer_byte_len = turboshake256::RATE;
+
+  std::vector<frodoPIR_matrix::zq_t> sampled(num_elements);
+
+  std::array<uint8_t, buffer_byte_len> buffer{};
+  size_t buffer_offset = 0;
+
+  for (size_t e_idx = 0; e_idx < num_elements; e_idx++) {
+    frodoPIR_matrix::zq_t val = std::numeric_limits<frodoPIR_matrix::zq_t>::max();
+
+    while (val > frodoPIR_matrix::TERNARY_REJECTION_SAMPLING_MAX) {
+      if ((buffer_offset + sizeof(frodoPIR_matrix::zq_t)) > buffer.size()) {
+        csprng.generate(buffer);
+        buffer_offset = 0;
+      }
+
+      val = frodoPIR_utils::from_le_bytes<frodoPIR_matrix::zq_t>(std::span(buffer).subspan(buffer_offset, sizeof(frodoPIR_matrix::zq_t)));
+      buffer_offset += sizeof(frodoPIR_matrix::zq_t);
+    }
+
+    if ((val > frodoPIR_matrix::TERNARY_INTERVAL_SIZE) && (val <= (2 * frodoPIR_matrix::TERNARY_INTERVAL_SIZE))) {
+      sampled[e_idx] = 1;
+    } else if (val > (2 * frodoPIR_matrix::TERNARY_INTERVAL_SIZE)) {
+      sampled[e_idx] = std::numeric_limits<frodoPIR_matrix::zq_t>::max();
+    }
+  }
+
+  return sampled;
+}
+
+// Bulk sampling must produce same vector as sampling one value at a time, from same CSPRNG state, leaving CSPRNG in same state.
+template<size_t num_elements>
+static void
+test_bulk_ternary_sampling()
+{
+  std::array<uint8_t, csprng::csprng_t::seed_byte_len> seed{};
+  csprng::csprng_t seed_csprng;
+  seed_csprng.generate(seed);
+
+  csprng::csprng_t bulk_csprng(seed);
+  csprng::csprng_t one_at_a_time_csprng(seed);
+
+  for (size_t v_idx = 0; v_idx < 2; v_idx++) {
+    const auto sampled = frodoPIR_vector::row_vector_t<num_elements>::sample_from_uniform_ternary_distribution(bulk_csprng);
+    const auto expected = sample_ternary_one_value_at_a_time<num_elements>(one_at_a_time_csprng);
+
+    EXPECT_TRUE(std::ranges::equal(sampled.row(0), expected));
+  }
+
+  std::array<uint8_t, 32> bulk_csprng_output{};
+  std::array<uint8_t, 32> one_at_a_time_csprng_output{};
+
+  bulk_csprng.generate(bulk_csprng_output);
+  one_at_a_time_csprng.generate(one_at_a_time_csprng_output);
+
+  EXPECT_EQ(bulk_csprng_output, one_at_a_time_csprng_output);
+}
+
+TEST(FrodoPIR, BulkTernarySamplingMatchesOneValueAtATime)
+{
+  test_bulk_ternary_sampling<1>();
+  test_bulk_ternary_sampling<1774>();
+  test_bulk_ternary_sampling<1ul << 16>();
 }
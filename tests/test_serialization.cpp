@@ -29,3 +29,100 @@ TEST(FrodoPIR, ParsingDatabaseAndSerializingDatabaseMatrix)
   test_db_parsing_and_serialization<1ul << 16u, 1024, 10>();
   test_db_parsing_and_serialization<1ul << 20u, 1024, 9>();
 }
+
+template<size_t db_entry_count, size_t db_entry_byte_len, size_t mat_element_bitlen>
+static void
+test_db_parsing_into_transposed_matrix()
+{
+  csprng::csprng_t csprng;
+
+  constexpr size_t db_byte_len = db_entry_count * db_entry_byte_len;
+
+  std::vector<uint8_t> db_bytes(db_byte_len, 0);
+  auto db_bytes_span = std::span<uint8_t, db_byte_len>(db_bytes);
+
+  csprng.generate(db_bytes_span);
+
+  // Parsing in transposed form must be same as parsing and then transposing, no matter how many threads are working on it.
+  frodoPIR_thread_pool::thread_pool_t pool(3);
+
+  const auto D = frodoPIR_serialization::parse_db_bytes<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes_span);
+  const auto D_transposed = frodoPIR_serialization::parse_db_bytes_transposed<db_entry_count, db_entry_byte_len, mat_element_bitlen>(db_bytes_span, pool);
+
+  EXPECT_EQ(D.transpose(pool), D_transposed);
+  EXPECT_EQ(D_transposed.transpose(), D);
+}
+
+TEST(FrodoPIR, ParsingDatabaseIntoTransposedMatrix)
+{
+  test_db_parsing_into_transposed_matrix<1027, 33, 10>();
+  test_db_parsing_into_transposed_matrix<1ul << 16u, 1024, 10>();
+  test_db_parsing_into_transposed_matrix<1ul << 16u, 32, 9>();
+}
+
+// Unpacking kernels of each implementation, supported by this CPU, must extract same elements as reading them bit-by-bit does, while
+// packing kernels must write back original bytes, ignoring any bit of an element, above its low `mat_element_bitlen` bits.
+template<size_t mat_element_bitlen>
+static void
+test_bit_packing_kernels()
+{
+  using namespace frodoPIR_bit_packing;
+
+  csprng::csprng_t csprng;
+
+  for (const size_t num_groups : { 1ul, 2ul, 3ul, 7ul, 64ul, 129ul }) {
+    const size_t byte_len = num_groups * mat_element_bitlen;
+    const size_t num_elems = num_groups * GROUP_LEN;
+
+    std::vector<uint8_t> bytes(byte_len, 0);
+    csprng.generate(bytes);
+
+    std::vector<uint16_t> expected_elems(num_elems, 0);
+    for (size_t bit_idx = 0; bit_idx < byte_len * std::numeric_limits<uint8_t>::digits; bit_idx++) {
+      const auto bit = static_cast<uint16_t>((bytes[bit_idx / 8] >> (bit_idx % 8)) & 1u);
+      expected_elems[bit_idx / mat_element_bitlen] |= static_cast<uint16_t>(bit << (bit_idx % mat_element_bitlen));
+    }
+
+    for (const auto impl : ALL_IMPLS) {
+      if (!is_supported(impl)) {
+        continue;
+      }
+
+      std::vector<uint16_t> elems(num_elems, 0);
+      get_unpack_groups_kernel<mat_element_bitlen>(impl)(bytes.data(), num_groups, elems.data());
+      EXPECT_EQ(elems, expected_elems) << impl_name(impl);
+
+      std::vector<uint16_t> dirty_u16_elems(num_elems, 0);
+      std::vector<uint32_t> dirty_u32_elems(num_elems, 0);
+      for (size_t i = 0; i < num_elems; i++) {
+        dirty_u16_elems[i] = static_cast<uint16_t>(expected_elems[i] | (0xffffu << mat_element_bitlen));
+        dirty_u32_elems[i] = expected_elems[i] | (0xdeadbeefu << mat_element_bitlen);
+      }
+
+      std::vector<uint8_t> u16_packed_bytes(byte_len, 0);
+      get_pack_groups_kernel<mat_element_bitlen, uint16_t>(impl)(dirty_u16_elems.data(), num_groups, u16_packed_bytes.data());
+      EXPECT_EQ(u16_packed_bytes, bytes) << impl_name(impl);
+
+      std::vector<uint8_t> u32_packed_bytes(byte_len, 0);
+      get_pack_groups_kernel<mat_element_bitlen, uint32_t>(impl)(dirty_u32_elems.data(), num_groups, u32_packed_bytes.data());
+      EXPECT_EQ(u32_packed_bytes, bytes) << impl_name(impl);
+    }
+  }
+}
+
+TEST(FrodoPIR, BitPackingKernelsMatchBitByBitParsing)
+{
+  test_bit_packing_kernels<9>();
+  test_bit_packing_kernels<10>();
+  test_bit_packing_kernels<11>();
+  test_bit_packing_kernels<12>();
+  test_bit_packing_kernels<13>();
+  test_bit_packing_kernels<14>();
+  test_bit_packing_kernels<15>();
+
+  // Database entries, which are not a whole number of groups, leave a partial group to be parsed and serialized bit-by-bit.
+  test_db_parsing_and_serialization<1ul << 10u, 37, 9>();
+  test_db_parsing_and_serialization<1ul << 10u, 31, 10>();
+  test_db_parsing_and_serialization<1ul << 10u, 29, 13>();
+  test_db_parsing_and_serialization<1ul << 10u, 3, 11>();
+}
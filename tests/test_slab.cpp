@@ -0,0 +1,135 @@
+#include "frodoPIR/internals/utility/slab.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <optional>
+#include <set>
+#include <span>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Given a slab allocator, this routine allocates slots until its budget is exhausted, checking that slots are distinct and don't overlap,
+// by filling each of them with its own identifier. Returns allocated slot identifiers.
+static std::vector<size_t>
+test_slab_allocator_hands_out_disjoint_slots(frodoPIR_slab::slab_allocator_t& allocator, const size_t slot_byte_len)
+{
+  std::vector<size_t> slot_ids;
+
+  while (true) {
+    const auto slot_id = allocator.allocate();
+    if (!slot_id.has_value()) {
+      break;
+    }
+
+    auto slot = allocator.slot(*slot_id);
+    EXPECT_EQ(slot.size(), slot_byte_len);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(slot.data()) % frodoPIR_slab::slab_allocator_t::SLOT_ALIGNMENT, 0u);
+
+    std::ranges::fill(slot, static_cast<uint8_t>(*slot_id));
+    slot_ids.push_back(*slot_id);
+  }
+
+  EXPECT_EQ(slot_ids.size(), allocator.max_num_allocatable_slots());
+  EXPECT_EQ(allocator.num_allocated_slots(), allocator.max_num_allocatable_slots());
+  EXPECT_EQ(std::set<size_t>(slot_ids.begin(), slot_ids.end()).size(), slot_ids.size());
+
+  for (const auto slot_id : slot_ids) {
+    EXPECT_TRUE(std::ranges::all_of(allocator.slot(slot_id), [&](const uint8_t byte) { return byte == static_cast<uint8_t>(slot_id); }));
+  }
+
+  return slot_ids;
+}
+
+TEST(FrodoPIR, SlabAllocatorStaysWithinBudget)
+{
+  constexpr size_t slot_byte_len = 1000;
+  constexpr size_t slots_per_slab = 3;
+  constexpr size_t max_num_slots = 10;
+
+  for (const auto& spill_directory : { std::optional<std::filesystem::path>{}, std::optional(std::filesystem::temp_directory_path()) }) {
+    auto allocator = frodoPIR_slab::slab_allocator_t::create(slot_byte_len, slots_per_slab, max_num_slots, spill_directory);
+    EXPECT_NE(allocator, nullptr);
+    EXPECT_EQ(allocator->is_file_backed(), spill_directory.has_value());
+
+    const auto slot_ids = test_slab_allocator_hands_out_disjoint_slots(*allocator, slot_byte_len);
+
+    // Released slot is handed out again, while others keep their content.
+    allocator->release(slot_ids[4]);
+    EXPECT_EQ(allocator->num_allocated_slots(), max_num_slots - 1);
+    EXPECT_EQ(allocator->allocate(), slot_ids[4]);
+    EXPECT_FALSE(allocator->allocate().has_value());
+
+    allocator->clear();
+    EXPECT_EQ(allocator->num_allocated_slots(), 0u);
+    test_slab_allocator_hands_out_disjoint_slots(*allocator, slot_byte_len);
+
+    // Slab allocator, with same configuration, starts empty.
+    auto empty_allocator = allocator->create_empty_like();
+    EXPECT_EQ(empty_allocator->num_allocated_slots(), 0u);
+    EXPECT_EQ(empty_allocator->is_file_backed(), allocator->is_file_backed());
+    test_slab_allocator_hands_out_disjoint_slots(*empty_allocator, slot_byte_len);
+  }
+}
+
+#if defined(__linux__)
+// Given a slot, this routine returns number of whole OS pages, lying in it, which are resident in memory.
+static size_t
+count_resident_pages_of_slot(std::span<const uint8_t> slot)
+{
+  const auto page_byte_len = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const auto pages_begin = ((reinterpret_cast<uintptr_t>(slot.data()) + (page_byte_len - 1)) / page_byte_len) * page_byte_len;
+  const auto pages_end = ((reinterpret_cast<uintptr_t>(slot.data()) + slot.size()) / page_byte_len) * page_byte_len;
+
+  std::vector<unsigned char> residency((pages_end - pages_begin) / page_byte_len);
+  EXPECT_EQ(::mincore(reinterpret_cast<void*>(pages_begin), pages_end - pages_begin, residency.data()), 0);
+
+  return static_cast<size_t>(std::ranges::count_if(residency, [](const unsigned char page) { return (page & 1) != 0; }));
+}
+
+TEST(FrodoPIR, SlabAllocatorHandsReleasedSlotsBackToOS)
+{
+  constexpr size_t slot_byte_len = 64 * 4096 + 100;
+  constexpr size_t slots_per_slab = 4;
+
+  for (const auto& spill_directory : { std::optional<std::filesystem::path>{}, std::optional(std::filesystem::temp_directory_path()) }) {
+    auto allocator = frodoPIR_slab::slab_allocator_t::create(slot_byte_len, slots_per_slab, slots_per_slab, spill_directory);
+    EXPECT_NE(allocator, nullptr);
+
+    const auto slot_ids = test_slab_allocator_hands_out_disjoint_slots(*allocator, slot_byte_len);
+    for (const auto slot_id : slot_ids) {
+      EXPECT_GT(count_resident_pages_of_slot(allocator->slot(slot_id)), 0u);
+    }
+
+    // Released slot doesn't stay resident, while neighbouring slots keep their content.
+    allocator->release(slot_ids[1]);
+    EXPECT_EQ(count_resident_pages_of_slot(allocator->slot(slot_ids[1])), 0u);
+
+    for (const auto slot_id : { slot_ids[0], slot_ids[2] }) {
+      EXPECT_TRUE(std::ranges::all_of(allocator->slot(slot_id), [&](const uint8_t byte) { return byte == static_cast<uint8_t>(slot_id); }));
+    }
+
+    // Reallocated slot is usable again.
+    EXPECT_EQ(allocator->allocate(), slot_ids[1]);
+    std::ranges::fill(allocator->slot(slot_ids[1]), uint8_t{ 0xff });
+    EXPECT_TRUE(std::ranges::all_of(allocator->slot(slot_ids[1]), [](const uint8_t byte) { return byte == 0xff; }));
+
+    // Clearing allocator doesn't keep any slot resident.
+    allocator->clear();
+    for (const auto slot_id : slot_ids) {
+      EXPECT_EQ(count_resident_pages_of_slot(allocator->slot(slot_id)), 0u);
+    }
+  }
+}
+#endif
+
+TEST(FrodoPIR, SlabAllocatorRejectsBadConfiguration)
+{
+  EXPECT_EQ(frodoPIR_slab::slab_allocator_t::create(0, 1), nullptr);
+  EXPECT_EQ(frodoPIR_slab::slab_allocator_t::create(1, 0), nullptr);
+  EXPECT_EQ(frodoPIR_slab::slab_allocator_t::create(1, 1, 1, std::filesystem::path("/nonexistent/frodoPIR/spill/directory")), nullptr);
+}
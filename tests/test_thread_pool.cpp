@@ -0,0 +1,214 @@
+#include "frodoPIR/internals/matrix/matrix.hpp"
+#include "frodoPIR/internals/matrix/vector.hpp"
+#include "frodoPIR/internals/utility/thread_pool.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Given a thread pool, number of work items and grain size, this routine checks that each work item gets processed exactly once.
+static void
+test_parallel_for_covers_each_item_once(frodoPIR_thread_pool::thread_pool_t& pool, const size_t num_items, const size_t grain)
+{
+  std::vector<std::atomic<uint32_t>> visit_counts(num_items);
+
+  pool.parallel_for(
+    num_items,
+    [&](const size_t begin, const size_t end) {
+      EXPECT_LT(begin, end);
+      EXPECT_LE(end, num_items);
+
+      for (size_t idx = begin; idx < end; idx++) {
+        visit_counts[idx].fetch_add(1, std::memory_order_relaxed);
+      }
+    },
+    grain);
+
+  for (size_t idx = 0; idx < num_items; idx++) {
+    EXPECT_EQ(visit_counts[idx].load(), 1u);
+  }
+}
+
+TEST(FrodoPIR, ThreadPoolParallelForCoversEachItemOnce)
+{
+  frodoPIR_thread_pool::thread_pool_t pool(4);
+  EXPECT_EQ(pool.size(), 4u);
+
+  for (const size_t num_items : { 0ul, 1ul, 3ul, 4ul, 17ul, 1024ul, 100'003ul }) {
+    for (const size_t grain : { 0ul, 1ul, 7ul, 512ul }) {
+      test_parallel_for_covers_each_item_once(pool, num_items, grain);
+    }
+  }
+}
+
+TEST(FrodoPIR, SingleThreadedThreadPoolRunsOnCallingThread)
+{
+  frodoPIR_thread_pool::thread_pool_t pool(1);
+  EXPECT_EQ(pool.size(), 1u);
+
+  const auto caller_id = std::this_thread::get_id();
+  size_t num_items_processed = 0;
+
+  pool.parallel_for(1024, [&](const size_t begin, const size_t end) {
+    EXPECT_EQ(std::this_thread::get_id(), caller_id);
+    num_items_processed += end - begin;
+  });
+
+  EXPECT_EQ(num_items_processed, 1024u);
+}
+
+TEST(FrodoPIR, NestedThreadPoolParallelForRunsSequentially)
+{
+  constexpr size_t num_outer_items = 64;
+  constexpr size_t num_inner_items = 256;
+
+  frodoPIR_thread_pool::thread_pool_t pool(4);
+  std::vector<std::atomic<uint32_t>> visit_counts(num_outer_items * num_inner_items);
+
+  pool.parallel_for(
+    num_outer_items,
+    [&](const size_t outer_begin, const size_t outer_end) {
+      for (size_t outer_idx = outer_begin; outer_idx < outer_end; outer_idx++) {
+        const auto thread_id = std::this_thread::get_id();
+
+        pool.parallel_for(num_inner_items, [&](const size_t inner_begin, const size_t inner_end) {
+          EXPECT_EQ(std::this_thread::get_id(), thread_id);
+
+          for (size_t inner_idx = inner_begin; inner_idx < inner_end; inner_idx++) {
+            visit_counts[outer_idx * num_inner_items + inner_idx].fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+      }
+    },
+    1);
+
+  for (const auto& visit_count : visit_counts) {
+    EXPECT_EQ(visit_count.load(), 1u);
+  }
+}
+
+TEST(FrodoPIR, ThreadPoolSharedByConcurrentCallers)
+{
+  constexpr size_t num_callers = 4;
+  constexpr size_t num_jobs_per_caller = 64;
+  constexpr size_t num_items = 4096;
+
+  frodoPIR_thread_pool::thread_pool_t pool(3);
+
+  std::array<uint64_t, num_callers> sums{};
+  std::vector<std::thread> callers;
+
+  for (size_t t_idx = 0; t_idx < num_callers; t_idx++) {
+    callers.emplace_back([&, t_idx]() {
+      for (size_t j_idx = 0; j_idx < num_jobs_per_caller; j_idx++) {
+        std::atomic<uint64_t> sum{ 0 };
+
+        pool.parallel_for(num_items, [&](const size_t begin, const size_t end) {
+          uint64_t partial_sum = 0;
+          for (size_t idx = begin; idx < end; idx++) {
+            partial_sum += idx;
+          }
+
+          sum.fetch_add(partial_sum, std::memory_order_relaxed);
+        });
+
+        sums[t_idx] += sum.load();
+      }
+    });
+  }
+
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  constexpr uint64_t expected_sum = num_jobs_per_caller * ((num_items * (num_items - 1)) / 2);
+  for (const auto sum : sums) {
+    EXPECT_EQ(sum, expected_sum);
+  }
+}
+
+TEST(FrodoPIR, ThreadPoolRethrowsExceptionOfJob)
+{
+  constexpr size_t num_items = 64;
+
+  frodoPIR_thread_pool::thread_pool_t pool(4);
+  const auto caller_id = std::this_thread::get_id();
+
+  // Each chunk takes a while, so that workers also get to process some of them.
+  const auto run_job = [&](const std::optional<bool> throw_on_caller) {
+    std::mutex thread_ids_lock;
+    std::set<std::thread::id> thread_ids;
+
+    pool.parallel_for(
+      num_items,
+      [&](const size_t, const size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        {
+          std::scoped_lock lock(thread_ids_lock);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+
+        if (throw_on_caller.has_value() && ((std::this_thread::get_id() == caller_id) == *throw_on_caller)) {
+          throw std::runtime_error("chunk failed");
+        }
+      },
+      1);
+
+    return thread_ids.size();
+  };
+
+  for (const bool throw_on_caller : { true, false }) {
+    EXPECT_THROW(run_job(throw_on_caller), std::runtime_error);
+
+    // Pool keeps working, in parallel, after a job has thrown, be it on the calling thread or on a worker.
+    EXPECT_GT(run_job(std::nullopt), 1u);
+    test_parallel_for_covers_each_item_once(pool, 1024, 7);
+  }
+}
+
+TEST(FrodoPIR, MatrixOperationsOnDedicatedThreadPool)
+{
+  constexpr size_t λ = 128;
+  constexpr size_t rows = 1774;
+  constexpr size_t cols = 1u << 10;
+  constexpr size_t batch_size = 5;
+
+  using vector_t = frodoPIR_vector::row_vector_t<cols>;
+  using result_t = frodoPIR_vector::row_vector_t<rows>;
+
+  std::array<uint8_t, λ / std::numeric_limits<uint8_t>::digits> μ{};
+  auto μ_span = std::span(μ);
+
+  csprng::csprng_t csprng;
+  csprng.generate(μ_span);
+
+  const auto B = frodoPIR_matrix::matrix_t<rows, cols>::template generate<λ>(μ_span);
+
+  std::vector<vector_t> lhs;
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    lhs.push_back(vector_t::template generate<λ>(μ_span));
+    μ[b_idx]++;
+  }
+
+  frodoPIR_thread_pool::thread_pool_t single_threaded_pool(1);
+  frodoPIR_thread_pool::thread_pool_t multi_threaded_pool(4);
+
+  std::vector<result_t> res_single(batch_size);
+  std::vector<result_t> res_multi(batch_size);
+
+  vector_t::row_vectors_x_transposed_matrix(std::span<const vector_t>(lhs), B, std::span(res_single), single_threaded_pool);
+  vector_t::row_vectors_x_transposed_matrix(std::span<const vector_t>(lhs), B, std::span(res_multi), multi_threaded_pool);
+
+  for (size_t b_idx = 0; b_idx < batch_size; b_idx++) {
+    EXPECT_EQ(res_single[b_idx], res_multi[b_idx]);
+    EXPECT_EQ(res_multi[b_idx], lhs[b_idx].row_vector_x_transposed_matrix(B, multi_threaded_pool));
+  }
+}